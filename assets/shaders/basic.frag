@@ -4,20 +4,50 @@ in vec3 FragPos;
 in vec3 Normal;
 in vec3 VertexColor;
 
-uniform vec3 uLightDir;
-uniform vec3 uLightColor;
-uniform vec3 uViewPos;
+// 每帧共享数据（UniformBuffers::updateFrame 上传，绑定点 0）
+layout (std140) uniform FrameBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    float uTime;
+};
+
+// 场景光照（绑定点 1）
+layout (std140) uniform LightingBlock {
+    vec3 uLightDir;
+    float uAmbientStrength;
+    vec3 uLightColor;
+    float uFogDensity;
+    vec3 uSkyColor;
+    bool uUseFog;
+    vec3 uGroundColor;
+    vec3 uFogColor;
+};
+
 uniform vec3 uObjectColor;
 uniform bool uUseVertexColor;
-uniform vec3 uSkyColor;
-uniform vec3 uGroundColor;
-uniform float uAmbientStrength;
-uniform bool uUseFog;
-uniform vec3 uFogColor;
-uniform float uFogDensity;
 uniform vec3 uBottomTintColor;
 uniform float uBottomTintStrength;
 
+// 编译期变体（Shader::getVariant 注入 VARIANT_* 宏）：未定义时由 uniform 在运行时决定
+#ifdef VARIANT_VERTEX_COLOR
+#define USE_VERTEX_COLOR (VARIANT_VERTEX_COLOR != 0)
+#else
+#define USE_VERTEX_COLOR uUseVertexColor
+#endif
+
+#ifdef VARIANT_BOTTOM_TINT
+#define USE_BOTTOM_TINT (VARIANT_BOTTOM_TINT != 0 && uBottomTintStrength > 0.0)
+#else
+#define USE_BOTTOM_TINT (uBottomTintStrength > 0.0)
+#endif
+
+#ifdef VARIANT_FOG
+#define USE_FOG (VARIANT_FOG != 0)
+#else
+#define USE_FOG uUseFog
+#endif
+
 out vec4 FragColor;
 
 void main()
@@ -40,19 +70,19 @@ void main()
     float spec = pow(max(dot(norm, halfDir), 0.0), 32.0);
     vec3 specular = specularStrength * spec * uLightColor;
     
-    vec3 baseColor = uUseVertexColor ? VertexColor : uObjectColor;
+    vec3 baseColor = USE_VERTEX_COLOR ? VertexColor : uObjectColor;
     // 最终颜色
     vec3 result = (ambient + diffuse + specular) * baseColor;
 
     // 底部区域色调（用于船底与水面色差融合）
-    if (uBottomTintStrength > 0.0) {
+    if (USE_BOTTOM_TINT) {
         float bottomMask = smoothstep(-0.05, -0.8, norm.y);
         vec3 bottomTarget = mix(result, uBottomTintColor, 0.6);
         result = mix(result, bottomTarget, bottomMask * uBottomTintStrength);
     }
 
     // 轻雾效
-    if (uUseFog) {
+    if (USE_FOG) {
         float dist = length(uViewPos - FragPos);
         float fogFactor = exp(-uFogDensity * dist);
         fogFactor = clamp(fogFactor, 0.0, 1.0);
@@ -3,13 +3,38 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec3 aColor;
+layout (location = 3) in vec3 aInstanceOffset;  // 实例化绘制时的逐实例平移（河岸砖墙）
+layout (location = 4) in mat4 aInstanceModel;   // 实例化绘制时的逐实例模型矩阵（location 4-7）
+layout (location = 8) in mat3 aInstanceNormal;  // 逐实例法线矩阵（location 8-10）
+layout (location = 11) in vec3 aInstanceColor;  // 逐实例颜色
+
+// 每帧共享数据（UniformBuffers::updateFrame 上传，绑定点 0）
+layout (std140) uniform FrameBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    float uTime;
+};
 
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
 uniform bool uUseObjectScale;
 uniform float uObjectScale;
 uniform vec3 uObjectScaleOrigin;
+uniform bool uUseInstanceOffset;
+uniform bool uUseInstancing;
+
+// 编译期变体（Shader::getVariant 注入 VARIANT_* 宏）：未定义时由 uniform 在运行时决定
+#ifdef VARIANT_INSTANCING
+#define USE_INSTANCING (VARIANT_INSTANCING != 0)
+#else
+#define USE_INSTANCING uUseInstancing
+#endif
+
+#ifdef VARIANT_OBJECT_SCALE
+#define USE_OBJECT_SCALE (VARIANT_OBJECT_SCALE != 0)
+#else
+#define USE_OBJECT_SCALE uUseObjectScale
+#endif
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -17,9 +42,21 @@ out vec3 VertexColor;
 
 void main()
 {
+    if (USE_INSTANCING) {
+        // 物体部件（不可见的物体已在 CPU 端由空间索引剔除）：矩阵、法线矩阵和颜色都来自实例属性
+        FragPos = vec3(aInstanceModel * vec4(aPos, 1.0));
+        Normal = aInstanceNormal * aNormal;
+        VertexColor = aInstanceColor;
+        gl_Position = uProjection * uView * vec4(FragPos, 1.0);
+        return;
+    }
+    
     // 计算世界空间中的片段位置
     vec3 worldPos = vec3(uModel * vec4(aPos, 1.0));
-    if (uUseObjectScale) {
+    if (uUseInstanceOffset) {
+        worldPos += aInstanceOffset;
+    }
+    if (USE_OBJECT_SCALE) {
         worldPos = (worldPos - uObjectScaleOrigin) * uObjectScale + uObjectScaleOrigin;
     }
     FragPos = worldPos;
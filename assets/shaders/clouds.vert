@@ -4,9 +4,15 @@ layout (location = 1) in vec2 aUV;
 
 out vec2 vUV;
 
+// 每帧共享数据（UniformBuffers::updateFrame 上传，绑定点 0）
+layout (std140) uniform FrameBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    float uTime;
+};
+
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
 
 void main() {
     vUV = aUV;
@@ -3,11 +3,17 @@ layout (location = 0) in vec3 aPos;
 
 out vec3 vDir;
 
-uniform mat4 uView;
-uniform mat4 uProjection;
+// 每帧共享数据（UniformBuffers::updateFrame 上传，绑定点 0）
+layout (std140) uniform FrameBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    float uTime;
+};
 
 void main() {
     vDir = aPos;
-    vec4 pos = uProjection * uView * vec4(aPos, 1.0);
+    mat4 rotationOnly = mat4(mat3(uView));  // 去掉平移，天空盒始终围绕相机
+    vec4 pos = uProjection * rotationOnly * vec4(aPos, 1.0);
     gl_Position = pos.xyww; // push to far plane
 }
@@ -5,10 +5,16 @@ in vec3 Normal;
 in vec2 UV;
 in float Height;
 
-uniform vec3 uViewPos;
+// 每帧共享数据（UniformBuffers::updateFrame 上传，绑定点 0）
+layout (std140) uniform FrameBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    float uTime;
+};
+
 uniform vec3 uWaterColor;
 uniform vec3 uLightDir;
-uniform float uTime;
 
 uniform int uUseBoatCutout;
 uniform vec3 uBoatPos;
@@ -27,6 +33,76 @@ uniform vec3 uWakePos[20];
 uniform float uWakeAmplitude[20];
 uniform float uBoatSpeed;  // 船速，用于动态调整wake影响范围
 
+// 编译期变体（Shader::getVariant 注入）：
+//   VARIANT_BOAT_CUTOUT 0=无裁剪 1=圆形 2=矩形(OBB)；未定义时由 uUseBoatCutout/uBoatCutoutShape 决定
+//   VARIANT_WAKE        0=不计算尾流；未定义或为 1 时由 uBoatSpeed/uWakeCount 决定
+//   VARIANT_OCEAN_FFT   1=法线逐片元采样 FFT 海面的坡度图（与 water.vert 一致）
+//   VARIANT_TERRAIN_MASK 1=按地形类型纹理丢弃非 WATER 格子上的片元，并在岸边叠加泡沫
+#ifdef VARIANT_BOAT_CUTOUT
+#define USE_BOAT_CUTOUT (VARIANT_BOAT_CUTOUT != 0)
+#define USE_OBB_CUTOUT (VARIANT_BOAT_CUTOUT == 2)
+#else
+#define USE_BOAT_CUTOUT (uUseBoatCutout == 1)
+#define USE_OBB_CUTOUT (uBoatCutoutShape == 1)
+#endif
+
+#ifdef VARIANT_WAKE
+#define USE_WAKE (VARIANT_WAKE != 0 && uBoatSpeed > 4.0)
+#else
+#define USE_WAKE (uBoatSpeed > 4.0)
+#endif
+
+#ifndef VARIANT_OCEAN_FFT
+#define VARIANT_OCEAN_FFT 0
+#endif
+
+#if VARIANT_OCEAN_FFT
+uniform sampler2D uOceanSlope;
+in vec2 OceanUV;
+#endif
+
+#ifndef VARIANT_TERRAIN_MASK
+#define VARIANT_TERRAIN_MASK 0
+#endif
+
+#if VARIANT_TERRAIN_MASK
+uniform usampler2D uTerrainMask;  // 每个格子一个 texel，值为 TerrainType
+uniform vec2 uTerrainOrigin;      // 格子 (0, 0) 左下角的世界坐标 (x, z)
+uniform float uTerrainCellSize;
+uniform vec2 uTerrainSize;        // 地形格子数（纹理按区块补齐，可能更大）
+in vec2 MaskPos;
+
+const uint TERRAIN_WATER = 2u;    // 与 TerrainType::WATER 一致
+const float SHORE_FOAM_WIDTH = 0.8;  // 岸边泡沫宽度（格子数，不超过 1，只需看相邻格子）
+
+// 地图外视为岸
+bool isWaterTexel(ivec2 cell) {
+    if (any(lessThan(cell, ivec2(0))) || any(greaterThanEqual(vec2(cell), uTerrainSize))) {
+        return false;
+    }
+    return texelFetch(uTerrainMask, cell, 0).r == TERRAIN_WATER;
+}
+
+// 到最近的非 WATER 格子的距离（格子数），只检查 3x3 邻域，超过一格时返回 1
+float shoreDistance(vec2 cellPos) {
+    ivec2 cell = ivec2(floor(cellPos));
+    vec2 f = cellPos - vec2(cell);
+    float nearest = 1.0;
+    for (int dz = -1; dz <= 1; ++dz) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if ((dx == 0 && dz == 0) || isWaterTexel(cell + ivec2(dx, dz))) {
+                continue;
+            }
+            // 到相邻格子的距离：各轴上是到公共边的距离，同一行 / 列时为 0
+            vec2 gap = vec2(dx < 0 ? f.x : (dx > 0 ? 1.0 - f.x : 0.0),
+                            dz < 0 ? f.y : (dz > 0 ? 1.0 - f.y : 0.0));
+            nearest = min(nearest, length(gap));
+        }
+    }
+    return nearest;
+}
+#endif
+
 out vec4 FragColor;
 
 const vec3 deepWaterColor = vec3(0.0, 0.1, 0.3);
@@ -39,12 +115,19 @@ float fresnelSchlick(float cosTheta, float F0) {
 }
 
 void main() {
+#if VARIANT_TERRAIN_MASK
+    vec2 cellPos = (MaskPos - uTerrainOrigin) / uTerrainCellSize;
+    if (!isWaterTexel(ivec2(floor(cellPos)))) {
+        discard;
+    }
+#endif
+
     // 应用船尾波浪粒子效果（范围随船速变化，使用四次方）
     vec3 wakeAdjustedPos = FragPos;
     float speedFactor = clamp(uBoatSpeed / 15.0, 0.0, 1.0);
     speedFactor = speedFactor * speedFactor * speedFactor * speedFactor;  // 四次方
     
-    if (uBoatSpeed > 4.0) {  // 超过4 m/s显示wake效果
+    if (USE_WAKE) {  // 超过4 m/s显示wake效果
         // 从0.01开始映射
         float scaledFactor = 0.01 + speedFactor * 0.99;  // 0.01 -> 1.0
         float wakeRange = scaledFactor * 10.0;  // 最小0.1m，最大10m
@@ -60,8 +143,8 @@ void main() {
     
     // 船只附近水面裁剪：避免水出现在船板/船舱视线里
     float cutoutMask = 1.0;
-    if (uUseBoatCutout == 1) {
-        if (uBoatCutoutShape == 1) {
+    if (USE_BOAT_CUTOUT) {
+        if (USE_OBB_CUTOUT) {
             // OBB：用船前向定义局部坐标，做“矩形”裁剪
             vec2 delta = FragPos.xz - uBoatPos.xz;
             vec2 f = uBoatForwardXZ;
@@ -93,7 +176,13 @@ void main() {
         }
     }
 
+#if VARIANT_OCEAN_FFT
+    // 逐片元采样坡度图，细节不受水面网格密度限制
+    vec2 slope = texture(uOceanSlope, OceanUV).xy;
+    vec3 norm = normalize(vec3(-slope.x, 1.0, -slope.y));
+#else
     vec3 norm = normalize(Normal);
+#endif
     vec3 viewDir = normalize(uViewPos - wakeAdjustedPos);
     vec3 lightDir = normalize(uLightDir);
     
@@ -128,7 +217,15 @@ void main() {
     
     // 透明度（基于菲涅尔效应）
     float alpha = mix(0.7, 0.95, fresnel);
-    if (uUseBoatCutout == 1) {
+
+#if VARIANT_TERRAIN_MASK
+    // === 7. 岸边泡沫（离岸越近越浓，随时间轻微起伏） ===
+    float shoreFoam = 1.0 - smoothstep(0.0, SHORE_FOAM_WIDTH, shoreDistance(cellPos));
+    shoreFoam *= 0.75 + 0.25 * sin(uTime * 1.5 + dot(MaskPos, vec2(2.3, 1.7)));
+    color = mix(color, foamColor, shoreFoam * 0.6);
+    alpha = mix(alpha, 1.0, shoreFoam * 0.5);
+#endif
+    if (USE_BOAT_CUTOUT) {
         // 在cutout边缘区域平滑混合颜色
         // cutoutMask接近0时增加深水颜色，使边界不那么明显
         if (cutoutMask < 0.8) {
@@ -3,10 +3,15 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aUV;
 
+// 每帧共享数据（UniformBuffers::updateFrame 上传，绑定点 0）
+layout (std140) uniform FrameBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec3 uViewPos;
+    float uTime;
+};
+
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
-uniform float uTime;
 
 // Gerstner Wave 参数
 struct Wave {
@@ -17,8 +22,42 @@ struct Wave {
     float steepness;
 };
 
-uniform int uWaveCount;
-uniform Wave uWaves[4];
+// 波浪参数（绑定点 2）
+layout (std140) uniform WaveBlock {
+    Wave uWaves[4];
+    int uWaveCount;
+};
+
+// 编译期变体（Shader::getVariant 注入）：
+//   VARIANT_OCEAN_FFT     1=位移和法线来自 FFT 海面的位移图 / 坡度图（OceanSpectrum），不计算 Gerstner 波
+//   VARIANT_TERRAIN_MASK  1=输出未经位移的世界坐标，片段着色器据此查询地形类型图
+//   VARIANT_WATER_CLIPMAP 1=aPos 是 WaterClipmap 的整数网格坐标，按层的原点和格距放到世界坐标（总是与地形遮罩一起使用）
+#ifndef VARIANT_OCEAN_FFT
+#define VARIANT_OCEAN_FFT 0
+#endif
+#ifndef VARIANT_TERRAIN_MASK
+#define VARIANT_TERRAIN_MASK 0
+#endif
+#ifndef VARIANT_WATER_CLIPMAP
+#define VARIANT_WATER_CLIPMAP 0
+#endif
+
+#if VARIANT_WATER_CLIPMAP
+uniform vec2 uClipmapOrigin;    // 本层网格 (0, 0) 的世界坐标 (x, z)
+uniform float uClipmapCellSize; // 本层格距
+uniform vec2 uClipmapMorph;     // (开始过渡的距离, 1 / 过渡带宽度)
+#endif
+
+#if VARIANT_TERRAIN_MASK
+out vec2 MaskPos;               // 未经波浪位移的世界坐标，用于查询地形类型
+#endif
+
+#if VARIANT_OCEAN_FFT
+uniform sampler2D uOceanDisplacement;  // (dx, h, dz)
+uniform sampler2D uOceanSlope;         // (dh/dx, dh/dz)
+uniform float uOceanTileSize;          // 瓦片边长（米），纹理以 GL_REPEAT 平铺
+out vec2 OceanUV;
+#endif
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -69,13 +108,55 @@ vec3 calculateGerstnerWave(vec3 pos) {
     return result;
 }
 
+#if VARIANT_OCEAN_FFT
+// 采样 FFT 海面：图定义在顶点原始位置上，采样值直接叠加
+vec3 calculateOceanWave(vec3 pos) {
+    // 第 i 个采样位于 i * 格距，对应纹素中心需要偏移半个纹素
+    OceanUV = pos.xz / uOceanTileSize + 0.5 / vec2(textureSize(uOceanDisplacement, 0));
+    vec3 displacement = textureLod(uOceanDisplacement, OceanUV, 0.0).xyz;
+    vec2 slope = textureLod(uOceanSlope, OceanUV, 0.0).xy;
+
+    Normal = normalize(vec3(-slope.x, 1.0, -slope.y));
+    vec3 result = pos + displacement;
+    Height = result.y;
+    return result;
+}
+#endif
+
+#if VARIANT_WATER_CLIPMAP
+// 外圈的奇数格点向相邻偶数格点收拢，到本层边界时与下一层（格距加倍）的顶点重合
+vec3 clipmapPosition() {
+    vec2 grid = aPos.xz;
+    vec2 delta = abs(uClipmapOrigin + grid * uClipmapCellSize - uViewPos.xz);
+    float morph = clamp((max(delta.x, delta.y) - uClipmapMorph.x) * uClipmapMorph.y, 0.0, 1.0);
+    grid -= fract(grid * 0.5) * 2.0 * morph;
+    vec2 world = uClipmapOrigin + grid * uClipmapCellSize;
+    return vec3(world.x, 0.0, world.y);
+}
+#endif
+
 void main() {
     // 计算波浪变形后的位置
+#if VARIANT_WATER_CLIPMAP
+    vec3 worldPos = vec3(uModel * vec4(clipmapPosition(), 1.0));
+#else
     vec3 worldPos = vec3(uModel * vec4(aPos, 1.0));
+#endif
+#if VARIANT_TERRAIN_MASK
+    MaskPos = worldPos.xz;
+#endif
+#if VARIANT_OCEAN_FFT
+    vec3 displacedPos = calculateOceanWave(worldPos);
+#else
     vec3 displacedPos = calculateGerstnerWave(worldPos);
+#endif
     
     FragPos = displacedPos;
+#if VARIANT_WATER_CLIPMAP
+    UV = worldPos.xz * 0.1;  // 世界坐标的 UV，与层无关
+#else
     UV = aUV;
+#endif
     
     gl_Position = uProjection * uView * vec4(displacedPos, 1.0);
 }
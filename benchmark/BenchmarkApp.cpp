@@ -0,0 +1,193 @@
+#include "BenchmarkApp.h"
+#include "Core/Profiler.h"
+#include "Render/GLCounters.h"
+#include "Render/OrbitCamera.h"
+#include "Render/OrthographicCamera.h"
+#include "Water/WaterSurface.h"
+#include <cmath>
+#include <iostream>
+
+namespace WaterTown {
+
+namespace {
+
+const float BENCHMARK_FRAME_TIME = 1.0f / 60.0f;
+
+const char* modeName(EditorMode mode) {
+    switch (mode) {
+        case EditorMode::TERRAIN: return "TERRAIN";
+        case EditorMode::BUILDING: return "BUILDING";
+        case EditorMode::GAME: return "GAME";
+        default: return "UNKNOWN";
+    }
+}
+
+} // namespace
+
+BenchmarkApp::BenchmarkApp(const BenchmarkConfig& config)
+    : WaterTownApp(config.width, config.height, "WaterTown - Benchmark", config.headless),
+      m_config(config), m_path(defaultPath()) {}
+
+std::vector<BenchmarkSegment> BenchmarkApp::defaultPath() {
+    std::vector<BenchmarkSegment> path;
+    //               模式                帧数  起点Z   终点Z   起始偏航 终止偏航 距离    转向幅度
+    path.push_back({EditorMode::TERRAIN, 120, 0.0f, 200.0f, 0.0f, 0.0f, 160.0f, 0.0f});
+    path.push_back({EditorMode::BUILDING, 300, 0.0f, 400.0f, 30.0f, 120.0f, 60.0f, 0.0f});
+    path.push_back({EditorMode::GAME, 300, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.35f});
+    path.push_back({EditorMode::BUILDING, 120, 400.0f, 0.0f, 120.0f, 210.0f, 120.0f, 0.0f});
+    return path;
+}
+
+void BenchmarkApp::onInit() {
+    WaterTownApp::onInit();
+
+    // 每帧推进固定时间，模拟步数与相机路径与机器快慢无关
+    setFixedFrameTime(BENCHMARK_FRAME_TIME);
+    Profiler::setEnabled(true);
+    m_report.setCountersEnabled(GLCounters::ENABLED);
+    if (!GLCounters::ENABLED) {
+        std::cout << "Benchmark: GL counters are compiled out, configure with -DWATERTOWN_GL_COUNTERS=ON to record them"
+                  << std::endl;
+    }
+
+    if (!m_config.scenePath.empty()) {
+        if (m_sceneEditor->loadScene(m_config.scenePath)) {
+            std::cout << "Benchmark: loaded scene " << m_config.scenePath << std::endl;
+        } else {
+            std::cerr << "Benchmark: failed to load scene: " << m_config.scenePath << std::endl;
+            m_failed = true;
+            getWindow()->requestClose();
+            return;
+        }
+    }
+    if (m_waterSurface) {
+        m_waterSurface->setClipmapEnabled(m_config.clipmapWater);
+    }
+    m_origin = m_sceneEditor->getBoatPlacedPosition();
+
+    int scriptedFrames = 0;
+    for (const BenchmarkSegment& segment : m_path) {
+        scriptedFrames += segment.frames;
+    }
+    // 额外多跑几帧，等最后一帧的 GPU 查询结果读回
+    m_totalFrames = m_config.warmupFrames + scriptedFrames + Profiler::FRAME_LATENCY + 1;
+    m_frames.assign(static_cast<size_t>(m_totalFrames), BenchmarkFrame());
+    m_profiled.assign(static_cast<size_t>(m_totalFrames), false);
+}
+
+void BenchmarkApp::onUpdate(float deltaTime) {
+    if (m_failed || m_totalFrames == 0) return;
+
+    const int frame = m_frameIndex++;
+    collectResults(frame);
+    if (frame >= m_totalFrames) {
+        finish();
+        return;
+    }
+
+    float progress = 0.0f;
+    const BenchmarkSegment& segment = m_path[locateSegment(frame, progress)];
+    if (m_sceneEditor->getCurrentMode() != segment.mode) {
+        if (segment.mode == EditorMode::GAME && !m_sceneEditor->canEnterGameMode()) {
+            std::cerr << "Benchmark: scene has no boat, cannot enter GAME mode" << std::endl;
+            m_failed = true;
+            getWindow()->requestClose();
+            return;
+        }
+        m_sceneEditor->switchMode(segment.mode);
+    }
+    m_frames[frame].mode = modeName(segment.mode);
+
+    // 先走编辑器自己的每帧逻辑（更新当前相机指针），再覆盖成脚本输入
+    WaterTownApp::onUpdate(deltaTime);
+    applyCamera(segment, progress);
+}
+
+int BenchmarkApp::locateSegment(int frame, float& outProgress) const {
+    int local = frame - m_config.warmupFrames;
+    if (local < 0) {
+        outProgress = 0.0f;
+        return 0;
+    }
+    for (size_t i = 0; i < m_path.size(); ++i) {
+        if (local < m_path[i].frames) {
+            outProgress = static_cast<float>(local) / static_cast<float>(m_path[i].frames);
+            return static_cast<int>(i);
+        }
+        local -= m_path[i].frames;
+    }
+    outProgress = 1.0f;
+    return static_cast<int>(m_path.size()) - 1;
+}
+
+void BenchmarkApp::applyCamera(const BenchmarkSegment& segment, float progress) {
+    const float z = m_origin.z + segment.startZ + (segment.endZ - segment.startZ) * progress;
+    const glm::vec3 target(m_origin.x, 0.0f, z);
+
+    if (segment.mode == EditorMode::TERRAIN) {
+        auto* ortho = dynamic_cast<OrthographicCamera*>(m_sceneEditor->getCurrentCamera());
+        if (ortho) {
+            ortho->setCenter(target.x, target.z);
+            ortho->setViewSize(segment.distance, segment.distance / getWindow()->getAspectRatio());
+        }
+    } else if (segment.mode == EditorMode::BUILDING) {
+        OrbitCamera* orbit = m_sceneEditor->getOrbitCamera();
+        if (orbit) {
+            const float yaw = segment.startYaw + (segment.endYaw - segment.startYaw) * progress;
+            orbit->setTarget(target);
+            orbit->setAngles(yaw, orbit->getPitchDegrees());
+            orbit->setDistance(segment.distance);
+        }
+    } else if (segment.mode == EditorMode::GAME) {
+        // 全油门，方向左右摆动，船沿河道蛇行前进
+        const float turn = segment.turnAmplitude * std::sin(progress * 6.2831853f * 2.0f);
+        m_sceneEditor->handleGameInput(1.0f, turn);
+    }
+}
+
+void BenchmarkApp::collectResults(int frame) {
+    // 绘制统计属于上一帧
+    const int drawnFrame = frame - 1;
+    if (drawnFrame >= 0 && drawnFrame < m_totalFrames) {
+        const GLFrameCounters& counters = GLCounters::getLastFrame();
+        BenchmarkFrame& record = m_frames[drawnFrame];
+        record.drawCalls = counters.drawCalls;
+        record.triangles = counters.triangles;
+        record.bufferUploads = counters.bufferUploads;
+        record.bufferBytes = counters.bufferBytes;
+        record.uniformCalls = counters.uniformCalls;
+        record.bindCalls = counters.bindCalls;
+    }
+
+    // 计时结果延迟 FRAME_LATENCY 帧
+    const int timedFrame = frame - Profiler::FRAME_LATENCY;
+    if (timedFrame >= 0 && timedFrame < m_totalFrames) {
+        const ProfileFrame& profile = Profiler::getLastFrame();
+        if (profile.index == static_cast<uint64_t>(timedFrame)) {
+            m_frames[timedFrame].cpuMs = profile.cpuMs;
+            m_frames[timedFrame].gpuMs = profile.gpuMs;
+            m_frames[timedFrame].hasGpu = profile.hasGpu;
+            m_profiled[timedFrame] = true;
+        }
+    }
+}
+
+void BenchmarkApp::finish() {
+    int scriptedFrames = m_totalFrames - m_config.warmupFrames - Profiler::FRAME_LATENCY - 1;
+    int missing = 0;
+    for (int i = 0; i < scriptedFrames; ++i) {
+        int frame = m_config.warmupFrames + i;
+        if (!m_profiled[frame]) {
+            ++missing;
+            continue;
+        }
+        m_report.addFrame(m_frames[frame]);
+    }
+    if (missing > 0) {
+        std::cerr << "Benchmark: " << missing << " frames have no timing data" << std::endl;
+    }
+    std::cout << "Benchmark: recorded " << m_report.getFrames().size() << " frames" << std::endl;
+    getWindow()->requestClose();
+}
+
+} // namespace WaterTown
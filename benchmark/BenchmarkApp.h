@@ -0,0 +1,86 @@
+#pragma once
+
+#include "App/WaterTownApp.h"
+#include "Editor/SceneEditor.h"
+#include "BenchmarkReport.h"
+#include <string>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 基准测试配置
+ */
+struct BenchmarkConfig {
+    int width = 1280;
+    int height = 720;
+    bool headless = true;
+    std::string scenePath;   // 为空时使用默认河道场景
+    int warmupFrames = 60;   // 不计入结果（着色器编译、缓冲首次上传等）
+    bool clipmapWater = true;  // false 时水面改用规则网格（两者都按地形类型图遮罩）
+};
+
+/**
+ * @brief 脚本化相机路径中的一段
+ *
+ * 每段固定在一个编辑模式下运行若干帧，相机（或游戏模式下的船只油门）
+ * 在起止参数之间线性插值。位置以默认船只放置点为原点。
+ */
+struct BenchmarkSegment {
+    EditorMode mode;
+    int frames;
+    float startZ;        // 沿河道方向的起点（米，相对船只放置点）
+    float endZ;
+    float startYaw;      // 轨道相机偏航角（建筑模式）
+    float endYaw;
+    float distance;      // 轨道相机距离 / 正交相机视野宽度
+    float turnAmplitude; // 游戏模式下转向输入的摆动幅度
+};
+
+/**
+ * @brief 无显示基准测试应用
+ *
+ * 复用 WaterTownApp 的完整初始化和渲染路径，只把用户输入换成固定脚本：
+ * 沿默认河道飞行，并依次切换地形 / 建筑 / 游戏模式。每帧以固定时间步推进，
+ * 不同机器上渲染的内容完全相同。逐帧记录 CPU/GPU 时间和 GLCounters 的调用统计。
+ */
+class BenchmarkApp : public WaterTownApp {
+public:
+    explicit BenchmarkApp(const BenchmarkConfig& config);
+
+    const BenchmarkReport& getReport() const { return m_report; }
+    bool hasFailed() const { return m_failed; }
+
+    /**
+     * @brief 默认脚本：地形俯视 -> 建筑模式沿河飞行 -> 游戏模式开船 -> 返回建筑模式
+     */
+    static std::vector<BenchmarkSegment> defaultPath();
+
+protected:
+    void onInit() override;
+    void onUpdate(float deltaTime) override;
+    void onImGui() override {}
+
+private:
+    BenchmarkConfig m_config;
+    std::vector<BenchmarkSegment> m_path;
+    std::vector<BenchmarkFrame> m_frames;  // 下标为主循环帧号
+    std::vector<bool> m_profiled;          // 该帧是否已拿到计时结果
+    BenchmarkReport m_report;
+    glm::vec3 m_origin = glm::vec3(0.0f);
+    int m_frameIndex = 0;
+    int m_totalFrames = 0;
+    bool m_failed = false;
+
+    /**
+     * @brief 根据帧号找到所在的段和段内进度
+     * @return 段下标；预热阶段返回第一段，结束后返回最后一段
+     */
+    int locateSegment(int frame, float& outProgress) const;
+
+    void applyCamera(const BenchmarkSegment& segment, float progress);
+    void collectResults(int frame);
+    void finish();
+};
+
+} // namespace WaterTown
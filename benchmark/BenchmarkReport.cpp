@@ -0,0 +1,311 @@
+#include "BenchmarkReport.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace WaterTown {
+
+namespace {
+
+const double TIME_NOISE_FLOOR_MS = 0.05;  // 低于此差值的计时变化视为噪声
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(std::ceil(p * values.size()));
+    index = std::min(std::max(index, static_cast<size_t>(1)), values.size()) - 1;
+    return values[index];
+}
+
+double mean(const std::vector<double>& values) {
+    if (values.empty()) return 0.0;
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    return sum / values.size();
+}
+
+void summarizeGroup(const std::vector<const BenchmarkFrame*>& frames, const std::string& group,
+                    bool withCounters, std::map<std::string, double>& out) {
+    std::vector<double> cpu, gpu, draws, triangles, uploads, uploadBytes, uniforms, binds;
+    for (const BenchmarkFrame* frame : frames) {
+        cpu.push_back(frame->cpuMs);
+        if (frame->hasGpu) gpu.push_back(frame->gpuMs);
+        draws.push_back(static_cast<double>(frame->drawCalls));
+        triangles.push_back(static_cast<double>(frame->triangles));
+        uploads.push_back(static_cast<double>(frame->bufferUploads));
+        uploadBytes.push_back(static_cast<double>(frame->bufferBytes));
+        uniforms.push_back(static_cast<double>(frame->uniformCalls));
+        binds.push_back(static_cast<double>(frame->bindCalls));
+    }
+
+    out[group + ".frames"] = static_cast<double>(frames.size());
+    out[group + ".cpuMeanMs"] = mean(cpu);
+    out[group + ".cpuP50Ms"] = percentile(cpu, 0.50);
+    out[group + ".cpuP95Ms"] = percentile(cpu, 0.95);
+    out[group + ".cpuMaxMs"] = cpu.empty() ? 0.0 : *std::max_element(cpu.begin(), cpu.end());
+    if (!gpu.empty()) {
+        out[group + ".gpuMeanMs"] = mean(gpu);
+        out[group + ".gpuP95Ms"] = percentile(gpu, 0.95);
+    }
+    if (withCounters) {
+        out[group + ".drawCalls"] = mean(draws);
+        out[group + ".triangles"] = mean(triangles);
+        out[group + ".bufferUploads"] = mean(uploads);
+        out[group + ".bufferBytes"] = mean(uploadBytes);
+        out[group + ".uniformCalls"] = mean(uniforms);
+        out[group + ".bindCalls"] = mean(binds);
+    }
+}
+
+bool endsWith(const std::string& text, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+void appendString(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    out += '"';
+}
+
+/**
+ * @brief 只认识本文件写出的 JSON 子集（对象、数组、字符串、数字、布尔），
+ *        把所有数字叶子展平成 "a.b.c" 形式的键
+ */
+class JsonFlattener {
+public:
+    explicit JsonFlattener(const std::string& text) : m_text(text), m_pos(0) {}
+
+    bool parse(std::map<std::string, double>& out) {
+        m_out = &out;
+        return parseValue("") && (skipSpace(), m_pos == m_text.size());
+    }
+
+private:
+    const std::string& m_text;
+    size_t m_pos;
+    std::map<std::string, double>* m_out = nullptr;
+
+    void skipSpace() {
+        while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) ++m_pos;
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (m_pos < m_text.size() && m_text[m_pos] == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool parseString(std::string& out) {
+        if (!consume('"')) return false;
+        out.clear();
+        while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+            if (m_text[m_pos] == '\\' && m_pos + 1 < m_text.size()) ++m_pos;
+            out += m_text[m_pos++];
+        }
+        return consume('"');
+    }
+
+    bool parseValue(const std::string& path) {
+        skipSpace();
+        if (m_pos >= m_text.size()) return false;
+        char c = m_text[m_pos];
+        if (c == '{') {
+            ++m_pos;
+            if (consume('}')) return true;
+            do {
+                std::string key;
+                if (!parseString(key) || !consume(':')) return false;
+                if (!parseValue(path.empty() ? key : path + "." + key)) return false;
+            } while (consume(','));
+            return consume('}');
+        }
+        if (c == '[') {
+            ++m_pos;
+            if (consume(']')) return true;
+            int index = 0;
+            do {
+                if (!parseValue(path + "[" + std::to_string(index++) + "]")) return false;
+            } while (consume(','));
+            return consume(']');
+        }
+        if (c == '"') {
+            std::string ignored;
+            return parseString(ignored);
+        }
+        if (m_text.compare(m_pos, 4, "true") == 0) { m_pos += 4; return true; }
+        if (m_text.compare(m_pos, 5, "false") == 0) { m_pos += 5; return true; }
+        if (m_text.compare(m_pos, 4, "null") == 0) { m_pos += 4; return true; }
+
+        const char* begin = m_text.c_str() + m_pos;
+        char* end = nullptr;
+        double value = std::strtod(begin, &end);
+        if (end == begin) return false;
+        m_pos += static_cast<size_t>(end - begin);
+        (*m_out)[path] = value;
+        return true;
+    }
+};
+
+} // namespace
+
+std::map<std::string, double> BenchmarkReport::summarize() const {
+    std::map<std::string, double> summary;
+
+    std::vector<const BenchmarkFrame*> all;
+    std::map<std::string, std::vector<const BenchmarkFrame*>> byMode;
+    for (const BenchmarkFrame& frame : m_frames) {
+        all.push_back(&frame);
+        byMode[frame.mode].push_back(&frame);
+    }
+
+    summarizeGroup(all, "all", m_countersEnabled, summary);
+    for (const auto& group : byMode) {
+        summarizeGroup(group.second, group.first, m_countersEnabled, summary);
+    }
+    return summary;
+}
+
+bool BenchmarkReport::writeJson(const std::string& path, const std::map<std::string, std::string>& info) const {
+    std::string out = "{\n\"info\": {";
+    bool first = true;
+    for (const auto& entry : info) {
+        out += first ? "\n  " : ",\n  ";
+        first = false;
+        appendString(out, entry.first);
+        out += ": ";
+        appendString(out, entry.second);
+    }
+    out += "\n},\n\"summary\": {";
+
+    // 汇总按分组写成嵌套对象，读回时重新展平成相同的键
+    std::map<std::string, std::map<std::string, double>> groups;
+    for (const auto& entry : summarize()) {
+        size_t dot = entry.first.find('.');
+        groups[entry.first.substr(0, dot)][entry.first.substr(dot + 1)] = entry.second;
+    }
+    char number[64];
+    bool firstGroup = true;
+    for (const auto& group : groups) {
+        out += firstGroup ? "\n  " : ",\n  ";
+        firstGroup = false;
+        appendString(out, group.first);
+        out += ": {";
+        bool firstValue = true;
+        for (const auto& value : group.second) {
+            out += firstValue ? "" : ", ";
+            firstValue = false;
+            appendString(out, value.first);
+            std::snprintf(number, sizeof(number), ": %.4f", value.second);
+            out += number;
+        }
+        out += "}";
+    }
+    out += "\n},\n\"frames\": [";
+
+    char line[256];
+    for (size_t i = 0; i < m_frames.size(); ++i) {
+        const BenchmarkFrame& frame = m_frames[i];
+        out += i == 0 ? "\n  {\"mode\": " : ",\n  {\"mode\": ";
+        appendString(out, frame.mode);
+        std::snprintf(line, sizeof(line), ", \"cpuMs\": %.4f, \"gpuMs\": %.4f, \"hasGpu\": %s",
+                      frame.cpuMs, frame.gpuMs, frame.hasGpu ? "true" : "false");
+        out += line;
+        if (m_countersEnabled) {
+            std::snprintf(line, sizeof(line),
+                          ", \"drawCalls\": %u, \"triangles\": %llu, \"bufferUploads\": %u"
+                          ", \"bufferBytes\": %llu, \"uniformCalls\": %u, \"bindCalls\": %u",
+                          frame.drawCalls, static_cast<unsigned long long>(frame.triangles),
+                          frame.bufferUploads, static_cast<unsigned long long>(frame.bufferBytes),
+                          frame.uniformCalls, frame.bindCalls);
+            out += line;
+        }
+        out += "}";
+    }
+    out += "\n]\n}\n";
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Benchmark: failed to open output file: " << path << std::endl;
+        return false;
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+bool BenchmarkReport::readSummary(const std::string& path, std::map<std::string, double>& outSummary) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Benchmark: failed to open baseline: " << path << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+
+    std::map<std::string, double> values;
+    JsonFlattener parser(text);
+    if (!parser.parse(values)) {
+        std::cerr << "Benchmark: failed to parse baseline: " << path << std::endl;
+        return false;
+    }
+
+    const std::string prefix = "summary.";
+    outSummary.clear();
+    for (const auto& entry : values) {
+        if (entry.first.compare(0, prefix.size(), prefix) == 0) {
+            outSummary[entry.first.substr(prefix.size())] = entry.second;
+        }
+    }
+    if (outSummary.empty()) {
+        std::cerr << "Benchmark: baseline has no summary: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool BenchmarkReport::compare(const std::map<std::string, double>& current,
+                              const std::map<std::string, double>& baseline,
+                              double threshold) {
+    bool passed = true;
+    char line[256];
+    std::cout << "Comparing against baseline (threshold " << threshold * 100.0 << "%)" << std::endl;
+    for (const auto& entry : baseline) {
+        const std::string& key = entry.first;
+        // 帧数和单帧最大值只作参考，最大值受偶发抖动影响太大
+        if (endsWith(key, ".frames") || endsWith(key, "MaxMs")) continue;
+
+        auto it = current.find(key);
+        if (it == current.end()) {
+            std::cout << "  " << key << ": missing in current run" << std::endl;
+            continue;
+        }
+
+        double base = entry.second;
+        double value = it->second;
+        double limit = base * (1.0 + threshold);
+        bool isTime = endsWith(key, "Ms");
+        bool regressed = value > limit && !(isTime && value - base < TIME_NOISE_FLOOR_MS);
+        double change = base > 0.0 ? (value - base) / base * 100.0 : 0.0;
+
+        std::snprintf(line, sizeof(line), "  %-24s %12.3f -> %12.3f (%+6.1f%%)%s",
+                      key.c_str(), base, value, change, regressed ? "  REGRESSION" : "");
+        std::cout << line << std::endl;
+        if (regressed) passed = false;
+    }
+    return passed;
+}
+
+} // namespace WaterTown
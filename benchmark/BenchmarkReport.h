@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 基准测试中一帧的测量结果
+ */
+struct BenchmarkFrame {
+    std::string mode;        // TERRAIN / BUILDING / GAME
+    double cpuMs = 0.0;
+    double gpuMs = 0.0;
+    bool hasGpu = false;     // GPU 计时是否有效（驱动不支持时间戳查询时为 false）
+    uint32_t drawCalls = 0;
+    uint64_t triangles = 0;
+    uint32_t bufferUploads = 0;
+    uint64_t bufferBytes = 0;
+    uint32_t uniformCalls = 0;
+    uint32_t bindCalls = 0;
+};
+
+/**
+ * @brief 基准测试结果：逐帧数据、汇总统计、JSON 读写和基线对比
+ *
+ * 汇总按 "分组.指标" 展平成键，例如 "all.cpuP95Ms"、"GAME.drawCalls"，
+ * 基线对比只看这些汇总值，逐帧数据仅用于离线分析。
+ */
+class BenchmarkReport {
+public:
+    void addFrame(const BenchmarkFrame& frame) { m_frames.push_back(frame); }
+    const std::vector<BenchmarkFrame>& getFrames() const { return m_frames; }
+
+    /**
+     * @brief GL 调用计数是否编译进来；未编译时汇总中不输出这些指标
+     */
+    void setCountersEnabled(bool enabled) { m_countersEnabled = enabled; }
+
+    /**
+     * @brief 计算汇总统计（整体以及每个模式）
+     */
+    std::map<std::string, double> summarize() const;
+
+    /**
+     * @brief 写出 JSON（元信息 + 汇总 + 逐帧）
+     */
+    bool writeJson(const std::string& path, const std::map<std::string, std::string>& info) const;
+
+    /**
+     * @brief 从基线 JSON 中读取汇总
+     */
+    static bool readSummary(const std::string& path, std::map<std::string, double>& outSummary);
+
+    /**
+     * @brief 与基线对比，任一指标比基线高出 threshold（比例）即视为回退
+     * @return 没有回退返回 true
+     */
+    static bool compare(const std::map<std::string, double>& current,
+                        const std::map<std::string, double>& baseline,
+                        double threshold);
+
+private:
+    std::vector<BenchmarkFrame> m_frames;
+    bool m_countersEnabled = true;
+};
+
+} // namespace WaterTown
@@ -0,0 +1,105 @@
+#include "BenchmarkApp.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace WaterTown;
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl;
+    std::cout << "  --scene <file>       load a scene via SceneEditor::loadScene (default: built-in canal)" << std::endl;
+    std::cout << "  --out <file>         result JSON (default: benchmark_result.json)" << std::endl;
+    std::cout << "  --baseline <file>    compare against a previous result JSON" << std::endl;
+    std::cout << "  --threshold <ratio>  allowed slowdown before failing, e.g. 0.1 = 10% (default: 0.1)" << std::endl;
+    std::cout << "  --size <w> <h>       render resolution (default: 1280 720)" << std::endl;
+    std::cout << "  --warmup <frames>    frames to skip before recording (default: 60)" << std::endl;
+    std::cout << "  --windowed           use a visible window instead of a headless context" << std::endl;
+    std::cout << "  --grid-water         render water with the fixed grid instead of the clipmap" << std::endl;
+    std::cout << "Exit code: 0 ok, 1 error, 2 regression against baseline" << std::endl;
+}
+
+std::string glString(GLenum name) {
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "unknown";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkConfig config;
+    std::string outPath = "benchmark_result.json";
+    std::string baselinePath;
+    double threshold = 0.1;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--scene") == 0 && hasValue) {
+            config.scenePath = argv[++i];
+        } else if (std::strcmp(arg, "--out") == 0 && hasValue) {
+            outPath = argv[++i];
+        } else if (std::strcmp(arg, "--baseline") == 0 && hasValue) {
+            baselinePath = argv[++i];
+        } else if (std::strcmp(arg, "--threshold") == 0 && hasValue) {
+            threshold = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--size") == 0 && i + 2 < argc) {
+            config.width = std::atoi(argv[++i]);
+            config.height = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--warmup") == 0 && hasValue) {
+            config.warmupFrames = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--windowed") == 0) {
+            config.headless = false;
+        } else if (std::strcmp(arg, "--grid-water") == 0) {
+            config.clipmapWater = false;
+        } else {
+            printUsage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (config.width <= 0 || config.height <= 0 || config.warmupFrames < 0 || threshold < 0.0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::map<std::string, double> summary;
+    try {
+        BenchmarkApp app(config);
+        app.run();
+        if (app.hasFailed() || app.getReport().getFrames().empty()) {
+            std::cerr << "Benchmark did not complete." << std::endl;
+            return 1;
+        }
+
+        std::map<std::string, std::string> info;
+        info["scene"] = config.scenePath.empty() ? "default" : config.scenePath;
+        info["resolution"] = std::to_string(config.width) + "x" + std::to_string(config.height);
+        info["water"] = config.clipmapWater ? "clipmap" : "grid";
+        info["renderer"] = glString(GL_RENDERER);
+        info["version"] = glString(GL_VERSION);
+
+        if (!app.getReport().writeJson(outPath, info)) {
+            return 1;
+        }
+        std::cout << "Benchmark: wrote " << outPath << std::endl;
+        summary = app.getReport().summarize();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (!baselinePath.empty()) {
+        std::map<std::string, double> baseline;
+        if (!BenchmarkReport::readSummary(baselinePath, baseline)) {
+            return 1;
+        }
+        if (!BenchmarkReport::compare(summary, baseline, threshold)) {
+            std::cerr << "Benchmark: performance regression against " << baselinePath << std::endl;
+            return 2;
+        }
+        std::cout << "Benchmark: no regression against " << baselinePath << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "MicroScene.h"
+#include "Render/TerrainMesher.h"
+#include "Water/WaterMeshBuilder.h"
+#include <benchmark/benchmark.h>
+
+namespace WaterTown {
+namespace Micro {
+
+// 整张地图全部区块重建一次（加载场景 / 整体替换地形时的开销）
+static void BM_TerrainMeshAllChunks(benchmark::State& state) {
+    const TerrainMap& terrain = canalTerrain();
+    TerrainMesher mesher(CELL_SIZE, WATER_LEVEL);
+    TerrainChunkMesh mesh;
+    size_t vertices = 0;
+    size_t bricks = 0;
+    for (auto _ : state) {
+        vertices = 0;
+        bricks = 0;
+        for (int cz = 0; cz < terrain.getChunksZ(); ++cz) {
+            for (int cx = 0; cx < terrain.getChunksX(); ++cx) {
+                mesher.buildChunk(terrain, cx, cz, mesh);
+                vertices += mesh.vertices.size();
+                bricks += mesh.brickOffsets.size();
+                benchmark::DoNotOptimize(mesh.indices.data());
+            }
+        }
+    }
+    const int chunks = terrain.getChunksX() * terrain.getChunksZ();
+    state.SetItemsProcessed(state.iterations() * chunks);
+    state.counters["chunks"] = chunks;
+    state.counters["vertices"] = static_cast<double>(vertices);
+    state.counters["bricks"] = static_cast<double>(bricks);
+}
+BENCHMARK(BM_TerrainMeshAllChunks)->Unit(benchmark::kMillisecond);
+
+// 同上，区块分给 JobSystem 的所有线程（TerrainRenderer 的实际做法）
+static void BM_TerrainMeshAllChunksParallel(benchmark::State& state) {
+    startJobSystem();
+    const TerrainMap& terrain = canalTerrain();
+    const int chunks = terrain.getChunksX() * terrain.getChunksZ();
+    std::vector<TerrainMesher> meshers(JobSystem::getThreadCount(), TerrainMesher(CELL_SIZE, WATER_LEVEL));
+    std::vector<TerrainChunkMesh> meshes(chunks);
+    for (auto _ : state) {
+        JobSystem::parallelFor(0, chunks, 4, [&](int begin, int end) {
+            TerrainMesher& mesher = meshers[JobSystem::currentThreadIndex()];
+            for (int i = begin; i < end; ++i) {
+                mesher.buildChunk(terrain, i % terrain.getChunksX(), i / terrain.getChunksX(), meshes[i]);
+            }
+        });
+        benchmark::DoNotOptimize(meshes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * chunks);
+    state.counters["threads"] = JobSystem::getThreadCount();
+}
+BENCHMARK(BM_TerrainMeshAllChunksParallel)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// 编辑一个格子后的局部重建：3x3 邻域覆盖到的区块（最坏情况为 4 个）
+static void BM_TerrainMeshEditedChunks(benchmark::State& state) {
+    const TerrainMap& terrain = canalTerrain();
+    TerrainMesher mesher(CELL_SIZE, WATER_LEVEL);
+    TerrainChunkMesh mesh;
+    const int chunkX = RIVER_START / TerrainMap::CHUNK_SIZE;
+    const int chunkZ = terrain.getChunksZ() / 2;
+    for (auto _ : state) {
+        for (int dz = 0; dz < 2; ++dz) {
+            for (int dx = 0; dx < 2; ++dx) {
+                mesher.buildChunk(terrain, chunkX + dx, chunkZ + dz, mesh);
+                benchmark::DoNotOptimize(mesh.indices.data());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK(BM_TerrainMeshEditedChunks)->Unit(benchmark::kMicrosecond);
+
+static void BM_TerrainBrickTemplates(benchmark::State& state) {
+    TerrainMesher mesher(CELL_SIZE, WATER_LEVEL);
+    std::vector<TerrainVertex> vertices;
+    std::vector<uint32_t> indices;
+    uint32_t firstIndex[TerrainMesher::BRICK_TEMPLATE_COUNT];
+    uint32_t indexCount[TerrainMesher::BRICK_TEMPLATE_COUNT];
+    for (auto _ : state) {
+        mesher.buildBrickTemplates(vertices, indices, firstIndex, indexCount);
+        benchmark::DoNotOptimize(indices.data());
+    }
+    state.counters["vertices"] = static_cast<double>(vertices.size());
+}
+BENCHMARK(BM_TerrainBrickTemplates)->Unit(benchmark::kMicrosecond);
+
+// 默认规则水面网格，参数为每边格子数
+static void BM_WaterGridMesh(benchmark::State& state) {
+    const int resolution = static_cast<int>(state.range(0));
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    for (auto _ : state) {
+        WaterMeshBuilder::buildGrid(0.0f, 0.0f, GRID_SIZE_X * CELL_SIZE, GRID_SIZE_X * CELL_SIZE, resolution,
+                                    vertices, indices);
+        benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * (resolution + 1) * (resolution + 1));
+}
+BENCHMARK(BM_WaterGridMesh)->Arg(100)->Arg(320)->Unit(benchmark::kMicrosecond);
+
+} // namespace Micro
+} // namespace WaterTown
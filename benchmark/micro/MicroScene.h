@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Core/JobSystem.h"
+#include "Core/TerrainMap.h"
+#include "Physics/Boat.h"
+#include <cmath>
+#include <cstdint>
+
+namespace WaterTown {
+namespace Micro {
+
+// 与 SceneEditor 的默认场景一致：320 x 3200 格，格子边长 0.5
+const int GRID_SIZE_X = 320;
+const int GRID_SIZE_Z = 3200;
+const float CELL_SIZE = 0.5f;
+const float WATER_LEVEL = 0.0f;
+const int RIVER_START = GRID_SIZE_X / 2 - GRID_SIZE_X / 8;  // 中央主河道占 25% 宽度
+const int RIVER_END = RIVER_START + GRID_SIZE_X / 4;
+
+/**
+ * @brief 生成与默认场景同构的江南河道地形
+ *
+ * 中央主河道占 25% 宽度，两侧石岸与草地；另外每隔一段加一条横向支流和码头，
+ * 让河岸砖墙和水面矩形的数量接近编辑过的真实场景，而不只是几条长直线。
+ */
+inline void buildCanalTerrain(TerrainMap& terrain) {
+    terrain.resize(GRID_SIZE_X, GRID_SIZE_Z, TerrainType::GRASS);
+
+    const int bankWidth = 3;
+    const int riverStart = RIVER_START;
+    const int riverEnd = RIVER_END;
+
+    for (int z = 0; z < GRID_SIZE_Z; ++z) {
+        const bool sideCanal = (z % 160) < 12;  // 横向支流
+        const bool plaza = (z % 320) >= 106 && (z % 320) < 170;  // 码头广场
+        for (int x = 0; x < GRID_SIZE_X; ++x) {
+            TerrainType type = TerrainType::GRASS;
+            if (x >= riverStart && x < riverEnd) {
+                type = TerrainType::WATER;
+            } else if ((x >= riverStart - bankWidth && x < riverStart) ||
+                       (x >= riverEnd && x < riverEnd + bankWidth)) {
+                type = TerrainType::STONE;
+            } else if (plaza && ((x >= riverStart - bankWidth - 3 && x < riverStart) ||
+                                 (x >= riverEnd && x < riverEnd + bankWidth + 3))) {
+                type = TerrainType::STONE;
+            }
+            if (sideCanal && type != TerrainType::WATER && (z % 160) >= 2 && (z % 160) < 10) {
+                type = TerrainType::WATER;
+            }
+            terrain.set(x, z, type);
+        }
+    }
+}
+
+/**
+ * @brief 并行基准使用的作业系统（首次调用时启动，进程退出时由 JobSystem 自行关闭）
+ */
+inline void startJobSystem() {
+    static bool started = (JobSystem::initialize(), true);
+    (void)started;
+}
+
+/**
+ * @brief 所有基准共用的地形（首次使用时生成，不计入计时）
+ */
+inline const TerrainMap& canalTerrain() {
+    static TerrainMap terrain;
+    if (terrain.getSizeX() == 0) {
+        buildCanalTerrain(terrain);
+    }
+    return terrain;
+}
+
+/**
+ * @brief 主河道中心线的世界坐标 X
+ */
+inline float riverCenterX() {
+    return (RIVER_START + RIVER_END) * 0.5f * CELL_SIZE - GRID_SIZE_X * 0.5f * CELL_SIZE + CELL_SIZE * 0.5f;
+}
+
+/**
+ * @brief 地形碰撞回调（与 SceneEditor 相同：只有 WATER 格子安全）
+ */
+inline Boat::CollisionPredicate waterPredicate(const TerrainMap& terrain) {
+    return [&terrain](float x, float z) {
+        int gx = static_cast<int>(std::floor(x / CELL_SIZE + terrain.getSizeX() / 2.0f));
+        int gz = static_cast<int>(std::floor(z / CELL_SIZE + terrain.getSizeZ() / 2.0f));
+        return terrain.at(gx, gz) == TerrainType::WATER;
+    };
+}
+
+/**
+ * @brief 沿河岸两侧摆放障碍物（房屋、树木等的碰撞圆），一部分落在河道里（桥墩、船只）
+ */
+inline void scatterObstacles(Boat& boat, int count) {
+    uint32_t seed = 12345u;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+    };
+    const float halfX = GRID_SIZE_X * CELL_SIZE * 0.5f;
+    const float halfZ = GRID_SIZE_Z * CELL_SIZE * 0.5f;
+    for (int i = 0; i < count; ++i) {
+        float x = (i % 8 == 0) ? riverCenterX() + (next() - 0.5f) * 30.0f : (next() * 2.0f - 1.0f) * halfX;
+        float z = (next() * 2.0f - 1.0f) * halfZ;
+        boat.addObstacle(glm::vec3(x, 0.0f, z), 0.5f + next() * 1.5f);
+    }
+}
+
+} // namespace Micro
+} // namespace WaterTown
@@ -0,0 +1,186 @@
+#include "MicroScene.h"
+#include "Water/BoatWake.h"
+#include "Water/WaveModel.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+namespace WaterTown {
+namespace Micro {
+
+namespace {
+
+const float STEP = 1.0f / 60.0f;  // 与 Application 的固定步长一致
+
+} // namespace
+
+// 在主河道可见范围内按格子间距采样水面高度，参数为每边采样数
+static void BM_GerstnerHeight(benchmark::State& state) {
+    const int samples = static_cast<int>(state.range(0));
+    WaveModel waves;
+    float time = 0.0f;
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (int z = 0; z < samples; ++z) {
+            for (int x = 0; x < samples; ++x) {
+                sum += waves.getWaterHeight(x * CELL_SIZE, z * CELL_SIZE, time);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+        time += STEP;
+    }
+    state.SetItemsProcessed(state.iterations() * samples * samples);
+}
+BENCHMARK(BM_GerstnerHeight)->Arg(4)->Arg(80)->Arg(320);
+
+// 同上，按行分给 JobSystem 的所有线程
+static void BM_GerstnerHeightParallel(benchmark::State& state) {
+    startJobSystem();
+    const int samples = static_cast<int>(state.range(0));
+    WaveModel waves;
+    std::vector<float> heights(static_cast<size_t>(samples) * samples);
+    float time = 0.0f;
+    for (auto _ : state) {
+        JobSystem::parallelFor(0, samples, 8, [&](int begin, int end) {
+            for (int z = begin; z < end; ++z) {
+                float* row = heights.data() + static_cast<size_t>(z) * samples;
+                for (int x = 0; x < samples; ++x) {
+                    row[x] = waves.getWaterHeight(x * CELL_SIZE, z * CELL_SIZE, time);
+                }
+            }
+        });
+        benchmark::DoNotOptimize(heights.data());
+        time += STEP;
+    }
+    state.SetItemsProcessed(state.iterations() * samples * samples);
+    state.counters["threads"] = JobSystem::getThreadCount();
+}
+BENCHMARK(BM_GerstnerHeightParallel)->Arg(320)->UseRealTime();
+
+// 同样的采样点走批量接口：参数为每边采样数，第二个参数为 1 时同时输出梯度
+static void BM_GerstnerHeightBatch(benchmark::State& state) {
+    const int samples = static_cast<int>(state.range(0));
+    const bool gradients = state.range(1) != 0;
+    const size_t count = static_cast<size_t>(samples) * samples;
+    WaveModel waves;
+    std::vector<float> xs(count), zs(count), heights(count), gradX(count), gradZ(count);
+    for (int z = 0; z < samples; ++z) {
+        for (int x = 0; x < samples; ++x) {
+            xs[static_cast<size_t>(z) * samples + x] = x * CELL_SIZE;
+            zs[static_cast<size_t>(z) * samples + x] = z * CELL_SIZE;
+        }
+    }
+    float time = 0.0f;
+    for (auto _ : state) {
+        waves.getWaterHeights(xs.data(), zs.data(), heights.data(), gradients ? gradX.data() : nullptr,
+                              gradients ? gradZ.data() : nullptr, count, time);
+        benchmark::DoNotOptimize(heights.data());
+        time += STEP;
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_GerstnerHeightBatch)->Args({4, 0})->Args({80, 0})->Args({320, 0})->Args({320, 1});
+
+// 烘焙一块水面高度场（每个模拟步一次），按行分给 JobSystem 的所有线程
+static void BM_WaveHeightfieldBake(benchmark::State& state) {
+    startJobSystem();
+    WaveModel waves;
+    waves.setHeightfieldEnabled(true);
+    waves.update(0.0f);  // 首次烘焙生成相位表，不计入计时
+    float time = 0.0f;
+    for (auto _ : state) {
+        time += STEP;
+        waves.update(time);
+    }
+    state.SetItemsProcessed(state.iterations() * WaveHeightfield::RESOLUTION * WaveHeightfield::RESOLUTION);
+    state.counters["threads"] = JobSystem::getThreadCount();
+}
+BENCHMARK(BM_WaveHeightfieldBake)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// 从烘焙好的高度场批量查询高度和坡度，与 BM_GerstnerHeightBatch/320/1 对比
+static void BM_WaveHeightfieldQuery(benchmark::State& state) {
+    const int samples = static_cast<int>(state.range(0));
+    const size_t count = static_cast<size_t>(samples) * samples;
+    WaveModel waves;
+    waves.setHeightfieldEnabled(true);
+    waves.update(0.0f);
+    std::vector<float> xs(count), zs(count), heights(count), gradX(count), gradZ(count);
+    for (int z = 0; z < samples; ++z) {
+        for (int x = 0; x < samples; ++x) {
+            xs[static_cast<size_t>(z) * samples + x] = x * CELL_SIZE;
+            zs[static_cast<size_t>(z) * samples + x] = z * CELL_SIZE;
+        }
+    }
+    for (auto _ : state) {
+        waves.getWaterHeights(xs.data(), zs.data(), heights.data(), gradX.data(), gradZ.data(), count, 0.0f);
+        benchmark::DoNotOptimize(heights.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_WaveHeightfieldQuery)->Arg(320);
+
+// 合成一帧 FFT 海面（推进频谱 + 三次二维逆 FFT + 打包位移图 / 坡度图），参数为每边采样数
+static void BM_OceanSpectrumUpdate(benchmark::State& state) {
+    startJobSystem();
+    const int resolution = static_cast<int>(state.range(0));
+    OceanSpectrum ocean(resolution);
+    float time = 0.0f;
+    for (auto _ : state) {
+        time += STEP;
+        ocean.update(time);
+    }
+    state.SetItemsProcessed(state.iterations() * resolution * resolution);
+    state.counters["threads"] = JobSystem::getThreadCount();
+}
+BENCHMARK(BM_OceanSpectrumUpdate)->Arg(64)->Arg(128)->Arg(256)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// 尾流粒子系统：船全速直行，每次迭代模拟 10 秒（600 步），粒子数达到上限后保持稳定
+static void BM_BoatWakeUpdate(benchmark::State& state) {
+    BoatWake wake;
+    wake.setMaxParticles(static_cast<int>(state.range(0)));
+    const glm::vec2 forward(0.0f, 1.0f);
+    for (auto _ : state) {
+        wake.clear();
+        glm::vec3 position(riverCenterX(), 0.0f, 0.0f);
+        for (int step = 0; step < 600; ++step) {
+            position.z += 10.0f * STEP;
+            wake.update(STEP, position, forward, 10.0f);
+        }
+        benchmark::DoNotOptimize(wake.getParticles().data());
+    }
+    state.SetItemsProcessed(state.iterations() * 600);
+}
+BENCHMARK(BM_BoatWakeUpdate)->Arg(20)->Arg(200)->Unit(benchmark::kMicrosecond);
+
+// 船只物理一步：运动、地形/边界/障碍物碰撞、四点浮力采样，参数为障碍物数量
+static void BM_BoatStep(benchmark::State& state) {
+    const TerrainMap& terrain = canalTerrain();
+    WaveModel waves;
+    Boat boat(glm::vec3(riverCenterX(), 0.2f, 0.0f), 0.0f);
+    const float halfX = GRID_SIZE_X * CELL_SIZE * 0.5f;
+    const float halfZ = GRID_SIZE_Z * CELL_SIZE * 0.5f;
+    boat.setBounds(-halfX, halfX, -halfZ, halfZ);
+    boat.setCollisionPredicate(waterPredicate(terrain));
+    scatterObstacles(boat, static_cast<int>(state.range(0)));
+
+    float time = 0.0f;
+    int step = 0;
+    for (auto _ : state) {
+        // 全油门左右蛇行，与场景基准测试的游戏段一致
+        boat.processInput(1.0f, 0.35f * std::sin(time * 1.5f));
+        boat.update(STEP, &waves, time);
+        time += STEP;
+        // 定期回到起点，避免船一直贴着地图边界
+        if (++step % 3600 == 0) {
+            boat.setPosition(glm::vec3(riverCenterX(), 0.2f, 0.0f));
+            boat.setSpeed(0.0f);
+        }
+    }
+    glm::vec3 position = boat.getPosition();
+    benchmark::DoNotOptimize(position);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BoatStep)->Arg(0)->Arg(1000)->Arg(10000);
+
+} // namespace Micro
+} // namespace WaterTown
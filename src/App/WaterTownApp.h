@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../Core/Application.h"
+#include "../Render/UniformBuffers.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace WaterTown {
+
+class Shader;
+class Camera;
+class WaterSurface;
+class SceneEditor;
+class EditorUI;
+class BoatRenderer;
+class TerrainRenderer;
+class ObjectRenderer;
+
+/**
+ * @brief 场景编辑器应用
+ *
+ * 编辑器可执行文件和基准测试共用同一个场景：基准测试从这里派生，
+ * 替换输入部分，渲染路径保持完全一致。
+ */
+class WaterTownApp : public Application {
+public:
+    WaterTownApp();
+
+    /**
+     * @param headless 无显示模式（见 Window）
+     */
+    WaterTownApp(int width, int height, const char* title, bool headless);
+
+protected:
+    void onInit() override;
+    void onUpdate(float deltaTime) override;
+    void onFixedUpdate(float fixedDeltaTime) override;
+    void onRender() override;
+    void onImGui() override;
+    void onShutdown() override;
+
+    Shader* m_shader = nullptr;
+    Shader* m_waterShader = nullptr;
+    Shader* m_skyShader = nullptr;
+    Shader* m_cloudShader = nullptr;
+    WaterSurface* m_waterSurface = nullptr;
+    SceneEditor* m_sceneEditor = nullptr;
+    EditorUI* m_editorUI = nullptr;
+    BoatRenderer* m_boatRenderer = nullptr;
+    TerrainRenderer* m_terrainRenderer = nullptr;
+    ObjectRenderer* m_objectRenderer = nullptr;
+    UniformBuffers* m_uniformBuffers = nullptr;
+    WaveUniforms m_waveUniforms = {};
+    Camera* m_camera = nullptr;  // 指向当前相机（由 SceneEditor 管理）
+
+private:
+    unsigned int m_cubeVAO = 0;
+    unsigned int m_cubeVBO = 0;
+
+    unsigned int m_cloudVAO = 0;
+    unsigned int m_cloudVBO = 0;
+
+    struct CloudInstance {
+        glm::vec2 offsetXZ;
+        float height;
+        float size;
+        float alpha;
+        glm::vec2 velocityXZ;
+    };
+    std::vector<CloudInstance> m_clouds;
+
+    bool m_firstMouse = true;
+    float m_lastX = 640.0f;
+    float m_lastY = 360.0f;
+    bool m_mouseCaptured = false;
+
+    void createCubeData();
+    void createCloudQuad();
+    void initClouds();
+    void updateClouds(float deltaTime);
+};
+
+} // namespace WaterTown
@@ -1,26 +1,45 @@
 #include "Application.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "../Render/GLState.h"
+#include "../Render/GLCounters.h"
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace WaterTown {
 
-Application::Application(int width, int height, const char* title)
-    : m_lastFrameTime(0.0f) {
+Application::Application(int width, int height, const char* title, bool headless)
+    : m_lastFrameTime(0.0f), m_fixedFrameTime(0.0f),
+      m_fixedDeltaTime(1.0f / 60.0f), m_maxSimulationSteps(5),
+      m_accumulator(0.0f), m_simulationTime(0.0), m_interpolationAlpha(0.0f) {
     
-    // 创建窗口
-    m_window = std::make_unique<Window>(width, height, title);
+    // 创建窗口（没有显示设备时抛出异常，此时还没有启动任何线程）
+    m_window = std::make_unique<Window>(width, height, title, headless);
     
     // 初始化 ImGui
     initImGui();
     
+    // 工作线程在场景初始化（onInit）之前启动，加载时的网格生成也能并行
+    JobSystem::initialize();
+    
     std::cout << "Application initialized successfully!" << std::endl;
 }
 
+void Application::setSimulationRate(float hz) {
+    if (hz <= 0.0f) return;
+    m_fixedDeltaTime = 1.0f / hz;
+    m_accumulator = std::min(m_accumulator, m_fixedDeltaTime);
+}
+
 Application::~Application() {
     onShutdown();
+    Profiler::shutdown();
     shutdownImGui();
+    JobSystem::shutdown();
 }
 
 void Application::run() {
@@ -29,38 +48,83 @@ void Application::run() {
     
     std::cout << "Entering main loop..." << std::endl;
     
+    // 从现在开始计时，加载耗时不计入第一帧
+    m_lastFrameTime = static_cast<float>(glfwGetTime());
+    
     // 主循环
     while (!m_window->shouldClose()) {
+        // 归档上一帧的 GL 状态切换、绘制统计与计时
+        GLState::beginFrame();
+        GLCounters::beginFrame();
+        Profiler::beginFrame();
+        
         // 计算帧间隔时间
         float currentTime = static_cast<float>(glfwGetTime());
         float deltaTime = currentTime - m_lastFrameTime;
         m_lastFrameTime = currentTime;
+        deltaTime = std::min(std::max(deltaTime, 0.0f), MAX_FRAME_DELTA);
+        if (m_fixedFrameTime > 0.0f) {
+            deltaTime = m_fixedFrameTime;
+        }
         
-        // 更新逻辑
-        onUpdate(deltaTime);
-        
-        // 清空屏幕
-        glClearColor(0.2f, 0.3f, 0.4f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        
-        // 渲染场景
-        onRender();
+        // 输入和视觉效果按帧更新
+        {
+            PROFILE_SCOPE("Update");
+            onUpdate(deltaTime);
+        }
         
-        // 启动 ImGui 帧
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
+        // 模拟按固定步长推进，卡顿时最多追 m_maxSimulationSteps 步
+        m_accumulator += deltaTime;
+        int steps = 0;
+        while (m_accumulator >= m_fixedDeltaTime && steps < m_maxSimulationSteps) {
+            PROFILE_SCOPE("FixedUpdate");
+            onFixedUpdate(m_fixedDeltaTime);
+            m_simulationTime += m_fixedDeltaTime;
+            m_accumulator -= m_fixedDeltaTime;
+            ++steps;
+        }
+        if (m_accumulator >= m_fixedDeltaTime) {
+            // 追不上的部分直接丢弃，避免越积越多
+            m_accumulator = std::fmod(m_accumulator, m_fixedDeltaTime);
+        }
+        m_interpolationAlpha = m_accumulator / m_fixedDeltaTime;
         
-        // 调用派生类的 ImGui 方法
-        onImGui();
+        {
+            PROFILE_GPU_SCOPE("Render");
+            
+            // 清空屏幕
+            glClearColor(0.2f, 0.3f, 0.4f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            
+            // 渲染场景
+            onRender();
+        }
         
-        // 渲染 ImGui
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            PROFILE_GPU_SCOPE("ImGui");
+            
+            // 启动 ImGui 帧
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            ImGui::NewFrame();
+            
+            // 调用派生类的 ImGui 方法
+            onImGui();
+            
+            // 渲染 ImGui
+            ImGui::Render();
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            // ImGui 后端直接调用 GL，之后状态缓存不再可信
+            GLState::invalidate();
+        }
         
         // 交换缓冲区并处理事件
-        m_window->swapBuffers();
+        {
+            PROFILE_SCOPE("SwapBuffers");
+            m_window->swapBuffers();
+        }
         m_window->pollEvents();
+        Profiler::endFrame();
     }
     
     std::cout << "Exiting main loop." << std::endl;
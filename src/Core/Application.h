@@ -7,6 +7,12 @@ namespace WaterTown {
 
 /**
  * @brief 应用程序基类，使用模板方法模式管理程序生命周期
+ *
+ * 每帧先调用 onUpdate（输入和纯视觉效果），再按固定步长累积调用 onFixedUpdate（模拟），
+ * 最后调用 onRender。渲染时用 getInterpolationAlpha 在最近两个模拟状态之间插值。
+ *
+ * 时间约定：每个模拟状态对应其所在步结束时的模拟时钟，因此最新状态的时刻是
+ * getSimulationTime()，渲染插值出的状态（以及着色器时间）是 getRenderTime()。
  */
 class Application {
 public:
@@ -15,8 +21,9 @@ public:
      * @param width 窗口宽度
      * @param height 窗口高度
      * @param title 窗口标题
+     * @param headless 无显示模式（见 Window）
      */
-    Application(int width, int height, const char* title);
+    Application(int width, int height, const char* title, bool headless = false);
     
     /**
      * @brief 虚析构函数
@@ -27,6 +34,25 @@ public:
      * @brief 运行应用程序主循环
      */
     void run();
+    
+    /**
+     * @brief 设置模拟频率（Hz），例如 60 或 120
+     */
+    void setSimulationRate(float hz);
+    float getSimulationRate() const { return 1.0f / m_fixedDeltaTime; }
+    
+    /**
+     * @brief 设置每帧最多执行的模拟步数（卡顿后丢弃多余的积压时间）
+     */
+    void setMaxSimulationSteps(int steps) { m_maxSimulationSteps = steps > 0 ? steps : 1; }
+    int getMaxSimulationSteps() const { return m_maxSimulationSteps; }
+    
+    /**
+     * @brief 固定每帧的时间增量（秒），传 0 恢复使用真实时钟
+     *
+     * 基准测试用：每帧推进相同的时间，不同机器上跑过的场景内容完全一致。
+     */
+    void setFixedFrameTime(float seconds) { m_fixedFrameTime = seconds > 0.0f ? seconds : 0.0f; }
 
 protected:
     /**
@@ -41,6 +67,15 @@ protected:
      */
     virtual void onUpdate(float deltaTime) {}
     
+    /**
+     * @brief 固定步长模拟（派生类重写）
+     * @param fixedDeltaTime 模拟步长（秒），每次调用都相同
+     *
+     * 调用前模拟时钟尚未前进，getSimulationTime() 为本步开始的时刻，
+     * 本步产生的状态属于 getSimulationTime() + fixedDeltaTime。
+     */
+    virtual void onFixedUpdate(float /*fixedDeltaTime*/) {}
+    
     /**
      * @brief 渲染逻辑（派生类重写）
      * 在此方法中执行 OpenGL 绘制调用
@@ -64,10 +99,40 @@ protected:
      * @return 窗口指针
      */
     Window* getWindow() const { return m_window.get(); }
+    
+    /**
+     * @brief 模拟时钟（秒），只随 onFixedUpdate 前进
+     */
+    double getSimulationTime() const { return m_simulationTime; }
+    
+    /**
+     * @brief 当前帧在上一个和下一个模拟状态之间的位置 [0, 1)
+     */
+    float getInterpolationAlpha() const { return m_interpolationAlpha; }
+    
+    /**
+     * @brief 渲染用的时间：插值状态所在的时刻，即上一个状态的时刻加上插值部分
+     *
+     * 渲染在最近两个状态之间插值，比最新状态晚 (1 - alpha) 个步长。
+     */
+    float getRenderTime() const {
+        return static_cast<float>(m_simulationTime - (1.0f - m_interpolationAlpha) * m_fixedDeltaTime);
+    }
+    
+    float getFixedDeltaTime() const { return m_fixedDeltaTime; }
 
 private:
     std::unique_ptr<Window> m_window;
     float m_lastFrameTime;
+    float m_fixedFrameTime;
+    
+    // 固定步长模拟
+    static constexpr float MAX_FRAME_DELTA = 0.25f;  // 单帧最多计入的时间（调试断点、窗口拖动等）
+    float m_fixedDeltaTime;
+    int m_maxSimulationSteps;
+    float m_accumulator;
+    double m_simulationTime;
+    float m_interpolationAlpha;
     
     /**
      * @brief 初始化 ImGui
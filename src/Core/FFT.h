@@ -0,0 +1,43 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief N x N 复数二维 FFT（基 2，N 为 2 的幂）
+ *
+ * 先对所有行、再对所有列做一维变换，两步都按行 / 列分给 JobSystem。
+ * 只提供不归一化的逆变换 f(x) = Σ F(k)·e^{+2πi k·x / N}，即由频谱合成空间场所需的方向。
+ * 频率下标按 FFT 的常规顺序：k < N/2 为正频率，其余为 k - N。
+ */
+class FFT2D {
+public:
+    /**
+     * @param size 每边点数（2 的幂）
+     */
+    explicit FFT2D(int size);
+
+    int getSize() const { return m_size; }
+
+    /**
+     * @brief 原地逆变换（size * size 个元素，按行存储）
+     */
+    void inverse(std::complex<float>* data) const;
+
+private:
+    static constexpr int JOB_GRAIN = 8;  // 每个作业处理的行 / 列数
+
+    /**
+     * @brief 对连续存储的 size 个元素做一维逆变换
+     */
+    void transform(std::complex<float>* data) const;
+
+    int m_size;
+    std::vector<uint32_t> m_bitReverse;
+    std::vector<std::complex<float>> m_twiddles;  // e^{+2πi j / N}，j < N/2
+};
+
+} // namespace WaterTown
@@ -0,0 +1,206 @@
+#include "JobSystem.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <thread>
+
+namespace WaterTown {
+
+namespace {
+
+/**
+ * @brief 每个线程一个的双端队列（所有者在队尾存取，窃取者从队首拿）
+ */
+struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+};
+
+std::vector<std::unique_ptr<WorkerQueue>> g_queues;  // 下标即线程编号
+std::atomic<bool> g_running(false);
+std::atomic<int> g_queuedJobs(0);  // 所有队列中的作业总数（不含等待依赖的）
+std::mutex g_sleepMutex;
+std::condition_variable g_wake;
+
+/**
+ * @brief 工作线程的所有者
+ *
+ * 调用方忘记 shutdown（或异常跳过了它）时，在静态析构阶段由析构函数通知并 join 工作线程，
+ * 否则 std::thread 析构时仍可 join 会调用 std::terminate。
+ * 必须定义在上面的全局对象之后，保证先于它们析构。
+ */
+struct WorkerThreads {
+    std::vector<std::thread> threads;
+    ~WorkerThreads() { JobSystem::shutdown(); }
+};
+WorkerThreads g_workers;
+
+thread_local int t_threadIndex = 0;
+
+bool takeJob(WorkerQueue& queue, bool fromBack, Job& out) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) {
+        return false;
+    }
+    if (fromBack) {
+        out = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+    } else {
+        out = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+    }
+    g_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace
+
+void JobSystem::initialize(int workerCount) {
+    if (g_running) {
+        return;
+    }
+    if (workerCount < 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? static_cast<int>(hardwareThreads) - 1 : 0;
+    }
+    // 没有工作线程时保持未运行状态，所有作业在调用线程上直接执行
+    if (workerCount == 0) {
+        return;
+    }
+
+    g_queues.clear();
+    for (int i = 0; i <= workerCount; ++i) {
+        g_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    t_threadIndex = 0;
+    g_running = true;
+    for (int i = 1; i <= workerCount; ++i) {
+        g_workers.threads.emplace_back(&JobSystem::workerLoop, i);
+    }
+}
+
+void JobSystem::shutdown() {
+    if (!g_running) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_sleepMutex);
+        g_running = false;
+    }
+    g_wake.notify_all();
+    for (std::thread& thread : g_workers.threads) {
+        thread.join();
+    }
+    g_workers.threads.clear();
+    g_queues.clear();
+    g_queuedJobs = 0;
+}
+
+bool JobSystem::isRunning() {
+    return g_running.load(std::memory_order_acquire);
+}
+
+int JobSystem::getThreadCount() {
+    return g_queues.empty() ? 1 : static_cast<int>(g_queues.size());
+}
+
+int JobSystem::currentThreadIndex() {
+    return t_threadIndex;
+}
+
+void JobSystem::run(std::function<void()> function, JobCounter* counter, JobCounter* dependency) {
+    if (counter) {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    Job job{std::move(function), counter};
+
+    if (!isRunning()) {
+        job.function();
+        if (counter) complete(counter);
+        return;
+    }
+
+    // 依赖未完成时挂到依赖的计数器上，由最后一个完成的作业负责调度
+    if (dependency) {
+        std::lock_guard<std::mutex> lock(dependency->m_mutex);
+        if (!dependency->isDone()) {
+            dependency->m_continuations.push_back(std::move(job));
+            return;
+        }
+    }
+    schedule(std::move(job));
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (!runPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+    // 完成最后一个作业的线程可能还没释放计数器的锁，拿一次锁确保它已离开，调用方随后才能销毁计数器
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::schedule(Job&& job) {
+    WorkerQueue& queue = *g_queues[t_threadIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    g_queuedJobs.fetch_add(1, std::memory_order_release);
+    // 经过一次睡眠锁，避免工作线程检查完条件、尚未开始等待时错过通知
+    { std::lock_guard<std::mutex> lock(g_sleepMutex); }
+    g_wake.notify_one();
+}
+
+bool JobSystem::runPendingJob() {
+    if (g_queuedJobs.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    const int index = t_threadIndex;
+    const int count = static_cast<int>(g_queues.size());
+    Job job;
+    bool found = takeJob(*g_queues[index], true, job);
+    for (int i = 1; i < count && !found; ++i) {
+        found = takeJob(*g_queues[(index + i) % count], false, job);
+    }
+    if (!found) {
+        return false;
+    }
+
+    job.function();
+    if (job.counter) {
+        complete(job.counter);
+    }
+    return true;
+}
+
+void JobSystem::complete(JobCounter* counter) {
+    std::vector<Job> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_mutex);
+        if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            ready.swap(counter->m_continuations);
+        }
+    }
+    // 解锁之后不再访问计数器（等待方可能已经销毁它）
+    for (Job& job : ready) {
+        schedule(std::move(job));
+    }
+}
+
+void JobSystem::workerLoop(int index) {
+    t_threadIndex = index;
+    while (g_running.load(std::memory_order_acquire)) {
+        if (runPendingJob()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(g_sleepMutex);
+        g_wake.wait(lock, [] {
+            return !g_running.load(std::memory_order_acquire) || g_queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+} // namespace WaterTown
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace WaterTown {
+
+class JobCounter;
+
+/**
+ * @brief 一个待执行的作业
+ */
+struct Job {
+    std::function<void()> function;
+    JobCounter* counter;  // 完成时递减（可为空）
+};
+
+/**
+ * @brief 作业计数器
+ *
+ * 提交时加一、作业完成时减一，归零表示这一组作业全部完成。
+ * 同时用作依赖：依赖某个计数器的作业在它归零之后才进入队列。
+ * 计数器必须活到 JobSystem::wait 返回为止（通常放在调用方的栈上）。
+ */
+class JobCounter {
+public:
+    JobCounter() : m_pending(0) {}
+
+    // 禁止拷贝（作业持有指针）
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> m_pending;
+    std::mutex m_mutex;               // 保护 m_continuations 以及归零的瞬间
+    std::vector<Job> m_continuations; // 等待本计数器归零的作业
+};
+
+/**
+ * @brief 工作窃取作业系统
+ *
+ * 固定数量的工作线程，每个线程（含主线程，编号 0）各有一个双端队列：
+ * 自己从队尾取（后进先出，缓存更热），空闲时从其他线程的队首窃取。
+ * 等待计数器的线程不会阻塞，而是一边等一边执行队列里的作业，因此作业内部可以再次并行。
+ *
+ * 作业里只能做 CPU 工作：GL 调用、Profiler 区间和 ImGui 必须留在主线程。
+ * 未初始化时 run 直接在调用线程上执行，parallelFor 退化为普通循环。
+ */
+class JobSystem {
+public:
+    /**
+     * @brief 启动工作线程
+     * @param workerCount 工作线程数，< 0 表示硬件线程数 - 1（主线程也参与执行）
+     */
+    static void initialize(int workerCount = -1);
+
+    /**
+     * @brief 等待所有工作线程退出（队列中剩余的作业会被丢弃）
+     *
+     * 进程退出时若仍在运行，会在静态析构阶段自动调用。
+     */
+    static void shutdown();
+
+    static bool isRunning();
+
+    /**
+     * @brief 参与执行作业的线程数（工作线程 + 主线程），至少为 1
+     */
+    static int getThreadCount();
+
+    /**
+     * @brief 当前线程编号：主线程为 0，工作线程为 1..N
+     *
+     * 用于索引每线程一份的临时缓冲，因此只有主线程和工作线程可以提交并等待作业。
+     */
+    static int currentThreadIndex();
+
+    /**
+     * @brief 提交作业
+     * @param function 作业内容
+     * @param counter 完成时递减的计数器（可为空）
+     * @param dependency 依赖的计数器，归零后作业才会被调度（可为空）
+     */
+    static void run(std::function<void()> function, JobCounter* counter = nullptr,
+                    JobCounter* dependency = nullptr);
+
+    /**
+     * @brief 等待计数器归零，等待期间当前线程帮忙执行作业
+     */
+    static void wait(JobCounter& counter);
+
+    /**
+     * @brief 把 [begin, end) 按 grainSize 切块并行执行 fn(rangeBegin, rangeEnd)，返回时全部完成
+     *
+     * 区间不超过一块时直接在当前线程执行，不产生调度开销。
+     */
+    template <typename Fn>
+    static void parallelFor(int begin, int end, int grainSize, const Fn& fn) {
+        if (end <= begin) return;
+        grainSize = std::max(grainSize, 1);
+        if (!isRunning() || end - begin <= grainSize) {
+            fn(begin, end);
+            return;
+        }
+        JobCounter counter;
+        for (int start = begin; start < end; start += grainSize) {
+            const int stop = std::min(start + grainSize, end);
+            run([&fn, start, stop]() { fn(start, stop); }, &counter);
+        }
+        wait(counter);
+    }
+
+private:
+    /**
+     * @brief 把就绪的作业放进当前线程的队列
+     */
+    static void schedule(Job&& job);
+
+    /**
+     * @brief 取一个作业执行（先取自己的，再窃取别人的），没有作业时返回 false
+     */
+    static bool runPendingJob();
+
+    /**
+     * @brief 作业完成：递减计数器，归零时调度等待它的作业
+     */
+    static void complete(JobCounter* counter);
+
+    static void workerLoop(int index);
+};
+
+} // namespace WaterTown
@@ -0,0 +1,344 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace WaterTown {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief 一个 GPU 区间的两个时间戳查询
+ */
+struct GpuRange {
+    const char* name;
+    int depth;
+    GLuint beginQuery;
+    GLuint endQuery;
+};
+
+/**
+ * @brief 等待 GPU 结果的一帧
+ */
+struct FrameSlot {
+    ProfileFrame frame;
+    std::vector<GpuRange> ranges;
+    bool pending = false;
+};
+
+struct ProfilerState {
+    bool enabled = true;
+    uint64_t frameIndex = 0;
+    Clock::time_point epoch = Clock::now();
+
+    FrameSlot slots[Profiler::FRAME_LATENCY];
+    FrameSlot* current = nullptr;
+    std::vector<size_t> cpuStack;  // 打开的 CPU 区间（cpuEvents 下标）
+    std::vector<size_t> gpuStack;  // 打开的 GPU 区间（ranges 下标）
+    std::vector<GLuint> freeQueries;
+    std::vector<GLuint> allQueries;
+
+    ProfileFrame lastFrame;
+
+    int captureRemaining = 0;
+    std::string capturePath;
+    std::vector<ProfileFrame> captured;
+};
+
+ProfilerState& state() {
+    static ProfilerState s;
+    return s;
+}
+
+double nowMs() {
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - state().epoch;
+    return elapsed.count();
+}
+
+bool hasDebugGroups() {
+    return GLAD_GL_KHR_debug || GLAD_GL_VERSION_4_3;
+}
+
+GLuint acquireQuery() {
+    ProfilerState& s = state();
+    if (s.freeQueries.empty()) {
+        // 按块分配，避免每帧调用 glGenQueries
+        GLuint block[32];
+        glGenQueries(32, block);
+        s.freeQueries.insert(s.freeQueries.end(), block, block + 32);
+        s.allQueries.insert(s.allQueries.end(), block, block + 32);
+    }
+    GLuint query = s.freeQueries.back();
+    s.freeQueries.pop_back();
+    return query;
+}
+
+void releaseRanges(FrameSlot& slot) {
+    ProfilerState& s = state();
+    for (const GpuRange& range : slot.ranges) {
+        s.freeQueries.push_back(range.beginQuery);
+        s.freeQueries.push_back(range.endQuery);
+    }
+    slot.ranges.clear();
+}
+
+/**
+ * @brief 读取一帧的 GPU 时间戳；结果尚未就绪时放弃该帧的 GPU 数据（不阻塞）
+ */
+void resolveGpu(FrameSlot& slot) {
+    ProfileFrame& frame = slot.frame;
+    frame.gpuEvents.clear();
+    frame.hasGpu = false;
+    frame.gpuMs = 0.0;
+
+    bool available = !slot.ranges.empty();
+    for (const GpuRange& range : slot.ranges) {
+        GLuint ready = GL_FALSE;
+        glGetQueryObjectuiv(range.endQuery, GL_QUERY_RESULT_AVAILABLE, &ready);
+        if (!ready) {
+            available = false;
+            break;
+        }
+    }
+
+    if (available) {
+        GLuint64 origin = ~GLuint64(0);
+        GLuint64 last = 0;
+        std::vector<GLuint64> stamps(slot.ranges.size() * 2);
+        for (size_t i = 0; i < slot.ranges.size(); ++i) {
+            glGetQueryObjectui64v(slot.ranges[i].beginQuery, GL_QUERY_RESULT, &stamps[i * 2]);
+            glGetQueryObjectui64v(slot.ranges[i].endQuery, GL_QUERY_RESULT, &stamps[i * 2 + 1]);
+            origin = std::min(origin, stamps[i * 2]);
+            last = std::max(last, stamps[i * 2 + 1]);
+        }
+
+        frame.gpuEvents.reserve(slot.ranges.size());
+        for (size_t i = 0; i < slot.ranges.size(); ++i) {
+            GLuint64 begin = stamps[i * 2];
+            GLuint64 end = std::max(stamps[i * 2 + 1], begin);
+            frame.gpuEvents.push_back({slot.ranges[i].name,
+                                       static_cast<double>(begin - origin) * 1e-6,
+                                       static_cast<double>(end - begin) * 1e-6,
+                                       slot.ranges[i].depth});
+        }
+        frame.gpuMs = static_cast<double>(last - origin) * 1e-6;
+        frame.hasGpu = true;
+    }
+
+    releaseRanges(slot);
+}
+
+void publishFrame(FrameSlot& slot) {
+    ProfilerState& s = state();
+    resolveGpu(slot);
+    slot.pending = false;
+
+    // 交换而不是拷贝，槽位保留旧容量供下一帧复用
+    std::swap(s.lastFrame, slot.frame);
+
+    if (s.captureRemaining > 0) {
+        s.captured.push_back(s.lastFrame);
+        if (--s.captureRemaining == 0) {
+            if (Profiler::writeChromeTrace(s.captured, s.capturePath)) {
+                std::cout << "Profiler: wrote " << s.captured.size() << " frames to " << s.capturePath << std::endl;
+            }
+            s.captured.clear();
+        }
+    }
+}
+
+void appendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out += '\\';
+        out += *c;
+    }
+    out += '"';
+}
+
+void appendTraceEvent(std::string& out, const ProfileEvent& event, double frameStartMs, int tid, bool& first) {
+    char numbers[128];
+    std::snprintf(numbers, sizeof(numbers), ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                  tid, (frameStartMs + event.startMs) * 1000.0, event.durationMs * 1000.0);
+    out += first ? "\n" : ",\n";
+    first = false;
+    out += "{\"name\":";
+    appendJsonString(out, event.name);
+    out += numbers;
+}
+
+} // namespace
+
+void Profiler::setEnabled(bool enabled) {
+    ProfilerState& s = state();
+    if (s.enabled == enabled) return;
+    s.enabled = enabled;
+    if (!enabled) {
+        // 丢弃还没读回的帧
+        for (FrameSlot& slot : s.slots) {
+            releaseRanges(slot);
+            slot.pending = false;
+        }
+        s.current = nullptr;
+        s.cpuStack.clear();
+        s.gpuStack.clear();
+    }
+}
+
+bool Profiler::isEnabled() {
+    return state().enabled;
+}
+
+void Profiler::beginFrame() {
+    ProfilerState& s = state();
+    if (!s.enabled) return;
+
+    FrameSlot& slot = s.slots[s.frameIndex % FRAME_LATENCY];
+    if (slot.pending) {
+        publishFrame(slot);
+    }
+
+    slot.frame.index = s.frameIndex;
+    slot.frame.startMs = nowMs();
+    slot.frame.cpuMs = 0.0;
+    slot.frame.cpuEvents.clear();
+    slot.frame.gpuEvents.clear();
+    slot.ranges.clear();
+    s.current = &slot;
+    s.cpuStack.clear();
+    s.gpuStack.clear();
+}
+
+void Profiler::endFrame() {
+    ProfilerState& s = state();
+    if (!s.current) return;
+
+    // 未关闭的区间截止到帧末
+    while (!s.cpuStack.empty()) popCpu();
+    while (!s.gpuStack.empty()) popGpu();
+
+    s.current->frame.cpuMs = nowMs() - s.current->frame.startMs;
+    s.current->pending = true;
+    s.current = nullptr;
+    ++s.frameIndex;
+}
+
+void Profiler::pushCpu(const char* name) {
+    ProfilerState& s = state();
+    if (!s.current) return;
+    ProfileFrame& frame = s.current->frame;
+    s.cpuStack.push_back(frame.cpuEvents.size());
+    frame.cpuEvents.push_back({name, nowMs() - frame.startMs, 0.0, static_cast<int>(s.cpuStack.size()) - 1});
+}
+
+void Profiler::popCpu() {
+    ProfilerState& s = state();
+    if (!s.current || s.cpuStack.empty()) return;
+    ProfileFrame& frame = s.current->frame;
+    ProfileEvent& event = frame.cpuEvents[s.cpuStack.back()];
+    s.cpuStack.pop_back();
+    event.durationMs = (nowMs() - frame.startMs) - event.startMs;
+}
+
+void Profiler::pushGpu(const char* name) {
+    ProfilerState& s = state();
+    if (!s.current) return;
+
+    if (hasDebugGroups()) {
+        glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+    }
+
+    GpuRange range;
+    range.name = name;
+    range.depth = static_cast<int>(s.gpuStack.size());
+    range.beginQuery = acquireQuery();
+    range.endQuery = acquireQuery();
+    glQueryCounter(range.beginQuery, GL_TIMESTAMP);
+
+    s.gpuStack.push_back(s.current->ranges.size());
+    s.current->ranges.push_back(range);
+}
+
+void Profiler::popGpu() {
+    ProfilerState& s = state();
+    if (!s.current || s.gpuStack.empty()) return;
+
+    const GpuRange& range = s.current->ranges[s.gpuStack.back()];
+    s.gpuStack.pop_back();
+    glQueryCounter(range.endQuery, GL_TIMESTAMP);
+
+    if (hasDebugGroups()) {
+        glPopDebugGroup();
+    }
+}
+
+const ProfileFrame& Profiler::getLastFrame() {
+    return state().lastFrame;
+}
+
+void Profiler::requestCapture(int frameCount, const std::string& path) {
+    ProfilerState& s = state();
+    s.captured.clear();
+    s.captured.reserve(static_cast<size_t>(std::max(frameCount, 0)));
+    s.captureRemaining = std::max(frameCount, 0);
+    s.capturePath = path;
+}
+
+bool Profiler::isCapturing() {
+    return state().captureRemaining > 0;
+}
+
+int Profiler::getCaptureRemaining() {
+    return state().captureRemaining;
+}
+
+bool Profiler::writeChromeTrace(const std::vector<ProfileFrame>& frames, const std::string& path) {
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+
+    // 线程名：tid 1 为 CPU，tid 2 为 GPU
+    out += "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}}";
+    out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+    first = false;
+
+    for (const ProfileFrame& frame : frames) {
+        ProfileEvent frameEvent = {"Frame", 0.0, frame.cpuMs, -1};
+        appendTraceEvent(out, frameEvent, frame.startMs, 1, first);
+        for (const ProfileEvent& event : frame.cpuEvents) {
+            appendTraceEvent(out, event, frame.startMs, 1, first);
+        }
+        // GPU 时钟与 CPU 时钟不同源，这里把每帧第一个 GPU 时间戳对齐到该帧 CPU 开始时刻
+        for (const ProfileEvent& event : frame.gpuEvents) {
+            appendTraceEvent(out, event, frame.startMs, 2, first);
+        }
+    }
+    out += "\n]}\n";
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Profiler: failed to open trace file: " << path << std::endl;
+        return false;
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+void Profiler::shutdown() {
+    ProfilerState& s = state();
+    for (FrameSlot& slot : s.slots) {
+        slot.ranges.clear();
+        slot.pending = false;
+    }
+    if (!s.allQueries.empty()) {
+        glDeleteQueries(static_cast<GLsizei>(s.allQueries.size()), s.allQueries.data());
+    }
+    s.allQueries.clear();
+    s.freeQueries.clear();
+    s.current = nullptr;
+}
+
+} // namespace WaterTown
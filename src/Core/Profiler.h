@@ -0,0 +1,131 @@
+#pragma once
+
+#include <glad/glad.h>
+#include "../Render/GLCounters.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 一段计时区间
+ */
+struct ProfileEvent {
+    const char* name;   // 区间名（必须是静态字符串）
+    double startMs;     // 相对所在帧开始的时间
+    double durationMs;
+    int depth;          // 嵌套深度，0 为最外层
+};
+
+/**
+ * @brief 一帧的计时结果
+ */
+struct ProfileFrame {
+    uint64_t index = 0;
+    double startMs = 0.0;   // 相对 Profiler 启动的 CPU 时间
+    double cpuMs = 0.0;     // beginFrame 到 endFrame 的耗时
+    double gpuMs = 0.0;     // 第一个 GPU 区间开始到最后一个结束
+    bool hasGpu = false;    // GPU 结果是否有效
+    std::vector<ProfileEvent> cpuEvents;
+    std::vector<ProfileEvent> gpuEvents;  // 时间以本帧第一个 GPU 时间戳为零点
+};
+
+/**
+ * @brief 分层 CPU/GPU 帧性能分析器
+ *
+ * - CPU 区间用 steady_clock 计时，可以任意嵌套。
+ * - GPU 区间在开始和结束处各插入一个 GL_TIMESTAMP 查询（GL_TIME_ELAPSED 不能嵌套），
+ *   同时用 KHR_debug 推入调试组，RenderDoc / Nsight 中能看到相同的层级。
+ * - 查询结果延迟 FRAME_LATENCY 帧读取，不会让 CPU 等待 GPU。
+ *
+ * 因此 getLastFrame() 返回的是几帧之前已经完整的一帧。
+ * 捕获若干帧后可导出 Chrome trace JSON（chrome://tracing 或 Perfetto 打开）。
+ */
+class Profiler {
+public:
+    static constexpr int FRAME_LATENCY = 3;
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * @brief 帧边界（由 Application 主循环调用）
+     */
+    static void beginFrame();
+    static void endFrame();
+
+    /**
+     * @brief CPU 区间（请使用 PROFILE_SCOPE）
+     */
+    static void pushCpu(const char* name);
+    static void popCpu();
+
+    /**
+     * @brief GPU 区间与调试组（请使用 PROFILE_GPU_SCOPE，需要当前 GL 上下文）
+     */
+    static void pushGpu(const char* name);
+    static void popGpu();
+
+    /**
+     * @brief 最近一帧完整的结果
+     */
+    static const ProfileFrame& getLastFrame();
+
+    /**
+     * @brief 捕获接下来完成的 frameCount 帧，结束后写入 path
+     */
+    static void requestCapture(int frameCount, const std::string& path);
+    static bool isCapturing();
+    static int getCaptureRemaining();
+
+    /**
+     * @brief 把若干帧写成 Chrome trace JSON
+     */
+    static bool writeChromeTrace(const std::vector<ProfileFrame>& frames, const std::string& path);
+
+    /**
+     * @brief 释放查询对象（GL 上下文销毁前调用）
+     */
+    static void shutdown();
+};
+
+/**
+ * @brief 作用域计时（构造时开始，析构时结束）
+ *
+ * GPU 区间同时作为 GLCounters 的 pass，绘制和上传统计按它细分。
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name, bool gpu = false) : m_gpu(gpu) {
+        Profiler::pushCpu(name);
+        if (m_gpu) {
+            Profiler::pushGpu(name);
+            GLCounters::pushPass(name);
+        }
+    }
+
+    ~ProfileScope() {
+        if (m_gpu) {
+            GLCounters::popPass();
+            Profiler::popGpu();
+        }
+        Profiler::popCpu();
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    bool m_gpu;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// CPU 区间
+#define PROFILE_SCOPE(name) ::WaterTown::ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+// CPU + GPU 区间（渲染 pass 使用）
+#define PROFILE_GPU_SCOPE(name) ::WaterTown::ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name, true)
+
+} // namespace WaterTown
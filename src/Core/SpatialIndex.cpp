@@ -0,0 +1,242 @@
+#include "SpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace WaterTown {
+
+SpatialIndex::SpatialIndex(float bucketSize)
+    : m_bucketSize(bucketSize > 0.0f ? bucketSize : 8.0f),
+      m_maxRadius(0.0f), m_minY(0.0f), m_maxY(0.0f) {
+}
+
+int SpatialIndex::bucketCoord(float v) const {
+    return static_cast<int>(std::floor(v / m_bucketSize));
+}
+
+int64_t SpatialIndex::bucketKey(int bx, int bz) {
+    // 在无符号数上拼接，负的桶坐标左移是未定义行为
+    const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(bx)) << 32) | static_cast<uint32_t>(bz);
+    return static_cast<int64_t>(key);
+}
+
+void SpatialIndex::bucketCoords(int64_t key, int& bx, int& bz) {
+    const uint64_t bits = static_cast<uint64_t>(key);
+    bx = static_cast<int32_t>(static_cast<uint32_t>(bits >> 32));
+    bz = static_cast<int32_t>(static_cast<uint32_t>(bits));
+}
+
+SpatialHandle SpatialIndex::insert(const glm::vec3& position, float radius, uint32_t value) {
+    SpatialHandle handle;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    } else {
+        handle = static_cast<SpatialHandle>(m_entries.size());
+        m_entries.push_back(Entry());
+    }
+
+    if (size() == 1) {
+        m_minY = m_maxY = position.y;
+    }
+
+    Entry& entry = m_entries[handle];
+    entry.position = position;
+    entry.radius = radius;
+    entry.value = value;
+    entry.alive = true;
+    addToBucket(handle);
+
+    m_maxRadius = std::max(m_maxRadius, radius);
+    return handle;
+}
+
+void SpatialIndex::update(SpatialHandle handle, const glm::vec3& position) {
+    if (handle >= m_entries.size() || !m_entries[handle].alive) return;
+
+    Entry& entry = m_entries[handle];
+    int64_t newBucket = bucketKey(bucketCoord(position.x), bucketCoord(position.z));
+    if (newBucket == entry.bucket) {
+        entry.position = position;
+        m_minY = std::min(m_minY, position.y);
+        m_maxY = std::max(m_maxY, position.y);
+        return;
+    }
+
+    removeFromBucket(handle);
+    entry.position = position;
+    addToBucket(handle);
+}
+
+void SpatialIndex::setValue(SpatialHandle handle, uint32_t value) {
+    if (handle < m_entries.size()) {
+        m_entries[handle].value = value;
+    }
+}
+
+void SpatialIndex::remove(SpatialHandle handle) {
+    if (handle >= m_entries.size() || !m_entries[handle].alive) return;
+
+    removeFromBucket(handle);
+    m_entries[handle].alive = false;
+    m_freeHandles.push_back(handle);
+}
+
+void SpatialIndex::clear() {
+    m_entries.clear();
+    m_freeHandles.clear();
+    m_buckets.clear();
+    m_maxRadius = 0.0f;
+    m_minY = m_maxY = 0.0f;
+}
+
+void SpatialIndex::addToBucket(SpatialHandle handle) {
+    Entry& entry = m_entries[handle];
+    entry.bucket = bucketKey(bucketCoord(entry.position.x), bucketCoord(entry.position.z));
+
+    std::vector<SpatialHandle>& bucket = m_buckets[entry.bucket];
+    entry.slot = static_cast<uint32_t>(bucket.size());
+    bucket.push_back(handle);
+
+    // Y 范围只扩不缩，仅用于视锥查询时估计桶的高度
+    m_minY = std::min(m_minY, entry.position.y);
+    m_maxY = std::max(m_maxY, entry.position.y);
+}
+
+void SpatialIndex::removeFromBucket(SpatialHandle handle) {
+    const Entry& entry = m_entries[handle];
+    auto it = m_buckets.find(entry.bucket);
+    if (it == m_buckets.end()) return;
+
+    // 与桶内最后一个条目交换后删除
+    std::vector<SpatialHandle>& bucket = it->second;
+    SpatialHandle moved = bucket.back();
+    bucket[entry.slot] = moved;
+    m_entries[moved].slot = entry.slot;
+    bucket.pop_back();
+
+    if (bucket.empty()) {
+        m_buckets.erase(it);
+    }
+}
+
+template <typename Fn>
+void SpatialIndex::forEachBucket(float minX, float minZ, float maxX, float maxZ, Fn fn) const {
+    const int bx0 = bucketCoord(minX);
+    const int bz0 = bucketCoord(minZ);
+    const int bx1 = bucketCoord(maxX);
+    const int bz1 = bucketCoord(maxZ);
+    const int64_t rangeBuckets = static_cast<int64_t>(bx1 - bx0 + 1) * (bz1 - bz0 + 1);
+
+    if (rangeBuckets <= static_cast<int64_t>(m_buckets.size())) {
+        for (int bz = bz0; bz <= bz1; ++bz) {
+            for (int bx = bx0; bx <= bx1; ++bx) {
+                auto it = m_buckets.find(bucketKey(bx, bz));
+                if (it != m_buckets.end()) {
+                    fn(it->second);
+                }
+            }
+        }
+        return;
+    }
+
+    // 查询范围比非空桶还多时，直接遍历非空桶
+    for (const auto& pair : m_buckets) {
+        int bx, bz;
+        bucketCoords(pair.first, bx, bz);
+        if (bx >= bx0 && bx <= bx1 && bz >= bz0 && bz <= bz1) {
+            fn(pair.second);
+        }
+    }
+}
+
+void SpatialIndex::queryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& outValues) const {
+    outValues.clear();
+    const float radiusSq = radius * radius;
+    forEachBucket(center.x - radius, center.z - radius, center.x + radius, center.z + radius,
+        [&](const std::vector<SpatialHandle>& bucket) {
+            for (SpatialHandle handle : bucket) {
+                const Entry& entry = m_entries[handle];
+                float dx = entry.position.x - center.x;
+                float dz = entry.position.z - center.z;
+                if (dx * dx + dz * dz < radiusSq) {
+                    outValues.push_back(entry.value);
+                }
+            }
+        });
+}
+
+void SpatialIndex::queryAABB(const glm::vec3& minCorner, const glm::vec3& maxCorner, std::vector<uint32_t>& outValues) const {
+    outValues.clear();
+    forEachBucket(minCorner.x, minCorner.z, maxCorner.x, maxCorner.z,
+        [&](const std::vector<SpatialHandle>& bucket) {
+            for (SpatialHandle handle : bucket) {
+                const Entry& entry = m_entries[handle];
+                const glm::vec3& p = entry.position;
+                if (p.x >= minCorner.x && p.x <= maxCorner.x &&
+                    p.y >= minCorner.y && p.y <= maxCorner.y &&
+                    p.z >= minCorner.z && p.z <= maxCorner.z) {
+                    outValues.push_back(entry.value);
+                }
+            }
+        });
+}
+
+void SpatialIndex::queryFrustum(const glm::mat4& viewProjection, std::vector<uint32_t>& outValues) const {
+    outValues.clear();
+
+    // 从投影视图矩阵提取六个裁剪平面（Gribb-Hartmann），法线朝向视锥内部
+    glm::vec4 planes[6];
+    for (int i = 0; i < 3; ++i) {
+        glm::vec4 rowI(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+        glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+        planes[i * 2 + 0] = row3 + rowI;
+        planes[i * 2 + 1] = row3 - rowI;
+    }
+    for (glm::vec4& plane : planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+
+    auto boxOutside = [&](const glm::vec3& boxMin, const glm::vec3& boxMax) {
+        for (const glm::vec4& plane : planes) {
+            // 取包围盒在平面法线方向上最远的角点
+            glm::vec3 p(plane.x >= 0.0f ? boxMax.x : boxMin.x,
+                        plane.y >= 0.0f ? boxMax.y : boxMin.y,
+                        plane.z >= 0.0f ? boxMax.z : boxMin.z);
+            if (glm::dot(glm::vec3(plane), p) + plane.w < 0.0f) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto sphereOutside = [&](const glm::vec3& center, float radius) {
+        for (const glm::vec4& plane : planes) {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (const auto& pair : m_buckets) {
+        int bx, bz;
+        bucketCoords(pair.first, bx, bz);
+        glm::vec3 boxMin(bx * m_bucketSize - m_maxRadius, m_minY - m_maxRadius, bz * m_bucketSize - m_maxRadius);
+        glm::vec3 boxMax((bx + 1) * m_bucketSize + m_maxRadius, m_maxY + m_maxRadius, (bz + 1) * m_bucketSize + m_maxRadius);
+        if (boxOutside(boxMin, boxMax)) {
+            continue;
+        }
+
+        for (SpatialHandle handle : pair.second) {
+            const Entry& entry = m_entries[handle];
+            if (!sphereOutside(entry.position, entry.radius)) {
+                outValues.push_back(entry.value);
+            }
+        }
+    }
+}
+
+} // namespace WaterTown
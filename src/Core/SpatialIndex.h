@@ -0,0 +1,98 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 空间索引中的条目句柄
+ */
+using SpatialHandle = uint32_t;
+constexpr SpatialHandle INVALID_SPATIAL_HANDLE = 0xFFFFFFFFu;
+
+/**
+ * @brief XZ 平面上的均匀网格空间索引（不依赖 OpenGL，编辑器、物体渲染器和船只物理共用）
+ *
+ * 在 XZ 平面上把世界划分为边长 bucketSize 的桶，只保存非空桶。
+ * 每个条目记录位置、包围半径和一个调用方自定义的值（例如物体在列表中的下标），
+ * 查询结果返回这些值。查询只访问与查询范围相交的桶，耗时取决于局部密度而不是物体总数。
+ */
+class SpatialIndex {
+public:
+    explicit SpatialIndex(float bucketSize = 8.0f);
+
+    /**
+     * @brief 插入条目
+     * @param position 条目位置
+     * @param radius 包围球半径（视锥查询使用）
+     * @param value 查询时返回的值
+     */
+    SpatialHandle insert(const glm::vec3& position, float radius, uint32_t value);
+
+    /**
+     * @brief 移动条目（跨桶时才调整桶内容）
+     */
+    void update(SpatialHandle handle, const glm::vec3& position);
+
+    /**
+     * @brief 修改条目的值
+     */
+    void setValue(SpatialHandle handle, uint32_t value);
+
+    void remove(SpatialHandle handle);
+    void clear();
+
+    size_t size() const { return m_entries.size() - m_freeHandles.size(); }
+
+    /**
+     * @brief 水平距离（忽略 Y）小于 radius 的条目
+     */
+    void queryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& outValues) const;
+
+    /**
+     * @brief 位置落在 [minCorner, maxCorner] 内的条目
+     */
+    void queryAABB(const glm::vec3& minCorner, const glm::vec3& maxCorner, std::vector<uint32_t>& outValues) const;
+
+    /**
+     * @brief 包围球与视锥相交的条目
+     * @param viewProjection 投影矩阵 * 视图矩阵
+     */
+    void queryFrustum(const glm::mat4& viewProjection, std::vector<uint32_t>& outValues) const;
+
+private:
+    struct Entry {
+        glm::vec3 position;
+        float radius;
+        uint32_t value;
+        int64_t bucket;  // 所在桶的键
+        uint32_t slot;   // 在桶内数组中的下标
+        bool alive;
+    };
+
+    int bucketCoord(float v) const;
+    static int64_t bucketKey(int bx, int bz);
+    static void bucketCoords(int64_t key, int& bx, int& bz);
+    void addToBucket(SpatialHandle handle);
+    void removeFromBucket(SpatialHandle handle);
+
+    /**
+     * @brief 遍历与 XZ 矩形相交的非空桶
+     */
+    template <typename Fn>
+    void forEachBucket(float minX, float minZ, float maxX, float maxZ, Fn fn) const;
+
+    float m_bucketSize;
+    float m_maxRadius;  // 所有条目的最大半径（视锥查询时扩展桶的包围盒）
+    float m_minY;
+    float m_maxY;
+
+    std::vector<Entry> m_entries;  // 下标即句柄
+    std::vector<SpatialHandle> m_freeHandles;
+    std::unordered_map<int64_t, std::vector<SpatialHandle>> m_buckets;
+};
+
+} // namespace WaterTown
@@ -0,0 +1,99 @@
+#include "TerrainMap.h"
+#include <algorithm>
+
+namespace WaterTown {
+
+TerrainMap::TerrainMap()
+    : m_sizeX(0), m_sizeZ(0), m_chunksX(0), m_chunksZ(0) {
+}
+
+TerrainMap::TerrainMap(int sizeX, int sizeZ, TerrainType fillType)
+    : m_sizeX(0), m_sizeZ(0), m_chunksX(0), m_chunksZ(0) {
+    resize(sizeX, sizeZ, fillType);
+}
+
+void TerrainMap::resize(int sizeX, int sizeZ, TerrainType fillType) {
+    sizeX = std::max(sizeX, 0);
+    sizeZ = std::max(sizeZ, 0);
+    if (sizeX == m_sizeX && sizeZ == m_sizeZ) {
+        return;
+    }
+
+    TerrainMap old;
+    std::swap(old.m_types, m_types);
+    old.m_sizeX = m_sizeX;
+    old.m_sizeZ = m_sizeZ;
+    old.m_chunksX = m_chunksX;
+    old.m_chunksZ = m_chunksZ;
+
+    m_sizeX = sizeX;
+    m_sizeZ = sizeZ;
+    m_chunksX = (sizeX + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunksZ = (sizeZ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    // 区块外的填充格子始终为 EMPTY，扫描区块时无需额外判断边界
+    const size_t cellCount = static_cast<size_t>(m_chunksX) * m_chunksZ * CHUNK_CELLS;
+    m_types.assign(cellCount, TerrainType::EMPTY);
+    m_waterMask.assign(cellCount, 0);
+
+    const int copyX = std::min(old.m_sizeX, m_sizeX);
+    const int copyZ = std::min(old.m_sizeZ, m_sizeZ);
+    for (int z = 0; z < m_sizeZ; ++z) {
+        for (int x = 0; x < m_sizeX; ++x) {
+            m_types[cellIndex(x, z)] = (x < copyX && z < copyZ) ? old.get(x, z) : fillType;
+        }
+    }
+
+    rebuildWaterMask();
+}
+
+void TerrainMap::fill(TerrainType type) {
+    for (int z = 0; z < m_sizeZ; ++z) {
+        for (int x = 0; x < m_sizeX; ++x) {
+            m_types[cellIndex(x, z)] = type;
+        }
+    }
+    rebuildWaterMask();
+}
+
+void TerrainMap::set(int x, int z, TerrainType type) {
+    size_t index = cellIndex(x, z);
+    TerrainType oldType = m_types[index];
+    m_types[index] = type;
+
+    bool wasWater = (oldType == TerrainType::WATER);
+    bool isWater = (type == TerrainType::WATER);
+    if (wasWater == isWater) {
+        return;
+    }
+
+    // 本格是否为水只影响四个邻居的掩码位（邻居看向本格的方向）
+    auto updateNeighbor = [this, isWater](int nx, int nz, uint8_t bit) {
+        if (!inBounds(nx, nz)) return;
+        uint8_t& mask = m_waterMask[cellIndex(nx, nz)];
+        mask = isWater ? static_cast<uint8_t>(mask | bit) : static_cast<uint8_t>(mask & ~bit);
+    };
+    updateNeighbor(x - 1, z, WATER_NEIGHBOR_POS_X);
+    updateNeighbor(x + 1, z, WATER_NEIGHBOR_NEG_X);
+    updateNeighbor(x, z - 1, WATER_NEIGHBOR_POS_Z);
+    updateNeighbor(x, z + 1, WATER_NEIGHBOR_NEG_Z);
+}
+
+void TerrainMap::rebuildWaterMask() {
+    auto isWater = [this](int x, int z) {
+        return inBounds(x, z) && get(x, z) == TerrainType::WATER;
+    };
+
+    for (int z = 0; z < m_sizeZ; ++z) {
+        for (int x = 0; x < m_sizeX; ++x) {
+            uint8_t mask = 0;
+            if (isWater(x + 1, z)) mask |= WATER_NEIGHBOR_POS_X;
+            if (isWater(x - 1, z)) mask |= WATER_NEIGHBOR_NEG_X;
+            if (isWater(x, z + 1)) mask |= WATER_NEIGHBOR_POS_Z;
+            if (isWater(x, z - 1)) mask |= WATER_NEIGHBOR_NEG_Z;
+            m_waterMask[cellIndex(x, z)] = mask;
+        }
+    }
+}
+
+} // namespace WaterTown
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 地形类型（1 字节存储）
+ */
+enum class TerrainType : uint8_t {
+    EMPTY,      // 空地(默认) - WaterTown 特有
+    GRASS,      // 草地
+    WATER,      // 水路
+    STONE       // 石路
+};
+
+/**
+ * @brief 邻接水面掩码位（标记某个方向的相邻格子是否为 WATER）
+ */
+enum WaterNeighborBits : uint8_t {
+    WATER_NEIGHBOR_POS_X = 1 << 0,
+    WATER_NEIGHBOR_NEG_X = 1 << 1,
+    WATER_NEIGHBOR_POS_Z = 1 << 2,
+    WATER_NEIGHBOR_NEG_Z = 1 << 3
+};
+
+/**
+ * @brief 连续存储的地形网格
+ *
+ * 所有格子保存在一块连续内存中，并按 CHUNK_SIZE x CHUNK_SIZE 的区块顺序排列：
+ * 先按区块 (cz * chunksX + cx)，区块内再按行 (lz * CHUNK_SIZE + lx)。
+ * 这样扫描一个区块、或在区块内按行扫描都是线性访问；
+ * 跨越整张地图的一行每 CHUNK_SIZE 个格子就会跳到另一个区块，不是连续的。
+ *
+ * 每个格子的附加信息以独立数组（图层）保存，目前有：
+ * - 地形类型（TerrainType，1 字节）
+ * - 邻接水面掩码（WaterNeighborBits，写入类型时增量维护）
+ */
+class TerrainMap {
+public:
+    static constexpr int CHUNK_SIZE = 32;                       // 区块边长（格子数）
+    static constexpr int CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE; // 每个区块的格子数
+
+    TerrainMap();
+    TerrainMap(int sizeX, int sizeZ, TerrainType fillType = TerrainType::EMPTY);
+
+    /**
+     * @brief 调整尺寸，保留重叠区域的内容，新格子填充为 fillType
+     */
+    void resize(int sizeX, int sizeZ, TerrainType fillType = TerrainType::EMPTY);
+
+    /**
+     * @brief 用同一种类型填满整张地图
+     */
+    void fill(TerrainType type);
+
+    int getSizeX() const { return m_sizeX; }
+    int getSizeZ() const { return m_sizeZ; }
+    int getChunksX() const { return m_chunksX; }
+    int getChunksZ() const { return m_chunksZ; }
+
+    bool inBounds(int x, int z) const {
+        return x >= 0 && x < m_sizeX && z >= 0 && z < m_sizeZ;
+    }
+
+    /**
+     * @brief 读取格子类型（不做越界检查）
+     */
+    TerrainType get(int x, int z) const { return m_types[cellIndex(x, z)]; }
+
+    /**
+     * @brief 读取格子类型，越界时返回 EMPTY
+     */
+    TerrainType at(int x, int z) const {
+        return inBounds(x, z) ? get(x, z) : TerrainType::EMPTY;
+    }
+
+    /**
+     * @brief 写入格子类型，并更新相邻格子的水面掩码
+     */
+    void set(int x, int z, TerrainType type);
+
+    /**
+     * @brief 读取邻接水面掩码（不做越界检查）
+     */
+    uint8_t getWaterNeighborMask(int x, int z) const { return m_waterMask[cellIndex(x, z)]; }
+
+    /**
+     * @brief 区块内的类型数据（CHUNK_CELLS 个，按 lz * CHUNK_SIZE + lx 排列）
+     */
+    const TerrainType* chunkTypes(int chunkX, int chunkZ) const {
+        return m_types.data() + chunkOffset(chunkX, chunkZ);
+    }
+
+    /**
+     * @brief 区块内的邻接水面掩码数据（布局同 chunkTypes）
+     */
+    const uint8_t* chunkWaterMask(int chunkX, int chunkZ) const {
+        return m_waterMask.data() + chunkOffset(chunkX, chunkZ);
+    }
+
+    /**
+     * @brief 各图层占用的总字节数
+     */
+    size_t getMemoryBytes() const { return m_types.size() + m_waterMask.size(); }
+
+private:
+    size_t chunkOffset(int chunkX, int chunkZ) const {
+        return (static_cast<size_t>(chunkZ) * m_chunksX + chunkX) * CHUNK_CELLS;
+    }
+
+    size_t cellIndex(int x, int z) const {
+        return chunkOffset(x / CHUNK_SIZE, z / CHUNK_SIZE) +
+               (z % CHUNK_SIZE) * CHUNK_SIZE + (x % CHUNK_SIZE);
+    }
+
+    void rebuildWaterMask();
+
+    int m_sizeX;
+    int m_sizeZ;
+    int m_chunksX;
+    int m_chunksZ;
+
+    std::vector<TerrainType> m_types;  // 地形类型图层
+    std::vector<uint8_t> m_waterMask;  // 邻接水面掩码图层
+};
+
+} // namespace WaterTown
@@ -4,8 +4,8 @@
 
 namespace WaterTown {
 
-Window::Window(int width, int height, const char* title)
-    : m_window(nullptr), m_width(width), m_height(height), m_title(title) {
+Window::Window(int width, int height, const char* title, bool headless)
+    : m_window(nullptr), m_width(width), m_height(height), m_title(title), m_headless(headless) {
     
     // 初始化 GLFW
     if (!initGLFW()) {
@@ -18,7 +18,11 @@ Window::Window(int width, int height, const char* title)
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     
     // 创建窗口
-    m_window = glfwCreateWindow(m_width, m_height, m_title.c_str(), nullptr, nullptr);
+    if (m_headless) {
+        m_window = createHeadlessWindow();
+    } else {
+        m_window = glfwCreateWindow(m_width, m_height, m_title.c_str(), nullptr, nullptr);
+    }
     if (!m_window) {
         glfwTerminate();
         throw std::runtime_error("Failed to create GLFW window");
@@ -26,8 +30,8 @@ Window::Window(int width, int height, const char* title)
     
     glfwMakeContextCurrent(m_window);
     
-    // 启用 VSync (垂直同步) 以限制帧率
-    glfwSwapInterval(1);
+    // 启用 VSync (垂直同步) 以限制帧率；无显示模式下不限帧，测的是实际耗时
+    glfwSwapInterval(m_headless ? 0 : 1);
     
     // 初始化 GLAD
     if (!initGLAD()) {
@@ -36,6 +40,12 @@ Window::Window(int width, int height, const char* title)
         throw std::runtime_error("Failed to initialize GLAD");
     }
     
+    if (m_headless && !createOffscreenTarget()) {
+        glfwDestroyWindow(m_window);
+        glfwTerminate();
+        throw std::runtime_error("Failed to create offscreen framebuffer");
+    }
+    
     // 输出 OpenGL 信息
     std::cout << "========================================" << std::endl;
     std::cout << "OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
@@ -48,6 +58,12 @@ Window::Window(int width, int height, const char* title)
 }
 
 Window::~Window() {
+    if (m_offscreenFBO) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &m_offscreenFBO);
+        GLuint renderbuffers[2] = { m_offscreenColor, m_offscreenDepth };
+        glDeleteRenderbuffers(2, renderbuffers);
+    }
     if (m_window) {
         glfwDestroyWindow(m_window);
     }
@@ -66,6 +82,10 @@ void Window::swapBuffers() {
     glfwSwapBuffers(m_window);
 }
 
+void Window::requestClose() {
+    glfwSetWindowShouldClose(m_window, GLFW_TRUE);
+}
+
 void Window::setResizeCallback(GLFWframebuffersizefun callback) {
     glfwSetFramebufferSizeCallback(m_window, callback);
 }
@@ -83,6 +103,12 @@ void Window::setCursorCapture(bool enabled) {
 }
 
 bool Window::initGLFW() {
+#if GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4)
+    // GLFW 3.4 起提供 Null 平台，无需 X11/Wayland 即可创建上下文
+    if (m_headless && glfwPlatformSupported(GLFW_PLATFORM_NULL)) {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
+#endif
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW" << std::endl;
         return false;
@@ -90,6 +116,46 @@ bool Window::initGLFW() {
     return true;
 }
 
+GLFWwindow* Window::createHeadlessWindow() {
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    
+    const int contextApis[] = { GLFW_EGL_CONTEXT_API, GLFW_OSMESA_CONTEXT_API };
+    const char* contextNames[] = { "EGL", "OSMesa" };
+    for (int i = 0; i < 2; ++i) {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, contextApis[i]);
+        GLFWwindow* window = glfwCreateWindow(m_width, m_height, m_title.c_str(), nullptr, nullptr);
+        if (window) {
+            std::cout << "Headless context created via " << contextNames[i] << std::endl;
+            return window;
+        }
+        std::cerr << "Headless context via " << contextNames[i] << " unavailable" << std::endl;
+    }
+    return nullptr;
+}
+
+bool Window::createOffscreenTarget() {
+    glGenFramebuffers(1, &m_offscreenFBO);
+    glGenRenderbuffers(1, &m_offscreenColor);
+    glGenRenderbuffers(1, &m_offscreenDepth);
+    
+    glBindRenderbuffer(GL_RENDERBUFFER, m_offscreenColor);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_width, m_height);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_offscreenDepth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_width, m_height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    
+    // 之后一直保持绑定，所有绘制都落在这里
+    glBindFramebuffer(GL_FRAMEBUFFER, m_offscreenFBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_offscreenColor);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_offscreenDepth);
+    
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Offscreen framebuffer is incomplete" << std::endl;
+        return false;
+    }
+    return true;
+}
+
 bool Window::initGLAD() {
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         std::cerr << "Failed to initialize GLAD" << std::endl;
@@ -16,8 +16,9 @@ public:
      * @param width 窗口宽度
      * @param height 窗口高度
      * @param title 窗口标题
+     * @param headless 无显示模式：不创建可见窗口，渲染到离屏帧缓冲（用于基准测试/CI）
      */
-    Window(int width, int height, const char* title);
+    Window(int width, int height, const char* title, bool headless = false);
     
     /**
      * @brief 析构函数，清理 GLFW 资源
@@ -44,6 +45,11 @@ public:
      */
     void swapBuffers();
     
+    /**
+     * @brief 请求关闭窗口（主循环在本帧结束后退出）
+     */
+    void requestClose();
+    
     /**
      * @brief 获取 GLFW 窗口指针
      * @return GLFW 窗口指针
@@ -85,12 +91,23 @@ public:
      * @return 宽高比
      */
     float getAspectRatio() const { return static_cast<float>(m_width) / static_cast<float>(m_height); }
+    
+    /**
+     * @brief 是否为无显示模式
+     */
+    bool isHeadless() const { return m_headless; }
 
 private:
     GLFWwindow* m_window;
     int m_width;
     int m_height;
     std::string m_title;
+    bool m_headless;
+    
+    // 无显示模式下的离屏渲染目标
+    GLuint m_offscreenFBO = 0;
+    GLuint m_offscreenColor = 0;
+    GLuint m_offscreenDepth = 0;
     
     /**
      * @brief 初始化 GLFW
@@ -98,6 +115,18 @@ private:
      */
     bool initGLFW();
     
+    /**
+     * @brief 无显示模式下创建窗口：先尝试 EGL（surfaceless），失败后回退到 OSMesa
+     * @return 创建的窗口，失败返回 nullptr
+     */
+    GLFWwindow* createHeadlessWindow();
+    
+    /**
+     * @brief 创建并绑定离屏帧缓冲（surfaceless 上下文没有默认帧缓冲）
+     * @return 帧缓冲完整返回 true
+     */
+    bool createOffscreenTarget();
+    
     /**
      * @brief 初始化 GLAD
      * @return 初始化成功返回 true，否则返回 false
@@ -1,7 +1,12 @@
 #include "EditorUI.h"
 #include "Render/OrbitCamera.h" // for building-mode camera sliders
 #include "../Physics/Boat.h"
+#include "../Water/WaterSurface.h"
+#include "../Render/GLState.h"
+#include "../Render/GLCounters.h"
+#include "../Core/Profiler.h"
 #include <imgui.h>
+#include <algorithm>
 #include <iostream>
 
 namespace WaterTown {
@@ -14,7 +19,8 @@ EditorUI::EditorUI()
       m_showWater(true),
       m_showObjects(true),
       m_gridSize(1.0f),
-      m_fps(0.0f) {
+      m_fps(0.0f),
+      m_captureFrameCount(60) {
     
     m_terrainCount[0] = 0;
     m_terrainCount[1] = 0;
@@ -40,6 +46,7 @@ void EditorUI::render() {
     renderSettingsPanel();
     renderStatsPanel();
     renderScenePanel();
+    renderProfilerPanel();
 }
 
 void EditorUI::renderModePanel() {
@@ -250,6 +257,44 @@ void EditorUI::renderSettingsPanel() {
     ImGui::Checkbox("Show Grid", &m_showGrid);
     ImGui::Checkbox("Show Water", &m_showWater);
     ImGui::Checkbox("Show Objects", &m_showObjects);
+
+    // 烘焙水面高度场：浮力与 GPU 水面（含水平位移）一致，查询为常数时间
+    if (WaterSurface* water = m_editor->getWaterSurface()) {
+        bool baked = water->isHeightfieldEnabled();
+        if (ImGui::Checkbox("Baked Wave Heightfield", &baked)) {
+            water->setHeightfieldEnabled(baked);
+        }
+
+        // clipmap 水面：跟随相机的嵌套网格，顶点数固定；关闭时退回规则网格（两者都按地形类型图遮掉陆地）
+        bool clipmap = water->isClipmapEnabled();
+        if (ImGui::Checkbox("Clipmap Water", &clipmap)) {
+            water->setClipmapEnabled(clipmap);
+        }
+
+        // FFT 海面：每个模拟步在 CPU 上合成位移图 / 坡度图，渲染和浮力共用
+        bool ocean = water->isOceanEnabled();
+        if (ImGui::Checkbox("FFT Ocean", &ocean)) {
+            water->setOceanEnabled(ocean);
+        }
+        if (OceanSpectrum* spectrum = water->getOcean()) {
+            OceanParams params = spectrum->getParams();
+            bool changed = false;
+            if (ImGui::RadioButton("Phillips", params.spectrum == OceanSpectrumType::PHILLIPS)) {
+                params.spectrum = OceanSpectrumType::PHILLIPS;
+                changed = true;
+            }
+            ImGui::SameLine();
+            if (ImGui::RadioButton("JONSWAP", params.spectrum == OceanSpectrumType::JONSWAP)) {
+                params.spectrum = OceanSpectrumType::JONSWAP;
+                changed = true;
+            }
+            changed |= ImGui::SliderFloat("Wind Speed", &params.windSpeed, 1.0f, 15.0f, "%.1f m/s");
+            changed |= ImGui::SliderFloat("Choppiness", &params.choppiness, 0.0f, 2.0f, "%.2f");
+            if (changed) {
+                spectrum->setParams(params);
+            }
+        }
+    }
     
     ImGui::Separator();
     
@@ -279,8 +324,8 @@ void EditorUI::renderSettingsPanel() {
 }
 
 void EditorUI::renderStatsPanel() {
-    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - 260, 10), ImGuiCond_FirstUseEver);
-    ImGui::SetNextWindowSize(ImVec2(250, 200), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - 370, 10), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(360, 260), ImGuiCond_FirstUseEver);
     
     ImGui::Begin("Statistics");
     
@@ -307,6 +352,28 @@ void EditorUI::renderStatsPanel() {
         ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Performance: Good");
     }
     
+    // GL 状态切换（上一帧）
+    const GLStateStats& glStats = GLState::getLastFrameStats();
+    ImGui::Text("GL State: %u issued, %u skipped", glStats.issued, glStats.skipped);
+    
+#if WATERTOWN_GL_COUNTERS_ENABLED
+    // GL 调用计数（上一帧），按 pass 展开
+    const GLFrameCounters& counters = GLCounters::getLastFrame();
+    ImGui::Text("Draw Calls: %u, Triangles: %llu", counters.drawCalls,
+                static_cast<unsigned long long>(counters.triangles));
+    ImGui::Text("Uploads: %u (%.1f KB)", counters.bufferUploads, counters.bufferBytes / 1024.0);
+    ImGui::Text("Uniforms: %u, Binds: %u", counters.uniformCalls, counters.bindCalls);
+    if (ImGui::TreeNode("GL Calls Per Pass")) {
+        for (const GLPassCounters& pass : GLCounters::getLastFramePasses()) {
+            const GLFrameCounters& c = pass.counters;
+            ImGui::Text("%-10s %4u draws %8llu tris %7.1f KB %4u unif %4u binds", pass.name, c.drawCalls,
+                        static_cast<unsigned long long>(c.triangles), c.bufferBytes / 1024.0,
+                        c.uniformCalls, c.bindCalls);
+        }
+        ImGui::TreePop();
+    }
+#endif
+    
     ImGui::Separator();
     ImGui::Text("Terrain Count:");
     ImGui::Text("  Grass: %d", m_terrainCount[0]);
@@ -386,4 +453,89 @@ void EditorUI::renderScenePanel() {
     ImGui::End();
 }
 
+void EditorUI::renderProfilerPanel() {
+    ImGui::SetNextWindowPos(ImVec2(10, ImGui::GetIO().DisplaySize.y - 270), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(640, 260), ImGuiCond_FirstUseEver);
+    
+    ImGui::Begin("Profiler");
+    
+    bool enabled = Profiler::isEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled)) {
+        Profiler::setEnabled(enabled);
+    }
+    
+    // 捕获 N 帧并导出 Chrome trace
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(90.0f);
+    ImGui::InputInt("Frames", &m_captureFrameCount);
+    m_captureFrameCount = std::max(1, std::min(m_captureFrameCount, 1000));
+    ImGui::SameLine();
+    if (Profiler::isCapturing()) {
+        ImGui::Text("Capturing... %d left", Profiler::getCaptureRemaining());
+    } else if (ImGui::Button("Capture Trace") && enabled) {
+        Profiler::requestCapture(m_captureFrameCount, "profile_trace.json");
+    }
+    
+    const ProfileFrame& frame = Profiler::getLastFrame();
+    if (frame.hasGpu) {
+        ImGui::Text("Frame %llu   CPU: %.2f ms   GPU: %.2f ms",
+                    static_cast<unsigned long long>(frame.index), frame.cpuMs, frame.gpuMs);
+    } else {
+        ImGui::Text("Frame %llu   CPU: %.2f ms   GPU: n/a",
+                    static_cast<unsigned long long>(frame.index), frame.cpuMs);
+    }
+    
+    // 两条轨道使用相同的时间比例，便于对比
+    double spanMs = std::max(std::max(frame.cpuMs, frame.gpuMs), 1.0);
+    
+    // 火焰图：横轴为帧内时间，纵轴为嵌套深度
+    auto drawTrack = [spanMs](const char* label, const std::vector<ProfileEvent>& events) {
+        ImGui::TextUnformatted(label);
+        
+        int maxDepth = 0;
+        for (const ProfileEvent& event : events) {
+            maxDepth = std::max(maxDepth, event.depth);
+        }
+        const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+        const float width = std::max(ImGui::GetContentRegionAvail().x, 50.0f);
+        const float height = rowHeight * (maxDepth + 1);
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        
+        drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + height), IM_COL32(30, 30, 30, 255));
+        for (const ProfileEvent& event : events) {
+            float x0 = origin.x + static_cast<float>(event.startMs / spanMs) * width;
+            float x1 = origin.x + static_cast<float>((event.startMs + event.durationMs) / spanMs) * width;
+            x1 = std::max(x1, x0 + 1.0f);
+            float y0 = origin.y + event.depth * rowHeight;
+            ImVec2 minCorner(x0, y0 + 1.0f);
+            ImVec2 maxCorner(x1, y0 + rowHeight - 1.0f);
+            
+            // 按名字取色，同一区间每帧颜色不变
+            unsigned int hash = 2166136261u;
+            for (const char* c = event.name; *c; ++c) {
+                hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+            }
+            ImU32 color = ImColor::HSV((hash % 360) / 360.0f, 0.45f, 0.75f);
+            drawList->AddRectFilled(minCorner, maxCorner, color);
+            
+            ImVec2 textSize = ImGui::CalcTextSize(event.name);
+            if (textSize.x + 4.0f < x1 - x0) {
+                drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), event.name);
+            }
+            if (ImGui::IsMouseHoveringRect(minCorner, maxCorner)) {
+                ImGui::SetTooltip("%s\n%.3f ms", event.name, event.durationMs);
+            }
+        }
+        ImGui::Dummy(ImVec2(width, height));
+    };
+    
+    drawTrack("CPU", frame.cpuEvents);
+    if (frame.hasGpu) {
+        drawTrack("GPU", frame.gpuEvents);
+    }
+    
+    ImGui::End();
+}
+
 } // namespace WaterTown
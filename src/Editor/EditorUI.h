@@ -59,6 +59,9 @@ private:
     float m_fps;
     int m_terrainCount[3];  // 草地、水路、石路数量
     
+    // 性能分析
+    int m_captureFrameCount;  // 一次捕获的帧数
+    
     /**
      * @brief 渲染模式切换面板
      */
@@ -83,6 +86,11 @@ private:
      * @brief 渲染场景管理面板
      */
     void renderScenePanel();
+    
+    /**
+     * @brief 渲染性能分析面板（CPU/GPU 分层时间线与 trace 捕获）
+     */
+    void renderProfilerPanel();
 };
 
 } // namespace WaterTown
@@ -1,11 +1,13 @@
 #include "Core/Application.h"
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
 #include "Editor/SceneEditor.h"
-#include <GLFW/glfw3.h>
 #include "Render/OrthographicCamera.h"
 #include "Render/OrbitCamera.h"
 #include "Render/FollowCamera.h"
 #include "Render/Camera.h"
 #include "Render/ObjectRenderer.h"
+#include "Render/TerrainRenderer.h"
 #include "Water/WaterSurface.h"
 #include "Physics/Boat.h"
 #include <iostream>
@@ -22,19 +24,22 @@ SceneEditor::SceneEditor()
       m_orbitCamera(nullptr),
       m_followCamera(nullptr),
       m_waterSurface(nullptr),
+      m_terrainRenderer(nullptr),
       m_boat(nullptr),
       m_objectRenderer(nullptr),
+      m_currentGridZ(INITIAL_GRID_SIZE_Z),
       m_riverStartColumn(0),
       m_riverEndColumn(0),
       m_currentTerrainType(TerrainType::GRASS),
       m_currentObjectType(ObjectType::HOUSE),
+      m_nextPlacementOrder(0),
+      m_objectIndex(OBJECT_INDEX_BUCKET_CELLS * CELL_SIZE),
       m_objectsHiddenForGame(false),
       m_boatPlaced(false),
-      m_boatPlacedPosition(0.0f),
-      m_currentGridZ(INITIAL_GRID_SIZE_Z) {
+      m_boatPlacedPosition(0.0f) {
       
     // 初始化动态网格为320x320，默认全空
-    m_terrainGrid.resize(GRID_SIZE_X, std::vector<TerrainType>(INITIAL_GRID_SIZE_Z, TerrainType::EMPTY));
+    m_terrainMap.resize(GRID_SIZE_X, INITIAL_GRID_SIZE_Z, TerrainType::EMPTY);
 }
 
 SceneEditor::~SceneEditor() {
@@ -42,7 +47,6 @@ SceneEditor::~SceneEditor() {
     delete m_orbitCamera;
     delete m_followCamera;
     delete m_boat;
-    delete m_objectRenderer;
 }
 
 // --- Transition Camera Helper ---
@@ -101,17 +105,14 @@ void SceneEditor::init(float aspectRatio) {
         if (gx < 0 || gx >= GRID_SIZE_X || gz < 0 || gz >= m_currentGridZ) return false;
         
         // 只有 WATER 视为安全
-        return m_terrainGrid[gx][gz] == TerrainType::WATER;
+        return m_terrainMap.get(gx, gz) == TerrainType::WATER;
     });
 
-    // 创建物体渲染器
-    m_objectRenderer = new ObjectRenderer();
-
     // 初始化默认地形（江南水乡）
     initializeTerrainLayout();
     
-    // 确保水面网格更新
-    updateWaterMesh();
+    // 确保水面遮罩更新
+    updateWaterMask();
     
     // 清理可能存在的水上物体
     removeObjectsOnWaterExceptBoat();
@@ -127,11 +128,7 @@ void SceneEditor::initializeTerrainLayout() {
     // 我们保留边缘为 EMPTY，中间为场景？
     // 为了匹配 Sec 的效果，我们将整个 GRID 填满。
     
-    for (int x = 0; x < GRID_SIZE_X; ++x) {
-        for (int z = 0; z < INITIAL_GRID_SIZE_Z; ++z) {
-            m_terrainGrid[x][z] = TerrainType::WATER; // 先铺满水，类似威尼斯/江南
-        }
-    }
+    m_terrainMap.fill(TerrainType::WATER); // 先铺满水，类似威尼斯/江南
     
     // 定义河道宽度和岸线厚度
     const int riverWidth = static_cast<int>(GRID_SIZE_X * 0.25f);   // 中央河道宽 25%
@@ -155,7 +152,7 @@ void SceneEditor::initializeTerrainLayout() {
         }
         
         for (int z = 0; z < INITIAL_GRID_SIZE_Z; ++z) {
-            m_terrainGrid[x][z] = columnType;
+            m_terrainMap.set(x, z, columnType);
         }
     }
     
@@ -163,19 +160,19 @@ void SceneEditor::initializeTerrainLayout() {
     int plazaDepth = INITIAL_GRID_SIZE_Z / 5;
     for (int z = INITIAL_GRID_SIZE_Z / 3; z < INITIAL_GRID_SIZE_Z / 3 + plazaDepth; ++z) {
         for (int x = m_riverStartColumn - bankWidth - 3; x < m_riverStartColumn - bankWidth; ++x) {
-            if (x >= 0) m_terrainGrid[x][z] = TerrainType::STONE;
+            if (x >= 0) m_terrainMap.set(x, z, TerrainType::STONE);
         }
         for (int x = m_riverEndColumn + bankWidth; x < m_riverEndColumn + bankWidth + 3; ++x) {
-            if (x < GRID_SIZE_X) m_terrainGrid[x][z] = TerrainType::STONE;
+            if (x < GRID_SIZE_X) m_terrainMap.set(x, z, TerrainType::STONE);
         }
     }
     
     // 扩展Z方向10倍，复制模式
     int newZ = INITIAL_GRID_SIZE_Z * 10;
-    for (int x = 0; x < GRID_SIZE_X; ++x) {
-        m_terrainGrid[x].resize(newZ);
-        for (int z = INITIAL_GRID_SIZE_Z; z < newZ; ++z) {
-            m_terrainGrid[x][z] = m_terrainGrid[x][z % INITIAL_GRID_SIZE_Z];  // 复制地形模式
+    m_terrainMap.resize(GRID_SIZE_X, newZ);
+    for (int z = INITIAL_GRID_SIZE_Z; z < newZ; ++z) {
+        for (int x = 0; x < GRID_SIZE_X; ++x) {
+            m_terrainMap.set(x, z, m_terrainMap.get(x, z % INITIAL_GRID_SIZE_Z));  // 复制地形模式
         }
     }
     m_currentGridZ = newZ;
@@ -207,7 +204,7 @@ void SceneEditor::initializeTerrainLayout() {
     m_objectHistory.clear();
 }
 
-void SceneEditor::update(float deltaTime) {
+void SceneEditor::updateFrame(float deltaTime) {
     // 更新过渡状态
     if (m_isTransitioning) {
         m_transitionTime += deltaTime;
@@ -228,19 +225,34 @@ void SceneEditor::update(float deltaTime) {
             m_isTransitioning = false;
         }
     }
+}
+
+void SceneEditor::interpolate(float alpha) {
+    if (m_currentMode == EditorMode::GAME && m_followCamera) {
+        m_followCamera->interpolate(alpha);
+    }
+}
+
+void SceneEditor::update(float deltaTime, float simulationTime) {
+    m_simulationTime = simulationTime;
+    float currentTime = simulationTime;
 
-    float currentTime = static_cast<float>(glfwGetTime());
+    // 合成本步的 FFT 海面或烘焙高度场（打开时），之后的浮力查询都是双线性采样
+    if (m_waterSurface && (m_waterSurface->isOceanEnabled() || m_waterSurface->isHeightfieldEnabled())) {
+        PROFILE_SCOPE("WaterSurface::updateWaves");
+        m_waterSurface->updateWaves(currentTime);
+    }
 
     // 只在游戏模式下更新船只物理（运动、碰撞）
     // 在其他模式下只更新浮力效果（视觉上的水波浮动）
     if (m_currentMode == EditorMode::GAME) {
         if (m_boat && m_waterSurface) {
-            m_boat->update(deltaTime, m_waterSurface, currentTime);
+            m_boat->update(deltaTime, &m_waterSurface->getWaveModel(), currentTime);
         }
     } else {
         // 非游戏模式：只同步水面高度，不更新运动
         if (m_boat && m_waterSurface) {
-            m_boat->syncToWaterSurface(m_waterSurface, currentTime);
+            m_boat->syncToWaterSurface(&m_waterSurface->getWaveModel(), currentTime);
         }
     }
 
@@ -253,61 +265,137 @@ void SceneEditor::update(float deltaTime) {
 
 void SceneEditor::setWaterSurface(WaterSurface* water) {
     m_waterSurface = water;
-    updateWaterMesh(); // 初始设置时生成网格
+    updateWaterMask(); // 初始设置时上传地形类型图
     if (m_boat && m_waterSurface) {
-        m_boat->syncToWaterSurface(m_waterSurface, static_cast<float>(glfwGetTime()));
+        m_boat->syncToWaterSurface(&m_waterSurface->getWaveModel(), m_simulationTime);
     }
 }
 
-void SceneEditor::updateWaterMesh() {
-    if (!m_waterSurface) return;
+void SceneEditor::setTerrainRenderer(TerrainRenderer* renderer) {
+    m_terrainRenderer = renderer;
+    if (m_terrainRenderer) {
+        m_terrainRenderer->markDirty();
+    }
+}
 
-    // 收集所有 WATER 类型的格子，生成网格数据传给 WaterSurface
-    std::vector<float> vertices; 
+void SceneEditor::setObjectRenderer(ObjectRenderer* renderer) {
+    if (m_objectRenderer && m_objectRenderer != renderer) {
+        m_objectRenderer->clear();
+    }
+    m_objectRenderer = renderer;
     
-    float halfSizeX = GRID_SIZE_X / 2.0f;
-    float halfSizeZ = m_currentGridZ / 2.0f;
-    float uvScale = 0.1f; // UV 缩放因子
+    // 把已有物体一次性提交给新的渲染器
+    m_placedObjectIds.assign(m_placedObjects.size(), INVALID_OBJECT_ID);
+    if (m_objectRenderer) {
+        m_objectRenderer->clear();
+        for (size_t i = 0; i < m_placedObjects.size(); ++i) {
+            m_placedObjectIds[i] = m_objectRenderer->addObject(m_placedObjects[i].first, m_placedObjects[i].second);
+        }
+    }
+}
+
+float SceneEditor::getObstacleRadius(ObjectType type) {
+    return type == ObjectType::HOUSE ? 1.5f : 1.0f;
+}
+
+void SceneEditor::addPlacedObject(ObjectType type, const glm::vec3& position) {
+    uint32_t index = static_cast<uint32_t>(m_placedObjects.size());
+    m_placedObjects.push_back({type, position});
+    m_placedObjectIds.push_back(m_objectRenderer ? m_objectRenderer->addObject(type, position) : INVALID_OBJECT_ID);
+    m_placedObjectHandles.push_back(m_objectIndex.insert(position, OBJECT_BOUNDS_RADIUS, index));
+    m_placedObjectObstacles.push_back(m_boat ? m_boat->addObstacle(position, getObstacleRadius(type)) : INVALID_OBSTACLE_HANDLE);
+    m_placedObjectOrder.push_back(m_nextPlacementOrder++);
+}
+
+void SceneEditor::erasePlacedObject(size_t index) {
+    if (m_objectRenderer) {
+        m_objectRenderer->removeObject(m_placedObjectIds[index]);
+    }
+    m_objectIndex.remove(m_placedObjectHandles[index]);
+    if (m_boat) {
+        m_boat->removeObstacle(m_placedObjectObstacles[index]);
+    }
     
-    for (int x = 0; x < GRID_SIZE_X; ++x) {
-        for (int z = 0; z < m_currentGridZ; ++z) {
-            if (m_terrainGrid[x][z] == TerrainType::WATER) {
-                float x0 = (x - halfSizeX) * CELL_SIZE;
-                float z0 = (z - halfSizeZ) * CELL_SIZE;
-                float x1 = x0 + CELL_SIZE;
-                float z1 = z0 + CELL_SIZE;
-                float y = 0.0f; // Base level
-                
-                // Triangle 1
-                // Vertex 0 (x0, z0)
-                vertices.push_back(x0); vertices.push_back(y); vertices.push_back(z0);
-                vertices.push_back(x0 * uvScale); vertices.push_back(z0 * uvScale);
-                
-                // Vertex 1 (x0, z1)
-                vertices.push_back(x0); vertices.push_back(y); vertices.push_back(z1);
-                vertices.push_back(x0 * uvScale); vertices.push_back(z1 * uvScale);
-                
-                // Vertex 2 (x1, z0)
-                vertices.push_back(x1); vertices.push_back(y); vertices.push_back(z0);
-                vertices.push_back(x1 * uvScale); vertices.push_back(z0 * uvScale);
-                
-                // Triangle 2
-                // Vertex 3 (x1, z0)
-                vertices.push_back(x1); vertices.push_back(y); vertices.push_back(z0);
-                vertices.push_back(x1 * uvScale); vertices.push_back(z0 * uvScale);
-                
-                // Vertex 4 (x0, z1)
-                vertices.push_back(x0); vertices.push_back(y); vertices.push_back(z1);
-                vertices.push_back(x0 * uvScale); vertices.push_back(z1 * uvScale);
-                
-                // Vertex 5 (x1, z1)
-                vertices.push_back(x1); vertices.push_back(y); vertices.push_back(z1);
-                vertices.push_back(x1 * uvScale); vertices.push_back(z1 * uvScale);
+    // 与最后一个物体交换后删除，只需修正被移动的那个物体在空间索引中的下标
+    const size_t last = m_placedObjects.size() - 1;
+    if (index != last) {
+        m_placedObjects[index] = m_placedObjects[last];
+        m_placedObjectIds[index] = m_placedObjectIds[last];
+        m_placedObjectHandles[index] = m_placedObjectHandles[last];
+        m_placedObjectObstacles[index] = m_placedObjectObstacles[last];
+        m_placedObjectOrder[index] = m_placedObjectOrder[last];
+        m_objectIndex.setValue(m_placedObjectHandles[index], static_cast<uint32_t>(index));
+    }
+    m_placedObjects.pop_back();
+    m_placedObjectIds.pop_back();
+    m_placedObjectHandles.pop_back();
+    m_placedObjectObstacles.pop_back();
+    m_placedObjectOrder.pop_back();
+}
+
+void SceneEditor::erasePlacedObjectsIf(const std::function<bool(const std::pair<ObjectType, glm::vec3>&)>& pred) {
+    // 原地压缩各并行数组，保持其余物体的相对顺序
+    size_t kept = 0;
+    for (size_t i = 0; i < m_placedObjects.size(); ++i) {
+        if (pred(m_placedObjects[i])) {
+            if (m_objectRenderer) {
+                m_objectRenderer->removeObject(m_placedObjectIds[i]);
             }
+            m_objectIndex.remove(m_placedObjectHandles[i]);
+            if (m_boat) {
+                m_boat->removeObstacle(m_placedObjectObstacles[i]);
+            }
+            continue;
+        }
+        if (kept != i) {
+            m_placedObjects[kept] = m_placedObjects[i];
+            m_placedObjectIds[kept] = m_placedObjectIds[i];
+            m_placedObjectHandles[kept] = m_placedObjectHandles[i];
+            m_placedObjectObstacles[kept] = m_placedObjectObstacles[i];
+            m_placedObjectOrder[kept] = m_placedObjectOrder[i];
+            m_objectIndex.setValue(m_placedObjectHandles[kept], static_cast<uint32_t>(kept));
         }
+        ++kept;
     }
-    
-    m_waterSurface->updateMesh(vertices);
+    m_placedObjects.resize(kept);
+    m_placedObjectIds.resize(kept);
+    m_placedObjectHandles.resize(kept);
+    m_placedObjectObstacles.resize(kept);
+    m_placedObjectOrder.resize(kept);
+}
+
+void SceneEditor::setPlacedObjectPosition(size_t index, const glm::vec3& position) {
+    m_placedObjects[index].second = position;
+    if (m_objectRenderer) {
+        m_objectRenderer->updateObject(m_placedObjectIds[index], position);
+    }
+    m_objectIndex.update(m_placedObjectHandles[index], position);
+    if (m_boat) {
+        m_boat->updateObstacle(m_placedObjectObstacles[index], position);
+    }
+}
+
+void SceneEditor::clearPlacedObjects() {
+    m_placedObjects.clear();
+    m_placedObjectIds.clear();
+    m_placedObjectHandles.clear();
+    m_placedObjectObstacles.clear();
+    m_placedObjectOrder.clear();
+    m_objectIndex.clear();
+    if (m_boat) {
+        m_boat->clearObstacles();
+    }
+    if (m_objectRenderer) {
+        m_objectRenderer->clear();
+    }
+}
+
+void SceneEditor::updateWaterMask() {
+    if (!m_waterSurface) return;
+    PROFILE_SCOPE("SceneEditor::updateWaterMask");
+
+    // 水面按地形类型图在片段着色器里裁剪，整张图重新上传即可，不再按格子生成网格
+    m_waterSurface->setTerrainMask(m_terrainMap, CELL_SIZE);
 }
 
 
@@ -370,9 +458,6 @@ void SceneEditor::switchMode(EditorMode mode) {
         }
         
         if (m_boat) {
-            m_boat->clearObstacles();
-            updateBoatObstacles();
-            
             m_transEndTarget = m_boat->getPosition();
             m_transEndPos = m_followCamera->getDesiredPosition();
         }
@@ -402,46 +487,41 @@ void SceneEditor::removeObjectsOnWaterExceptBoat() {
         int gx = static_cast<int>(std::floor(p.x / cell + GRID_SIZE_X / 2.0f));
         int gz = static_cast<int>(std::floor(p.z / cell + m_currentGridZ / 2.0f));
         if (gx < 0 || gx >= GRID_SIZE_X || gz < 0 || gz >= m_currentGridZ) return false;
-        return m_terrainGrid[gx][gz] == TerrainType::WATER;
-    };
-
-    auto prune = [&](std::vector<std::pair<ObjectType, glm::vec3>>& list) {
-        auto it = std::remove_if(list.begin(), list.end(), [&](const auto& obj) {
-            // 允许特定物体在水上
-            if (obj.first == ObjectType::BOAT) return false;
-            // 桥、水榭、码头、荷花池、渔船 可以在水上
-            if (obj.first == ObjectType::BRIDGE || 
-                obj.first == ObjectType::ARCH_BRIDGE ||
-                obj.first == ObjectType::WATER_PAVILION ||
-                obj.first == ObjectType::PIER ||
-                obj.first == ObjectType::LOTUS_POND ||
-                obj.first == ObjectType::FISHING_BOAT) return false;
-                
-            return isWaterCell(obj.second);
-        });
-        if (it != list.end()) {
-            list.erase(it, list.end());
-        }
+        return m_terrainMap.get(gx, gz) == TerrainType::WATER;
     };
 
-    prune(m_placedObjects);
-    // prune(m_hiddenObjects); 
+    erasePlacedObjectsIf([&](const std::pair<ObjectType, glm::vec3>& obj) {
+        // 允许特定物体在水上
+        if (obj.first == ObjectType::BOAT) return false;
+        // 桥、水榭、码头、荷花池、渔船 可以在水上
+        if (obj.first == ObjectType::BRIDGE || 
+            obj.first == ObjectType::ARCH_BRIDGE ||
+            obj.first == ObjectType::WATER_PAVILION ||
+            obj.first == ObjectType::PIER ||
+            obj.first == ObjectType::LOTUS_POND ||
+            obj.first == ObjectType::FISHING_BOAT) return false;
+            
+        return isWaterCell(obj.second);
+    });
 }
 
 void SceneEditor::placeTerrain(int gridX, int gridZ, TerrainType type) {
     if (gridX < 0 || gridX >= GRID_SIZE_X || gridZ < 0 || gridZ >= m_currentGridZ) return;
     
-    TerrainType oldType = m_terrainGrid[gridX][gridZ];
+    TerrainType oldType = m_terrainMap.get(gridX, gridZ);
     if (oldType == type) return; // 无变化
     
     // 记录撤销
     m_terrainHistory.push_back({gridX, gridZ, oldType, type});
     
-    m_terrainGrid[gridX][gridZ] = type;
+    m_terrainMap.set(gridX, gridZ, type);
+    if (m_terrainRenderer) {
+        m_terrainRenderer->markCellDirty(gridX, gridZ);
+    }
     
-    // 如果涉及水面变化，更新网格
-    if (oldType == TerrainType::WATER || type == TerrainType::WATER) {
-        updateWaterMesh();
+    // 水面遮罩只需更新这一个 texel
+    if (m_waterSurface) {
+        m_waterSurface->updateTerrainMaskCell(m_terrainMap, gridX, gridZ);
     }
     
     std::cout << "Placed terrain " << static_cast<int>(type) << " at (" << gridX << "," << gridZ << ")" << std::endl;
@@ -475,7 +555,7 @@ void SceneEditor::placeObject(ObjectType type, const glm::vec3& position) {
     gridZ = static_cast<int>(std::floor(position.z / cell + m_currentGridZ / 2.0f));
     
     if (gridX >= 0 && gridX < GRID_SIZE_X && gridZ >= 0 && gridZ < m_currentGridZ) {
-        TerrainType tType = m_terrainGrid[gridX][gridZ];
+        TerrainType tType = m_terrainMap.get(gridX, gridZ);
         bool isWater = (tType == TerrainType::WATER);
         
         if (isWater) {
@@ -489,7 +569,7 @@ void SceneEditor::placeObject(ObjectType type, const glm::vec3& position) {
     
     glm::vec3 adjustedPos = position;
     adjustedPos.y = getTerrainHeightAt(position.x, position.z);
-    m_placedObjects.push_back({type, adjustedPos});
+    addPlacedObject(type, adjustedPos);
     
     if (type == ObjectType::BOAT) {
         m_boat->setPosition(position);
@@ -499,11 +579,6 @@ void SceneEditor::placeObject(ObjectType type, const glm::vec3& position) {
         m_boatPlacedRotation = m_boat->getRotation(); // 同步当前旋转值
     }
     
-    // 游戏模式下实时更新
-    if (m_currentMode == EditorMode::GAME) {
-        updateBoatObstacles();
-    }
-    
     std::cout << "Placed object " << static_cast<int>(type) << " at " << position.x << "," << position.z << std::endl;
 }
 
@@ -523,17 +598,21 @@ void SceneEditor::undoLastAction() {
         
         if (action.isAdd) {
             // 撤销添加 -> 删除
-            // 寻找并删除该物体 (从后往前找)
-            for (auto it = m_placedObjects.rbegin(); it != m_placedObjects.rend(); ++it) {
-                if (it->first == action.type && glm::length(it->second - action.position) < 0.01f) {
-                    // 找到，删除（转换为正向迭代器）
-                    m_placedObjects.erase(std::next(it).base());
-                    break;
+            // 在空间索引中寻找该位置上同类型的物体，有多个时删除最晚放置的那个
+            m_objectIndex.queryRadius(action.position, 0.01f, m_objectQueryResult);
+            size_t found = m_placedObjects.size();
+            for (uint32_t i : m_objectQueryResult) {
+                if (m_placedObjects[i].first == action.type &&
+                    (found == m_placedObjects.size() || m_placedObjectOrder[i] > m_placedObjectOrder[found])) {
+                    found = i;
                 }
             }
+            if (found < m_placedObjects.size()) {
+                erasePlacedObject(found);
+            }
         } else {
             // 撤销删除 -> 添加
-            m_placedObjects.push_back({action.type, action.position});
+            addPlacedObject(action.type, action.position);
         }
         std::cout << "Undid object action." << std::endl;
     }
@@ -541,10 +620,13 @@ void SceneEditor::undoLastAction() {
         TerrainAction action = m_terrainHistory.back();
         m_terrainHistory.pop_back();
         
-        m_terrainGrid[action.gridX][action.gridZ] = action.oldType;
+        m_terrainMap.set(action.gridX, action.gridZ, action.oldType);
+        if (m_terrainRenderer) {
+            m_terrainRenderer->markCellDirty(action.gridX, action.gridZ);
+        }
         
-        if (action.oldType == TerrainType::WATER || action.newType == TerrainType::WATER) {
-            updateWaterMesh();
+        if (m_waterSurface) {
+            m_waterSurface->updateTerrainMaskCell(m_terrainMap, action.gridX, action.gridZ);
         }
         std::cout << "Undid terrain action." << std::endl;
     }
@@ -602,8 +684,7 @@ Camera* SceneEditor::getCurrentCamera() {
 }
 
 TerrainType SceneEditor::getTerrainAt(int gridX, int gridZ) const {
-    if (gridX < 0 || gridX >= GRID_SIZE_X || gridZ < 0 || gridZ >= m_currentGridZ) return TerrainType::EMPTY;
-    return m_terrainGrid[gridX][gridZ];
+    return m_terrainMap.at(gridX, gridZ);
 }
 
 bool SceneEditor::isWaterAt(int gridX, int gridZ) const {
@@ -640,8 +721,22 @@ float SceneEditor::getTerrainHeightAt(float worldX, float worldZ) const {
 }
 
 void SceneEditor::snapObjectsToTerrain() {
-    for (auto& obj : m_placedObjects) {
-        obj.second.y = getTerrainHeightAt(obj.second.x, obj.second.z);
+    // 高度查询只读地形，可以并行；写回会更新空间索引和渲染实例，留在主线程
+    const int count = static_cast<int>(m_placedObjects.size());
+    m_snappedHeights.resize(m_placedObjects.size());
+    JobSystem::parallelFor(0, count, SNAP_JOB_GRAIN, [this](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const glm::vec3& position = m_placedObjects[i].second;
+            m_snappedHeights[i] = getTerrainHeightAt(position.x, position.z);
+        }
+    });
+
+    for (size_t i = 0; i < m_placedObjects.size(); ++i) {
+        if (m_snappedHeights[i] != m_placedObjects[i].second.y) {
+            glm::vec3 position = m_placedObjects[i].second;
+            position.y = m_snappedHeights[i];
+            setPlacedObjectPosition(i, position);
+        }
     }
 }
 
@@ -654,20 +749,23 @@ void SceneEditor::trimBackSection() {
         float worldZ = (z - m_currentGridZ / 2.0f) * CELL_SIZE + CELL_SIZE * 0.5f;
         if (worldZ < keepMinZ) {
             for (int x = 0; x < GRID_SIZE_X; ++x) {
-                m_terrainGrid[x][z] = TerrainType::EMPTY;
+                m_terrainMap.set(x, z, TerrainType::EMPTY);
             }
         }
     }
 
     // 移除被裁剪区域的建筑
-    auto it = std::remove_if(m_placedObjects.begin(), m_placedObjects.end(),
-        [keepMinZ](const std::pair<ObjectType, glm::vec3>& obj) {
-            return obj.second.z < keepMinZ;
-        });
-    m_placedObjects.erase(it, m_placedObjects.end());
+    erasePlacedObjectsIf([keepMinZ](const std::pair<ObjectType, glm::vec3>& obj) {
+        return obj.second.z < keepMinZ;
+    });
+
+    // 整体地形已改变，所有区块都需重建
+    if (m_terrainRenderer) {
+        m_terrainRenderer->markDirty();
+    }
 
     // 更新水面
-    updateWaterMesh();
+    updateWaterMask();
 }
 
 void SceneEditor::handleGameInput(float forward, float turn) {
@@ -730,46 +828,52 @@ void SceneEditor::handleMouseClick(float screenX, float screenY, int screenWidth
 void SceneEditor::updateBoatObstacles() {
     if (!m_boat) return;
     m_boat->clearObstacles();
-    for (const auto& obj : getPlacedObjects()) {
-        float r = 1.0f;
-        if (obj.first == ObjectType::HOUSE) r = 1.5f;
-        m_boat->addObstacle(obj.second, r);
+    m_placedObjectObstacles.resize(m_placedObjects.size());
+    for (size_t i = 0; i < m_placedObjects.size(); ++i) {
+        const auto& obj = m_placedObjects[i];
+        m_placedObjectObstacles[i] = m_boat->addObstacle(obj.second, getObstacleRadius(obj.first));
     }
 }
 
 void SceneEditor::removeLastObject() {
     if (!m_placedObjects.empty()) {
-        m_placedObjects.pop_back();
-        if (m_currentMode == EditorMode::GAME) updateBoatObstacles();
+        // 交换删除会打乱列表顺序，按放置序号找最晚放置的物体
+        auto latest = std::max_element(m_placedObjectOrder.begin(), m_placedObjectOrder.end());
+        erasePlacedObject(static_cast<size_t>(latest - m_placedObjectOrder.begin()));
     }
 }
 
 bool SceneEditor::removeObjectNear(const glm::vec3& worldPos, float radius) {
-    auto& objs = m_placedObjects;
-    for (auto it = objs.begin(); it != objs.end(); ++it) {
-        if (glm::distance(glm::vec3(it->second.x, 0, it->second.z), glm::vec3(worldPos.x, 0, worldPos.z)) < radius) {
-            // 记录撤销删除
-            m_objectHistory.push_back({it->first, it->second, false}); // isAdd = false
-            
-            objs.erase(it);
-            if (m_currentMode == EditorMode::GAME) updateBoatObstacles();
-            return true;
+    m_objectIndex.queryRadius(worldPos, radius, m_objectQueryResult);
+    if (m_objectQueryResult.empty()) {
+        return false;
+    }
+    
+    // 与线性扫描保持一致：删除范围内最早放置的那个
+    size_t index = m_objectQueryResult.front();
+    for (uint32_t i : m_objectQueryResult) {
+        if (m_placedObjectOrder[i] < m_placedObjectOrder[index]) {
+            index = i;
         }
     }
-    return false;
+    const auto& obj = m_placedObjects[index];
+    // 记录撤销删除
+    m_objectHistory.push_back({obj.first, obj.second, false}); // isAdd = false
+    
+    erasePlacedObject(index);
+    return true;
 }
 
 void SceneEditor::clearAllObjects() {
-    m_placedObjects.clear();
+    clearPlacedObjects();
     m_objectHistory.clear(); 
-    if (m_currentMode == EditorMode::GAME) updateBoatObstacles();
 }
 
 void SceneEditor::clearScene() {
     clearAllObjects();
     // 恢复默认地形
     initializeTerrainLayout();
-    updateWaterMesh();
+    updateWaterMask();
     std::cout << "Scene reset." << std::endl;
 }
 
@@ -780,7 +884,7 @@ bool SceneEditor::saveScene(const std::string& filename) {
     out << GRID_SIZE_X << " " << m_currentGridZ << "\n";
     for(int i=0; i<GRID_SIZE_X; ++i) {
         for(int j=0; j<m_currentGridZ; ++j) {
-            out << (int)m_terrainGrid[i][j] << " ";
+            out << (int)m_terrainMap.get(i, j) << " ";
         }
         out << "\n";
     }
@@ -799,20 +903,20 @@ bool SceneEditor::loadScene(const std::string& filename) {
     if (sizeX != GRID_SIZE_X || sizeZ > m_currentGridZ) return false;  // 只加载兼容的
     for(int i=0; i<sizeX; ++i) {
         for(int j=0; j<sizeZ; ++j) {
-            int t; in >> t; m_terrainGrid[i][j] = (TerrainType)t;
+            int t; in >> t; m_terrainMap.set(i, j, (TerrainType)t);
         }
     }
     int count;
     in >> count;
-    m_placedObjects.clear();
+    clearPlacedObjects();
     for(int i=0; i<count; ++i) {
         int t; float x,y,z;
         in >> t >> x >> y >> z;
-        m_placedObjects.push_back({(ObjectType)t, glm::vec3(x,y,z)});
+        addPlacedObject((ObjectType)t, glm::vec3(x,y,z));
     }
     trimBackSection();
     snapObjectsToTerrain();
-    updateWaterMesh();
+    updateWaterMask();
     return true;
 }
 
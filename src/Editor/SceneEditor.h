@@ -1,9 +1,13 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <string>
+#include "../Core/TerrainMap.h"
+#include "../Core/SpatialIndex.h"
 
 namespace WaterTown {
 
@@ -14,6 +18,7 @@ class FollowCamera;
 class WaterSurface;
 class Boat;
 class ObjectRenderer;
+class TerrainRenderer;
 
 /**
  * @brief 编辑器模式枚举
@@ -24,16 +29,6 @@ enum class EditorMode {
     GAME        // 游戏模式（自由相机/追随相机）
 };
 
-/**
- * @brief 地形类型
- */
-enum class TerrainType {
-    EMPTY,      // 空地(默认) - WaterTown 特有
-    GRASS,      // 草地
-    WATER,      // 水路
-    STONE       // 石路
-};
-
 /**
  * @brief 物体类型 (已扩展至 WaterTown-sec 的 22 种)
  */
@@ -74,6 +69,8 @@ public:
     static constexpr int INITIAL_GRID_SIZE_Z = 320; // 初始Z方向尺寸
     static constexpr float CELL_SIZE = 0.5f;
     static constexpr float WATER_LEVEL = 0.0f;
+    static constexpr int OBJECT_INDEX_BUCKET_CELLS = 16;  // 物体空间索引每个桶的边长（格子数）
+    static constexpr float OBJECT_BOUNDS_RADIUS = 12.0f;  // 物体包围球半径（已含整体缩放）
 
     SceneEditor();
     ~SceneEditor();
@@ -100,11 +97,25 @@ public:
     OrbitCamera* getOrbitCamera() const { return m_orbitCamera; }
     
     /**
-     * @brief 更新编辑器
+     * @brief 固定步长模拟：船只物理和追随相机
+     * @param deltaTime 模拟步长
+     * @param simulationTime 本步结束时的模拟时钟（秒），本步的状态都属于这个时刻
      */
-    void update(float deltaTime);
+    void update(float deltaTime, float simulationTime);
     void updateBoat(float deltaTime);
     
+    /**
+     * @brief 每帧更新：相机过渡动画
+     * @param deltaTime 帧间隔
+     */
+    void updateFrame(float deltaTime);
+    
+    /**
+     * @brief 渲染前调用：追随相机在最近两个模拟步之间插值
+     * @param alpha 插值系数（Application::getInterpolationAlpha）
+     */
+    void interpolate(float alpha);
+    
     /**
      * @brief 处理鼠标输入（用于相机控制）
      */
@@ -126,6 +137,17 @@ public:
      * @brief 设置水面引用（用于船只交互）
      */
     void setWaterSurface(WaterSurface* water);
+    WaterSurface* getWaterSurface() const { return m_waterSurface; }
+    
+    /**
+     * @brief 设置地形渲染器引用（地形变化时通知其重建对应区块）
+     */
+    void setTerrainRenderer(TerrainRenderer* renderer);
+    
+    /**
+     * @brief 设置物体渲染器引用（物体增删改时同步到渲染器，只重写变化的实例）
+     */
+    void setObjectRenderer(ObjectRenderer* renderer);
     
     /**
      * @brief 更新宽高比（窗口大小改变时）
@@ -151,6 +173,11 @@ public:
      */
     TerrainType getTerrainAt(int gridX, int gridZ) const;
     
+    /**
+     * @brief 获取地形网格（按区块连续存储，供渲染器线性扫描）
+     */
+    const TerrainMap& getTerrainMap() const { return m_terrainMap; }
+    
     /**
      * @brief 获取当前选中的地形类型
      */
@@ -180,6 +207,11 @@ public:
         return m_objectsHiddenForGame ? m_hiddenObjects : m_placedObjects;
     }
     
+    /**
+     * @brief 放置物体的空间索引（查询结果为 getPlacedObjects 中的下标）
+     */
+    const SpatialIndex& getObjectIndex() const { return m_objectIndex; }
+    
     /**
      * @brief 检查指定位置是否为水域
      */
@@ -211,14 +243,18 @@ public:
     void undoLastAction();
     
     /**
-     * @brief 更新船只的障碍物碰撞体（将所有建筑物添加为障碍物）
+     * @brief 重新提交船只的全部障碍物碰撞体（将所有建筑物添加为障碍物）
+     *
+     * 平时物体增删改会增量同步到船只，此函数只在需要整体重建时使用。
      */
     void updateBoatObstacles();
     
     /**
      * @brief 更新水面遮罩 (WaterTown 特有：仅在有水的地方渲染水面)
+     *
+     * 整张地形类型图重新上传给 WaterSurface（加载 / 扩展 / 新建场景时）；单格编辑只更新对应的 texel。
      */
-    void updateWaterMesh();
+    void updateWaterMask();
     
     /**
      * @brief 删除最近放置的建筑物
@@ -334,14 +370,19 @@ private:
     // 水面引用
     WaterSurface* m_waterSurface;
     
+    // 地形渲染器引用（不持有）
+    TerrainRenderer* m_terrainRenderer;
+    
     // 船只（游戏模式）
     Boat* m_boat;
     
-    // 物体渲染器
+    // 物体渲染器引用（不持有）
     ObjectRenderer* m_objectRenderer;
 
     // 动态网格数据（简化的地形系统）
-    std::vector<std::vector<TerrainType>> m_terrainGrid;
+    TerrainMap m_terrainMap;
+    static constexpr int SNAP_JOB_GRAIN = 256;  // 每个作业贴地的物体数
+    std::vector<float> m_snappedHeights;        // snapObjectsToTerrain 的并行结果
     int m_currentGridZ;  // 当前Z方向尺寸
     
     // 河道范围
@@ -354,6 +395,13 @@ private:
     
     // 放置的物体列表
     std::vector<std::pair<ObjectType, glm::vec3>> m_placedObjects;
+    std::vector<uint32_t> m_placedObjectIds;  // 与 m_placedObjects 一一对应的渲染器句柄
+    std::vector<SpatialHandle> m_placedObjectHandles;  // 与 m_placedObjects 一一对应的空间索引句柄
+    std::vector<uint32_t> m_placedObjectObstacles;     // 与 m_placedObjects 一一对应的船只障碍物句柄
+    std::vector<uint64_t> m_placedObjectOrder;         // 与 m_placedObjects 一一对应的放置序号（删除时交换，列表不保持放置顺序）
+    uint64_t m_nextPlacementOrder;
+    SpatialIndex m_objectIndex;
+    std::vector<uint32_t> m_objectQueryResult;  // 空间查询时复用的结果缓冲
     std::vector<std::pair<ObjectType, glm::vec3>> m_hiddenObjects; // 游戏模式下隐藏的物体
     bool m_objectsHiddenForGame;
     
@@ -363,6 +411,8 @@ private:
     float m_boatPlacedRotation; // Store rotation for sync
 
     // Transition Logic
+    float m_simulationTime = 0.0f;  // 最近一次 update 的模拟时钟
+    
     bool m_isTransitioning = false;
     float m_transitionTime = 0.0f;
     float m_transitionDuration = 1.0f;
@@ -399,6 +449,16 @@ private:
     };
     std::vector<ObjectAction> m_objectHistory;
 
+    /**
+     * @brief 修改放置物体列表的唯一入口，同时把变化推送给物体渲染器
+     */
+    void addPlacedObject(ObjectType type, const glm::vec3& position);
+    void erasePlacedObject(size_t index);
+    void erasePlacedObjectsIf(const std::function<bool(const std::pair<ObjectType, glm::vec3>&)>& pred);
+    void setPlacedObjectPosition(size_t index, const glm::vec3& position);
+    void clearPlacedObjects();
+    static float getObstacleRadius(ObjectType type);
+
     std::vector<std::pair<ObjectType, glm::vec3>>& getActiveObjectList() {
         return m_objectsHiddenForGame ? m_hiddenObjects : m_placedObjects;
     }
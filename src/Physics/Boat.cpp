@@ -1,6 +1,5 @@
 #include "Boat.h"
-#include "../Water/WaterSurface.h"
-#include <GLFW/glfw3.h>
+#include "../Water/WaveModel.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
 #include <algorithm>
@@ -9,33 +8,68 @@
 namespace WaterTown {
 
 Boat::Boat(const glm::vec3& position, float rotation)
-    : m_position(position), m_lastSafePosition(position), m_hasLastSafePosition(true), m_rotation(rotation), m_speed(0.0f),
+    : m_position(position), m_lastSafePosition(position), m_hasLastSafePosition(true), m_rotation(rotation),
+      m_previousPosition(position), m_previousRotation(rotation), m_speed(0.0f),
       m_angularVelocity(0.0f), m_pitch(0.0f), m_roll(0.0f),
+      m_previousPitch(0.0f), m_previousRoll(0.0f),
       m_forwardInput(0.0f), m_turnInput(0.0f), m_hasBounds(false),
-      m_minX(-100.0f), m_maxX(100.0f), m_minZ(-100.0f), m_maxZ(100.0f) {
+      m_minX(-100.0f), m_maxX(100.0f), m_minZ(-100.0f), m_maxZ(100.0f),
+      m_obstacleIndex(OBSTACLE_BUCKET_SIZE), m_maxObstacleRadius(0.0f) {
 }
 
-void Boat::update(float deltaTime, WaterSurface* waterSurface, float currentTime) {
+void Boat::update(float deltaTime, const WaveModel* waves, float currentTime) {
+    beginStep();
+    
     // 更新运动
     glm::vec3 prevPos = m_position;
-    updateMotion(deltaTime);
+    updateMotion(deltaTime, currentTime);
     
     // 检查碰撞
     handleCollisions(prevPos);
     
     // 更新浮力和姿态
-    if (waterSurface) {
-        updateBuoyancy(waterSurface, currentTime);
+    if (waves) {
+        updateBuoyancy(waves, currentTime);
     }
 }
 
+void Boat::beginStep() {
+    m_previousPosition = m_position;
+    m_previousRotation = m_rotation;
+    m_previousPitch = m_pitch;
+    m_previousRoll = m_roll;
+}
+
+glm::vec3 Boat::getInterpolatedPosition(float alpha) const {
+    return glm::mix(m_previousPosition, m_position, alpha);
+}
+
+float Boat::getInterpolatedRotation(float alpha) const {
+    // 沿最短弧插值，避免跨过 0/360 时转一整圈
+    float delta = m_rotation - m_previousRotation;
+    if (delta > 180.0f) delta -= 360.0f;
+    if (delta < -180.0f) delta += 360.0f;
+    float rotation = m_previousRotation + delta * alpha;
+    if (rotation < 0.0f) rotation += 360.0f;
+    if (rotation >= 360.0f) rotation -= 360.0f;
+    return rotation;
+}
+
+float Boat::getInterpolatedPitch(float alpha) const {
+    return m_previousPitch + (m_pitch - m_previousPitch) * alpha;
+}
+
+float Boat::getInterpolatedRoll(float alpha) const {
+    return m_previousRoll + (m_roll - m_previousRoll) * alpha;
+}
+
 void Boat::processInput(float forward, float turn) {
     // 手动实现 clamp (C++14 没有 std::clamp)
     m_forwardInput = std::max(-1.0f, std::min(forward, 1.0f));
     m_turnInput = std::max(-1.0f, std::min(turn, 1.0f));
 }
 
-void Boat::updateMotion(float deltaTime) {
+void Boat::updateMotion(float deltaTime, float currentTime) {
     // 目标速度（油门）+ 平滑响应
     float targetSpeed = m_forwardInput * MAX_SPEED;
     float throttleLerp = 1.0f - std::exp(-THROTTLE_SMOOTH * deltaTime);
@@ -74,15 +108,15 @@ void Boat::updateMotion(float deltaTime) {
     
     // 轻微的左右摇晃（前进时）
     if (std::abs(m_speed) > 0.1f) {
-        float wobble = sin(glfwGetTime() * 2.0f) * 0.01f * speedFactor;
+        float wobble = sin(currentTime * 2.0f) * 0.01f * speedFactor;
         m_roll = wobble * 2.0f;  // 度
     } else {
         m_roll *= 0.95f;  // 平滑归零
     }
 }
 
-void Boat::updateBuoyancy(WaterSurface* waterSurface, float currentTime) {
-    if (!waterSurface) return;
+void Boat::updateBuoyancy(const WaveModel* waves, float currentTime) {
+    if (!waves) return;
     
     // 在船头、船尾、左侧、右侧采样水面高度
     float rotRad = glm::radians(m_rotation);
@@ -95,10 +129,15 @@ void Boat::updateBuoyancy(WaterSurface* waterSurface, float currentTime) {
     glm::vec3 portSide = m_position - right * (BOAT_WIDTH * 0.5f);    // 左舷
     glm::vec3 starboard = m_position + right * (BOAT_WIDTH * 0.5f);   // 右舷
     
-    float heightBow = sampleWaterHeight(bow, waterSurface, currentTime);
-    float heightStern = sampleWaterHeight(stern, waterSurface, currentTime);
-    float heightPort = sampleWaterHeight(portSide, waterSurface, currentTime);
-    float heightStarboard = sampleWaterHeight(starboard, waterSurface, currentTime);
+    // 四个采样点一次批量查询（正好一组 SSE）
+    float xs[4] = {bow.x, stern.x, portSide.x, starboard.x};
+    float zs[4] = {bow.z, stern.z, portSide.z, starboard.z};
+    float heights[4];
+    waves->getWaterHeights(xs, zs, heights, 4, currentTime);
+    float heightBow = heights[0];
+    float heightStern = heights[1];
+    float heightPort = heights[2];
+    float heightStarboard = heights[3];
     
     // 船体中心高度（平均值）
     float avgHeight = (heightBow + heightStern + heightPort + heightStarboard) / 4.0f;
@@ -115,21 +154,46 @@ void Boat::updateBuoyancy(WaterSurface* waterSurface, float currentTime) {
     m_roll = m_roll * 0.5f + waterRoll * 0.5f;  // 混合水波和运动摇晃
 }
 
-float Boat::sampleWaterHeight(const glm::vec3& worldPos, WaterSurface* waterSurface, float time) const {
-    return waterSurface->getWaterHeight(worldPos.x, worldPos.z, time);
+ObstacleHandle Boat::addObstacle(const glm::vec3& position, float radius) {
+    ObstacleHandle handle;
+    if (!m_freeObstacles.empty()) {
+        handle = m_freeObstacles.back();
+        m_freeObstacles.pop_back();
+    } else {
+        handle = static_cast<ObstacleHandle>(m_obstacles.size());
+        m_obstacles.push_back(Obstacle());
+    }
+    
+    // 索引中记录的值就是障碍物句柄
+    m_obstacles[handle] = {position, radius, m_obstacleIndex.insert(position, radius, handle), true};
+    m_maxObstacleRadius = std::max(m_maxObstacleRadius, radius);
+    return handle;
+}
+
+void Boat::updateObstacle(ObstacleHandle handle, const glm::vec3& position) {
+    if (handle >= m_obstacles.size() || !m_obstacles[handle].alive) return;
+    m_obstacles[handle].position = position;
+    m_obstacleIndex.update(m_obstacles[handle].indexHandle, position);
 }
 
-void Boat::addObstacle(const glm::vec3& position, float radius) {
-    m_obstacles.push_back({position, radius});
+void Boat::removeObstacle(ObstacleHandle handle) {
+    if (handle >= m_obstacles.size() || !m_obstacles[handle].alive) return;
+    m_obstacles[handle].alive = false;
+    m_obstacleIndex.remove(m_obstacles[handle].indexHandle);
+    m_freeObstacles.push_back(handle);
 }
 
 void Boat::clearObstacles() {
     m_obstacles.clear();
+    m_freeObstacles.clear();
+    m_obstacleIndex.clear();
+    m_maxObstacleRadius = 0.0f;
 }
 
-void Boat::syncToWaterSurface(WaterSurface* waterSurface, float currentTime) {
-    if (!waterSurface) return;
-    updateBuoyancy(waterSurface, currentTime);
+void Boat::syncToWaterSurface(const WaveModel* waves, float currentTime) {
+    if (!waves) return;
+    beginStep();
+    updateBuoyancy(waves, currentTime);
 }
 
 void Boat::handleCollisions(const glm::vec3& prevPosition) {
@@ -205,7 +269,18 @@ void Boat::handleCollisions(const glm::vec3& prevPosition) {
     }
     
     // 障碍物碰撞检测（圆形碰撞）
-    for (const auto& obstacle : m_obstacles) {
+    // 宽阶段：只取本步扫掠范围附近的障碍物；额外留出一个船半径，容纳推开造成的位移
+    float reach = BOAT_RADIUS * 2.0f + m_maxObstacleRadius;
+    glm::vec3 sweepMin(std::min(prevPosition.x, m_position.x) - reach, -1e30f,
+                       std::min(prevPosition.z, m_position.z) - reach);
+    glm::vec3 sweepMax(std::max(prevPosition.x, m_position.x) + reach, 1e30f,
+                       std::max(prevPosition.z, m_position.z) + reach);
+    m_obstacleIndex.queryAABB(sweepMin, sweepMax, m_obstacleCandidates);
+    // 按添加顺序处理，与逐个遍历时的推开顺序一致
+    std::sort(m_obstacleCandidates.begin(), m_obstacleCandidates.end());
+    
+    for (uint32_t candidate : m_obstacleCandidates) {
+        const Obstacle& obstacle = m_obstacles[candidate];
         glm::vec3 diff = m_position - obstacle.position;
         diff.y = 0.0f;  // 只检测水平方向
         float distance = glm::length(diff);
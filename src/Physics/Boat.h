@@ -1,12 +1,14 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 #include <functional>
+#include "../Core/SpatialIndex.h"
 
 namespace WaterTown {
 
-class WaterSurface;
+class WaveModel;
 
 /**
  * @brief 障碍物结构体
@@ -14,8 +16,16 @@ class WaterSurface;
 struct Obstacle {
     glm::vec3 position;
     float radius;
+    SpatialHandle indexHandle;  // 在宽阶段索引中的句柄
+    bool alive;
 };
 
+/**
+ * @brief 障碍物句柄
+ */
+using ObstacleHandle = uint32_t;
+constexpr ObstacleHandle INVALID_OBSTACLE_HANDLE = 0xFFFFFFFFu;
+
 /**
  * @brief 船只物理模拟类
  */
@@ -30,11 +40,11 @@ public:
     
     /**
      * @brief 更新船只物理
-     * @param deltaTime 帧时间
-     * @param waterSurface 水面引用（用于浮力计算）
-     * @param currentTime 当前时间
+     * @param deltaTime 模拟步长
+     * @param waves 波浪模型（用于浮力计算）
+     * @param currentTime 模拟时钟（秒）
      */
-    void update(float deltaTime, WaterSurface* waterSurface, float currentTime);
+    void update(float deltaTime, const WaveModel* waves, float currentTime);
     
     /**
      * @brief 处理输入控制
@@ -53,6 +63,12 @@ public:
      */
     float getRotation() const { return m_rotation; }
     
+    /**
+     * @brief 渲染用的插值位置/朝向（在上一步和当前步之间，alpha ∈ [0, 1]）
+     */
+    glm::vec3 getInterpolatedPosition(float alpha) const;
+    float getInterpolatedRotation(float alpha) const;
+    
     /**
      * @brief 获取速度
      */
@@ -65,14 +81,20 @@ public:
     float getRoll() const { return m_roll; }
     
     /**
-     * @brief 设置位置
+     * @brief 渲染用的插值倾斜角度（在上一步和当前步之间，alpha ∈ [0, 1]）
      */
-    void setPosition(const glm::vec3& position) { m_position = position; }
+    float getInterpolatedPitch(float alpha) const;
+    float getInterpolatedRoll(float alpha) const;
     
     /**
-     * @brief 设置旋转
+     * @brief 设置位置（瞬移，同时清除插值历史）
      */
-    void setRotation(float rotation) { m_rotation = rotation; }
+    void setPosition(const glm::vec3& position) { m_position = position; m_previousPosition = position; }
+    
+    /**
+     * @brief 设置旋转（同时清除插值历史）
+     */
+    void setRotation(float rotation) { m_rotation = rotation; m_previousRotation = rotation; }
 
     /**
      * @brief 设置速度
@@ -96,16 +118,19 @@ public:
      * @brief 添加障碍物（简化版：圆形碰撞体）
      * @param position 障碍物位置
      * @param radius 障碍物半径
+     * @return 障碍物句柄，用于之后的更新和删除
      */
-    void addObstacle(const glm::vec3& position, float radius);
+    ObstacleHandle addObstacle(const glm::vec3& position, float radius);
+    void updateObstacle(ObstacleHandle handle, const glm::vec3& position);
+    void removeObstacle(ObstacleHandle handle);
     void clearObstacles();
 
     /**
      * @brief 仅根据水面高度同步船的姿态（用于非游戏模式）
-     * @param waterSurface 水面引用
-     * @param currentTime 当前时间
+     * @param waves 波浪模型
+     * @param currentTime 模拟时钟（秒）
      */
-    void syncToWaterSurface(WaterSurface* waterSurface, float currentTime);
+    void syncToWaterSurface(const WaveModel* waves, float currentTime);
 
     // 碰撞检测回调：输入世界坐标 (x, z)，返回 true 表示该位置安全（水域），false 表示碰撞（陆地）
     using CollisionPredicate = std::function<bool(float x, float z)>;
@@ -117,12 +142,16 @@ private:
     glm::vec3 m_lastSafePosition; // 最近一次安全水域位置
     bool m_hasLastSafePosition = false;
     float m_rotation;           // 旋转（Y 轴，度）
+    glm::vec3 m_previousPosition; // 上一步的位置（渲染插值用）
+    float m_previousRotation;     // 上一步的旋转
     float m_speed;              // 速度（m/s）
     float m_angularVelocity;    // 角速度（度/s）
     
     // 船体姿态
     float m_pitch;              // 俯仰角
     float m_roll;               // 翻滚角
+    float m_previousPitch;      // 上一步的俯仰角（渲染插值用）
+    float m_previousRoll;       // 上一步的翻滚角
     
     // 控制参数
     float m_forwardInput;       // 前进输入
@@ -142,27 +171,32 @@ private:
     const float BOAT_WIDTH = 0.4f;          // 船宽
     const float BOAT_RADIUS = 0.5f;         // 碰撞半径
     const float BOAT_WATERLINE_OFFSET = 0.45f; // 船身水线偏移（大幅提高以避免进水）
+    static constexpr float OBSTACLE_BUCKET_SIZE = 4.0f; // 障碍物空间索引的桶边长
     
     // 边界和碰撞
     bool m_hasBounds;
     float m_minX, m_maxX, m_minZ, m_maxZ;
-    std::vector<Obstacle> m_obstacles;
+    std::vector<Obstacle> m_obstacles;           // 下标即句柄
+    std::vector<ObstacleHandle> m_freeObstacles; // 可复用的句柄
+    SpatialIndex m_obstacleIndex;                // 障碍物宽阶段：按圆心分桶
+    float m_maxObstacleRadius;
+    std::vector<uint32_t> m_obstacleCandidates;  // 每步复用的候选缓冲
     CollisionPredicate m_collisionPredicate;
     
     /**
      * @brief 更新运动
      */
-    void updateMotion(float deltaTime);
+    void updateMotion(float deltaTime, float currentTime);
     
     /**
-     * @brief 更新浮力和姿态
+     * @brief 模拟步开始时保存当前状态，供渲染插值
      */
-    void updateBuoyancy(WaterSurface* waterSurface, float currentTime);
+    void beginStep();
     
     /**
-     * @brief 计算采样点的水面高度
+     * @brief 更新浮力和姿态
      */
-    float sampleWaterHeight(const glm::vec3& worldPos, WaterSurface* waterSurface, float time) const;
+    void updateBuoyancy(const WaveModel* waves, float currentTime);
     
     /**
      * @brief 检查并处理碰撞
@@ -2,6 +2,8 @@
 #include "ModelLoader.h"
 #include "Shader.h"
 #include "Camera.h"
+#include "GLState.h"
+#include "GLCounters.h"
 #include "../Physics/Boat.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
@@ -191,30 +193,28 @@ glm::vec2 BoatRenderer::getWaterCutoutHalfExtentsXZ(float extraMargin) const {
     return halfExt;
 }
 
-void BoatRenderer::render(const Boat* boat, Shader* shader, Camera* camera) {
+void BoatRenderer::render(const Boat* boat, Shader* shader, Camera* camera, float alpha) {
     if (!boat || !shader || !camera || !m_boatMesh) {
         return;
     }
     
+    // 船只变体：统一颜色，带底部色调，无整体缩放
+    if (shader != m_variantSource) {
+        m_variantSource = shader;
+        m_shaderVariant = shader->getVariant({"VARIANT_INSTANCING 0", "VARIANT_OBJECT_SCALE 0",
+                                              "VARIANT_VERTEX_COLOR 0", "VARIANT_BOTTOM_TINT 1"});
+    }
+    shader = m_shaderVariant;
     shader->use();
-    shader->setBool("uUseObjectScale", false);
-    shader->setFloat("uObjectScale", 1.0f);
-    shader->setVec3("uObjectScaleOrigin", boat->getPosition());
-    shader->setVec3("uLightDir", -0.3f, -1.0f, -0.2f);
-    shader->setVec3("uLightColor", 1.0f, 0.98f, 0.95f);
-    shader->setVec3("uSkyColor", 0.6f, 0.75f, 0.95f);
-    shader->setVec3("uGroundColor", 0.35f, 0.3f, 0.25f);
-    shader->setFloat("uAmbientStrength", 0.35f);
-    shader->setBool("uUseFog", true);
-    shader->setVec3("uFogColor", 0.7f, 0.8f, 0.9f);
-    shader->setFloat("uFogDensity", 0.0025f);
     shader->setVec3("uBottomTintColor", 0.2f, 0.45f, 0.65f);
     shader->setFloat("uBottomTintStrength", 0.6f);
     
     // 获取船只位置和旋转
-    glm::vec3 position = boat->getPosition();
+    glm::vec3 position = boat->getInterpolatedPosition(alpha);
     position.y += kFixedExtraLift;
-    float rotation = boat->getRotation();
+    float rotation = boat->getInterpolatedRotation(alpha);
+    float pitch = boat->getInterpolatedPitch(alpha);
+    float roll = boat->getInterpolatedRoll(alpha);
     
     // 构建模型矩阵（正确的变换顺序：平移 -> 旋转 -> 缩放）
     glm::mat4 model = glm::mat4(1.0f);
@@ -222,9 +222,15 @@ void BoatRenderer::render(const Boat* boat, Shader* shader, Camera* camera) {
     // 1. 平移到世界坐标（使用物理计算的 Y 坐标，已包含水面高度 + 1.2f）
     model = glm::translate(model, position);
     
-    // 2. 绕 Y 轴旋转 (添加 +180° 使模型船头与物理运动方向一致)
+    // 2. 绕 Y 轴旋转，再在船体坐标系（+Z 船头，+X 右舷）里施加俯仰和翻滚：
+    //    俯仰为正时船头抬起，翻滚为正时右舷抬起
+    model = glm::rotate(model, glm::radians(rotation), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(-pitch), glm::vec3(1.0f, 0.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(roll), glm::vec3(0.0f, 0.0f, 1.0f));
+
+    // 2.5 再转 180° 使模型船头与物理运动方向一致
     // 物理上 rotation=0° 船向 +Z 移动，但自动轴校正后模型船头朝 -Z
-    model = glm::rotate(model, glm::radians(rotation + 180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 
     // 3. 缩放模型（统一缩放）
     const glm::vec3 scale(0.75f, 0.75f, 0.75f);
@@ -251,17 +257,12 @@ void BoatRenderer::render(const Boat* boat, Shader* shader, Camera* camera) {
     
     // 设置着色器 uniform
     shader->setMat4("uModel", model);
-    shader->setMat4("uView", camera->getViewMatrix());
-    shader->setMat4("uProjection", camera->getProjectionMatrix());
-    shader->setVec3("uViewPos", camera->getPosition());
-    shader->setVec3("uLightPos", 10.0f, 10.0f, 10.0f);
-    shader->setVec3("uLightColor", 1.0f, 1.0f, 1.0f);
     shader->setVec3("uObjectColor", 0.6f, 0.4f, 0.2f);  // 棕色
     
     // 渲染网格
-    glBindVertexArray(m_boatMesh->VAO);
-    glDrawElements(GL_TRIANGLES, m_boatMesh->indices.size(), GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    GLState::bindVertexArray(m_boatMesh->VAO);
+    GLCounters::drawElements(GL_TRIANGLES, static_cast<GLsizei>(m_boatMesh->indices.size()), GL_UNSIGNED_INT, 0);
+    GLState::bindVertexArray(0);
 }
 
 } // namespace WaterTown
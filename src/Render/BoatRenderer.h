@@ -23,8 +23,9 @@ public:
      * @param boat 船只对象
      * @param shader 着色器
      * @param camera 相机
+     * @param alpha 模拟步之间的插值系数（1 表示使用最新状态）
      */
-    void render(const Boat* boat, Shader* shader, Camera* camera);
+    void render(const Boat* boat, Shader* shader, Camera* camera, float alpha = 1.0f);
 
     // 为水面裁剪提供“贴合船体”的参数（OBB 矩形），用于避免第1/2模式下船板/船舱看到水。
     // 返回值为 world-space 半长半宽（XZ 平面），已考虑渲染侧统一缩放。
@@ -49,6 +50,10 @@ private:
     // 固定参数（来自你截图中的 UI 设定）
     static constexpr float kFixedSubmergeRatio = 0.106f;
     static constexpr float kFixedExtraLift = 0.0f;
+
+    // 本渲染器使用的着色器变体（基础着色器变化时重新获取）
+    Shader* m_variantSource = nullptr;
+    Shader* m_shaderVariant = nullptr;
     
     /**
      * @brief 加载 boat.glb 模型
@@ -3,7 +3,10 @@
 namespace WaterTown {
 
 FollowCamera::FollowCamera(float fov, float aspectRatio)
-    : m_position(0.0f), m_targetPos(0.0f), m_targetRotation(0.0f),
+    : m_position(0.0f), m_targetPos(0.0f),
+      m_previousPosition(0.0f), m_previousTargetPos(0.0f), m_stepTargetPos(0.0f),
+      m_renderPosition(0.0f), m_renderTargetPos(0.0f),
+      m_targetRotation(0.0f),
     m_offset(0.0f, 3.0f, -14.0f),  // 默认：降低视角形成仰视感
       m_smoothSpeed(5.0f),
       m_yawOffset(0.0f), m_pitchOffset(0.0f), // 初始化
@@ -13,7 +16,7 @@ FollowCamera::FollowCamera(float fov, float aspectRatio)
 
 glm::mat4 FollowCamera::getViewMatrix() const {
     // 相机看向目标点
-    return glm::lookAt(m_position, m_targetPos, glm::vec3(0.0f, 1.0f, 0.0f));
+    return glm::lookAt(m_renderPosition, m_renderTargetPos, glm::vec3(0.0f, 1.0f, 0.0f));
 }
 
 glm::mat4 FollowCamera::getProjectionMatrix() const {
@@ -21,11 +24,17 @@ glm::mat4 FollowCamera::getProjectionMatrix() const {
 }
 
 void FollowCamera::setPosition(const glm::vec3& position) {
+    // 直接跳到新位置：清除插值历史
     m_position = position;
+    m_previousPosition = position;
+    m_renderPosition = position;
+    m_stepTargetPos = m_targetPos;
+    m_previousTargetPos = m_targetPos;
+    m_renderTargetPos = m_targetPos;
 }
 
 glm::vec3 FollowCamera::getPosition() const {
-    return m_position;
+    return m_renderPosition;
 }
 
 void FollowCamera::setTarget(const glm::vec3& targetPosition, float targetRotation) {
@@ -34,12 +43,24 @@ void FollowCamera::setTarget(const glm::vec3& targetPosition, float targetRotati
 }
 
 void FollowCamera::update(float deltaTime) {
+    m_previousPosition = m_position;
+    m_previousTargetPos = m_stepTargetPos;
+    
     // 计算期望位置
     glm::vec3 desiredPosition = getDesiredPosition();
     
     // 平滑插值
     float t = 1.0f - exp(-m_smoothSpeed * deltaTime);
     m_position = glm::mix(m_position, desiredPosition, t);
+    m_stepTargetPos = m_targetPos;
+    
+    m_renderPosition = m_position;
+    m_renderTargetPos = m_targetPos;
+}
+
+void FollowCamera::interpolate(float alpha) {
+    m_renderPosition = glm::mix(m_previousPosition, m_position, alpha);
+    m_renderTargetPos = glm::mix(m_previousTargetPos, m_stepTargetPos, alpha);
 }
 
 void FollowCamera::rotate(float deltaYaw, float deltaPitch) {
@@ -37,11 +37,17 @@ public:
     glm::vec3 getTarget() const { return m_targetPos; }
     
     /**
-     * @brief 更新相机（平滑跟随）
-     * @param deltaTime 帧时间
+     * @brief 更新相机（平滑跟随），每个模拟步调用一次
+     * @param deltaTime 模拟步长
      */
     void update(float deltaTime);
     
+    /**
+     * @brief 在上一步和当前步的结果之间插值，得到本帧渲染用的位置和目标点
+     * @param alpha 插值系数 [0, 1]
+     */
+    void interpolate(float alpha);
+    
     /**
      * @brief 设置相机偏移（相对于目标的位置）
      * @param offset 偏移量（局部坐标系）
@@ -78,6 +84,13 @@ public:
 private:
     glm::vec3 m_position;           // 当前相机位置
     glm::vec3 m_targetPos;          // 目标位置
+    
+    // 渲染插值：上一步的状态和本帧使用的状态
+    glm::vec3 m_previousPosition;
+    glm::vec3 m_previousTargetPos;
+    glm::vec3 m_stepTargetPos;      // 最近一次 update 时的目标位置
+    glm::vec3 m_renderPosition;
+    glm::vec3 m_renderTargetPos;
     float m_targetRotation;         // 目标旋转
     
     glm::vec3 m_offset;             // 相机偏移（局部坐标）
@@ -0,0 +1,107 @@
+#include "GLCounters.h"
+#include <cstring>
+#include <utility>
+
+namespace WaterTown {
+
+namespace {
+
+GLFrameCounters g_frame;
+GLFrameCounters g_lastFrame;
+std::vector<GLPassCounters> g_passes;
+std::vector<GLPassCounters> g_lastPasses;
+
+#if WATERTOWN_GL_COUNTERS_ENABLED
+std::vector<size_t> g_passStack;  // 打开的 pass（g_passes 下标）
+
+uint64_t trianglesFor(GLenum mode, GLsizei count) {
+    switch (mode) {
+        case GL_TRIANGLES: return static_cast<uint64_t>(count / 3);
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN: return count > 2 ? static_cast<uint64_t>(count - 2) : 0;
+        default: return 0;
+    }
+}
+
+// 同一计数同时记到整帧和当前 pass
+template <typename Fn>
+void record(Fn apply) {
+    apply(g_frame);
+    if (!g_passStack.empty()) {
+        apply(g_passes[g_passStack.back()].counters);
+    }
+}
+#endif
+
+} // namespace
+
+#if WATERTOWN_GL_COUNTERS_ENABLED
+void GLCounters::recordDraw(GLenum mode, GLsizei count, GLsizei instanceCount) {
+    const uint64_t triangles = trianglesFor(mode, count) * static_cast<uint64_t>(instanceCount);
+    record([triangles](GLFrameCounters& c) {
+        ++c.drawCalls;
+        c.triangles += triangles;
+    });
+}
+
+void GLCounters::recordUpload(uint64_t bytes) {
+    record([bytes](GLFrameCounters& c) {
+        ++c.bufferUploads;
+        c.bufferBytes += bytes;
+    });
+}
+
+void GLCounters::recordUniform() {
+    record([](GLFrameCounters& c) { ++c.uniformCalls; });
+}
+
+void GLCounters::recordBind() {
+    record([](GLFrameCounters& c) { ++c.bindCalls; });
+}
+
+void GLCounters::pushPass(const char* name) {
+    // 同名 pass 在一帧内多次出现时合并（例如每个区块一次的子区间）
+    size_t index = g_passes.size();
+    for (size_t i = 0; i < g_passes.size(); ++i) {
+        if (g_passes[i].name == name || std::strcmp(g_passes[i].name, name) == 0) {
+            index = i;
+            break;
+        }
+    }
+    if (index == g_passes.size()) {
+        g_passes.push_back({name, GLFrameCounters()});
+    }
+    g_passStack.push_back(index);
+}
+
+void GLCounters::popPass() {
+    if (!g_passStack.empty()) {
+        g_passStack.pop_back();
+    }
+}
+#endif
+
+void GLCounters::beginFrame() {
+    g_lastFrame = g_frame;
+    g_frame = GLFrameCounters();
+    // 交换而不是拷贝，保留容量供下一帧复用
+    std::swap(g_lastPasses, g_passes);
+    g_passes.clear();
+#if WATERTOWN_GL_COUNTERS_ENABLED
+    g_passStack.clear();
+#endif
+}
+
+const GLFrameCounters& GLCounters::getLastFrame() {
+    return g_lastFrame;
+}
+
+const std::vector<GLPassCounters>& GLCounters::getLastFramePasses() {
+    return g_lastPasses;
+}
+
+const GLFrameCounters& GLCounters::getFrame() {
+    return g_frame;
+}
+
+} // namespace WaterTown
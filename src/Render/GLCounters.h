@@ -0,0 +1,154 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+// 计数默认只在调试构建中启用；发布构建需要统计（例如跑基准测试）时定义 WATERTOWN_GL_COUNTERS
+#if defined(WATERTOWN_GL_COUNTERS) || !defined(NDEBUG)
+#define WATERTOWN_GL_COUNTERS_ENABLED 1
+#else
+#define WATERTOWN_GL_COUNTERS_ENABLED 0
+#endif
+
+namespace WaterTown {
+
+/**
+ * @brief 一段时间内提交给 GL 的工作量
+ */
+struct GLFrameCounters {
+    uint32_t drawCalls = 0;      // glDraw* 调用次数
+    uint64_t triangles = 0;      // 提交的三角形数（已乘实例数）
+    uint32_t bufferUploads = 0;  // glBufferData / glBufferSubData / glTex(Sub)Image2D 调用次数
+    uint64_t bufferBytes = 0;    // 上传的字节数
+    uint32_t uniformCalls = 0;   // glUniform* 调用次数
+    uint32_t bindCalls = 0;      // 实际下发的程序 / VAO / 缓冲绑定（GLState 跳过的不算）
+};
+
+/**
+ * @brief 一个渲染 pass 的计数
+ */
+struct GLPassCounters {
+    const char* name;            // pass 名（静态字符串）
+    GLFrameCounters counters;    // 只计入该 pass 自身，不含嵌套的子 pass
+};
+
+/**
+ * @brief GL 调用计数层
+ *
+ * 包装项目用到的 glDraw*、glBufferData/glBufferSubData 和 glTexImage2D/glTexSubImage2D，在转发给驱动的同时累计统计；
+ * uniform 由 Shader 上报，绑定由 GLState 上报。统计按帧归档，并按 pass 细分——
+ * pass 与 PROFILE_GPU_SCOPE 标记的区间一致。
+ *
+ * 未启用时（见 WATERTOWN_GL_COUNTERS_ENABLED）所有记录函数都是空的内联函数，
+ * 包装函数只剩下对应的 GL 调用，不产生任何额外开销。
+ */
+class GLCounters {
+public:
+    static constexpr bool ENABLED = WATERTOWN_GL_COUNTERS_ENABLED != 0;
+
+    // 绘制
+    static void drawArrays(GLenum mode, GLint first, GLsizei count) {
+        recordDraw(mode, count, 1);
+        glDrawArrays(mode, first, count);
+    }
+    static void drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount) {
+        recordDraw(mode, count, instanceCount);
+        glDrawArraysInstanced(mode, first, count, instanceCount);
+    }
+    static void drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+        recordDraw(mode, count, 1);
+        glDrawElements(mode, count, type, indices);
+    }
+    static void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices,
+                                      GLsizei instanceCount) {
+        recordDraw(mode, count, instanceCount);
+        glDrawElementsInstanced(mode, count, type, indices, instanceCount);
+    }
+
+    // 缓冲上传
+    static void bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        // 不带数据的分配不算上传
+        recordUpload(data ? static_cast<uint64_t>(size) : 0);
+        glBufferData(target, size, data, usage);
+    }
+    static void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+        recordUpload(static_cast<uint64_t>(size));
+        glBufferSubData(target, offset, size, data);
+    }
+
+    // 纹理上传（GL_TEXTURE_2D，作用于当前纹理单元上绑定的纹理）
+    static void texImage2D(GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLenum format,
+                           GLenum type, const void* data) {
+        recordUpload(data ? textureBytes(width, height, format, type) : 0);
+        glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, format, type, data);
+    }
+    static void texSubImage2D(GLint level, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format,
+                              GLenum type, const void* data) {
+        recordUpload(textureBytes(width, height, format, type));
+        glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, format, type, data);
+    }
+
+#if WATERTOWN_GL_COUNTERS_ENABLED
+    static void recordDraw(GLenum mode, GLsizei count, GLsizei instanceCount);
+    static void recordUpload(uint64_t bytes);
+    static void recordUniform();
+    static void recordBind();
+
+    /**
+     * @brief pass 边界（由 ProfileScope 调用，可以嵌套）
+     */
+    static void pushPass(const char* name);
+    static void popPass();
+#else
+    static void recordDraw(GLenum, GLsizei, GLsizei) {}
+    static void recordUpload(uint64_t) {}
+    static void recordUniform() {}
+    static void recordBind() {}
+    static void pushPass(const char*) {}
+    static void popPass() {}
+#endif
+
+    /**
+     * @brief 帧开始时调用：保存上一帧的统计并清零
+     */
+    static void beginFrame();
+
+    /**
+     * @brief 上一帧的统计（未启用时全为 0）
+     */
+    static const GLFrameCounters& getLastFrame();
+
+    /**
+     * @brief 上一帧各 pass 的统计，按首次进入的顺序排列
+     */
+    static const std::vector<GLPassCounters>& getLastFramePasses();
+
+    /**
+     * @brief 当前帧到目前为止的统计
+     */
+    static const GLFrameCounters& getFrame();
+
+private:
+    /**
+     * @brief 客户端像素数据的字节数（只处理项目用到的格式和类型）
+     */
+    static uint64_t textureBytes(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+        uint64_t components = 4;
+        switch (format) {
+            case GL_RED: case GL_RED_INTEGER: components = 1; break;
+            case GL_RG: case GL_RG_INTEGER: components = 2; break;
+            case GL_RGB: case GL_RGB_INTEGER: components = 3; break;
+            default: break;
+        }
+        uint64_t componentBytes = 4;
+        switch (type) {
+            case GL_UNSIGNED_BYTE: case GL_BYTE: componentBytes = 1; break;
+            case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: componentBytes = 2; break;
+            default: break;
+        }
+        return static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * components * componentBytes;
+    }
+};
+
+} // namespace WaterTown
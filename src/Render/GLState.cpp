@@ -0,0 +1,216 @@
+#include "GLState.h"
+#include "GLCounters.h"
+#include <algorithm>
+#include <iterator>
+
+namespace WaterTown {
+
+namespace {
+
+const GLuint UNKNOWN_NAME = 0xFFFFFFFFu;  // 未知的绑定（不会与真实对象名冲突）
+const GLenum UNKNOWN_ENUM = 0;
+const int8_t UNKNOWN_FLAG = -1;
+
+struct CachedState {
+    CachedState() { std::fill(std::begin(textures), std::end(textures), UNKNOWN_NAME); }
+
+    GLuint program = UNKNOWN_NAME;
+    GLuint vertexArray = UNKNOWN_NAME;
+    GLuint arrayBuffer = UNKNOWN_NAME;
+    GLuint uniformBuffer = UNKNOWN_NAME;
+    GLenum activeTexture = UNKNOWN_ENUM;
+    GLuint textures[GLState::MAX_TEXTURE_UNITS];  // 各纹理单元上的 GL_TEXTURE_2D
+
+    int8_t blend = UNKNOWN_FLAG;
+    GLenum blendSrc = UNKNOWN_ENUM;
+    GLenum blendDst = UNKNOWN_ENUM;
+    int8_t depthTest = UNKNOWN_FLAG;
+    int8_t depthMask = UNKNOWN_FLAG;
+    GLenum depthFunc = UNKNOWN_ENUM;
+    int8_t cullFace = UNKNOWN_FLAG;
+};
+
+CachedState g_state;
+GLStateStats g_frameStats;
+GLStateStats g_lastFrameStats;
+
+// 值未变化时计为跳过并返回 false；否则更新缓存并返回 true
+template <typename T>
+bool changeState(T& cached, T value) {
+    if (cached == value) {
+        ++g_frameStats.skipped;
+        return false;
+    }
+    cached = value;
+    ++g_frameStats.issued;
+    return true;
+}
+
+GLuint* cachedBufferSlot(GLenum target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER: return &g_state.arrayBuffer;
+        case GL_UNIFORM_BUFFER: return &g_state.uniformBuffer;
+        default: return nullptr;
+    }
+}
+
+void setCapability(int8_t& cached, GLenum capability, bool enabled) {
+    if (changeState(cached, static_cast<int8_t>(enabled ? 1 : 0))) {
+        if (enabled) {
+            glEnable(capability);
+        } else {
+            glDisable(capability);
+        }
+    }
+}
+
+} // namespace
+
+void GLState::useProgram(GLuint program) {
+    if (changeState(g_state.program, program)) {
+        GLCounters::recordBind();
+        glUseProgram(program);
+    }
+}
+
+void GLState::bindVertexArray(GLuint vao) {
+    if (changeState(g_state.vertexArray, vao)) {
+        GLCounters::recordBind();
+        glBindVertexArray(vao);
+    }
+}
+
+void GLState::bindBuffer(GLenum target, GLuint buffer) {
+    GLuint* slot = cachedBufferSlot(target);
+    if (!slot) {
+        ++g_frameStats.issued;
+        GLCounters::recordBind();
+        glBindBuffer(target, buffer);
+        return;
+    }
+    if (changeState(*slot, buffer)) {
+        GLCounters::recordBind();
+        glBindBuffer(target, buffer);
+    }
+}
+
+void GLState::bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    // 带下标的绑定点不缓存，但它会顺带改写通用绑定点
+    ++g_frameStats.issued;
+    GLCounters::recordBind();
+    glBindBufferBase(target, index, buffer);
+    if (GLuint* slot = cachedBufferSlot(target)) {
+        *slot = buffer;
+    }
+}
+
+void GLState::bindTexture(GLuint unit, GLuint texture) {
+    if (unit >= MAX_TEXTURE_UNITS) {
+        ++g_frameStats.issued;
+        GLCounters::recordBind();
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        g_state.activeTexture = GL_TEXTURE0 + unit;
+        return;
+    }
+    // 即使纹理已绑定也要切换当前单元：调用方随后的 glTexImage2D / glTexSubImage2D 作用于当前单元上的纹理
+    if (g_state.activeTexture != GL_TEXTURE0 + unit) {
+        g_state.activeTexture = GL_TEXTURE0 + unit;
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+    if (g_state.textures[unit] == texture) {
+        ++g_frameStats.skipped;
+        return;
+    }
+    g_state.textures[unit] = texture;
+    ++g_frameStats.issued;
+    GLCounters::recordBind();
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GLState::setBlend(bool enabled) {
+    setCapability(g_state.blend, GL_BLEND, enabled);
+}
+
+void GLState::setBlendFunc(GLenum srcFactor, GLenum dstFactor) {
+    if (g_state.blendSrc == srcFactor && g_state.blendDst == dstFactor) {
+        ++g_frameStats.skipped;
+        return;
+    }
+    g_state.blendSrc = srcFactor;
+    g_state.blendDst = dstFactor;
+    ++g_frameStats.issued;
+    glBlendFunc(srcFactor, dstFactor);
+}
+
+void GLState::setDepthTest(bool enabled) {
+    setCapability(g_state.depthTest, GL_DEPTH_TEST, enabled);
+}
+
+void GLState::setDepthMask(bool enabled) {
+    if (changeState(g_state.depthMask, static_cast<int8_t>(enabled ? 1 : 0))) {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    }
+}
+
+void GLState::setDepthFunc(GLenum func) {
+    if (changeState(g_state.depthFunc, func)) {
+        glDepthFunc(func);
+    }
+}
+
+void GLState::setCullFace(bool enabled) {
+    setCapability(g_state.cullFace, GL_CULL_FACE, enabled);
+}
+
+void GLState::deleteProgram(GLuint program) {
+    // 正在使用的程序被删除后仍然保持当前状态，直到切换为止，所以缓存无需改动
+    glDeleteProgram(program);
+}
+
+void GLState::deleteVertexArrays(GLsizei count, const GLuint* arrays) {
+    for (GLsizei i = 0; i < count; ++i) {
+        if (arrays[i] != 0 && arrays[i] == g_state.vertexArray) {
+            g_state.vertexArray = 0;
+        }
+    }
+    glDeleteVertexArrays(count, arrays);
+}
+
+void GLState::deleteBuffers(GLsizei count, const GLuint* buffers) {
+    for (GLsizei i = 0; i < count; ++i) {
+        if (buffers[i] == 0) continue;
+        if (buffers[i] == g_state.arrayBuffer) g_state.arrayBuffer = 0;
+        if (buffers[i] == g_state.uniformBuffer) g_state.uniformBuffer = 0;
+    }
+    glDeleteBuffers(count, buffers);
+}
+
+void GLState::deleteTextures(GLsizei count, const GLuint* textures) {
+    for (GLsizei i = 0; i < count; ++i) {
+        if (textures[i] == 0) continue;
+        for (GLuint& bound : g_state.textures) {
+            if (bound == textures[i]) bound = 0;
+        }
+    }
+    glDeleteTextures(count, textures);
+}
+
+void GLState::invalidate() {
+    g_state = CachedState();
+}
+
+void GLState::beginFrame() {
+    g_lastFrameStats = g_frameStats;
+    g_frameStats = GLStateStats();
+}
+
+const GLStateStats& GLState::getLastFrameStats() {
+    return g_lastFrameStats;
+}
+
+const GLStateStats& GLState::getFrameStats() {
+    return g_frameStats;
+}
+
+} // namespace WaterTown
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+
+namespace WaterTown {
+
+/**
+ * @brief 一帧内的状态切换统计
+ */
+struct GLStateStats {
+    uint32_t issued = 0;   // 实际发给驱动的调用
+    uint32_t skipped = 0;  // 与当前状态相同而跳过的调用
+};
+
+/**
+ * @brief OpenGL 状态缓存
+ *
+ * 记录当前绑定的程序、VAO、缓冲、各纹理单元上的 2D 纹理以及混合/深度/剔除开关，状态未变化的调用直接跳过。
+ * 只有在所有绑定和删除都经过这里时缓存才可信；第三方代码（如 ImGui 后端）直接改动
+ * GL 状态之后需要调用 invalidate()。
+ *
+ * GL_ELEMENT_ARRAY_BUFFER 属于 VAO 状态，不做缓存，总是直接下发。
+ */
+class GLState {
+public:
+    // 绑定
+    static void useProgram(GLuint program);
+    static void bindVertexArray(GLuint vao);
+    static void bindBuffer(GLenum target, GLuint buffer);
+    static void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+
+    /**
+     * @brief 把 2D 纹理绑定到指定纹理单元（需要时先切换当前纹理单元）
+     *
+     * 返回时 unit 总是当前纹理单元（即使绑定被跳过），之后的纹理上传和参数设置作用于该纹理。
+     * 只缓存前 MAX_TEXTURE_UNITS 个单元，更高的单元总是直接下发。
+     */
+    static void bindTexture(GLuint unit, GLuint texture);
+    static constexpr GLuint MAX_TEXTURE_UNITS = 16;
+
+    // 固定管线开关
+    static void setBlend(bool enabled);
+    static void setBlendFunc(GLenum srcFactor, GLenum dstFactor);
+    static void setDepthTest(bool enabled);
+    static void setDepthMask(bool enabled);
+    static void setDepthFunc(GLenum func);
+    static void setCullFace(bool enabled);
+
+    /**
+     * @brief 删除对象；若它正被绑定，缓存同步回到 0（与 GL 的行为一致）
+     */
+    static void deleteProgram(GLuint program);
+    static void deleteVertexArrays(GLsizei count, const GLuint* arrays);
+    static void deleteBuffers(GLsizei count, const GLuint* buffers);
+    static void deleteTextures(GLsizei count, const GLuint* textures);
+
+    /**
+     * @brief 丢弃所有缓存值，下一次设置必定下发
+     */
+    static void invalidate();
+
+    /**
+     * @brief 帧开始时调用：保存上一帧的统计并清零
+     */
+    static void beginFrame();
+
+    /**
+     * @brief 上一帧的统计
+     */
+    static const GLStateStats& getLastFrameStats();
+
+    /**
+     * @brief 当前帧到目前为止的统计
+     */
+    static const GLStateStats& getFrameStats();
+};
+
+} // namespace WaterTown
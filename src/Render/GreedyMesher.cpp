@@ -0,0 +1,91 @@
+#include "GreedyMesher.h"
+
+namespace WaterTown {
+
+void GreedyMesher::mergeRects(const uint8_t* cells, int sizeX, int sizeZ, uint32_t valueMask,
+                              std::vector<GreedyRect>& outRects) {
+    outRects.clear();
+    if (!cells || sizeX <= 0 || sizeZ <= 0) {
+        return;
+    }
+
+    m_visited.assign(static_cast<size_t>(sizeX) * sizeZ, 0);
+
+    auto accepted = [valueMask](uint8_t value) {
+        return value < 32 && (valueMask & (1u << value)) != 0;
+    };
+
+    for (int z = 0; z < sizeZ; ++z) {
+        for (int x = 0; x < sizeX; ++x) {
+            int start = z * sizeX + x;
+            uint8_t value = cells[start];
+            if (m_visited[start] || !accepted(value)) {
+                continue;
+            }
+
+            // 先沿 X 方向尽量延伸
+            int width = 1;
+            while (x + width < sizeX) {
+                int i = start + width;
+                if (m_visited[i] || cells[i] != value) break;
+                ++width;
+            }
+
+            // 再逐行沿 Z 方向延伸，整行都匹配才接受
+            int depth = 1;
+            while (z + depth < sizeZ) {
+                int rowStart = (z + depth) * sizeX + x;
+                bool rowMatches = true;
+                for (int w = 0; w < width; ++w) {
+                    if (m_visited[rowStart + w] || cells[rowStart + w] != value) {
+                        rowMatches = false;
+                        break;
+                    }
+                }
+                if (!rowMatches) break;
+                ++depth;
+            }
+
+            for (int dz = 0; dz < depth; ++dz) {
+                int rowStart = (z + dz) * sizeX + x;
+                for (int w = 0; w < width; ++w) {
+                    m_visited[rowStart + w] = 1;
+                }
+            }
+
+            outRects.push_back({x, z, width, depth, value});
+        }
+    }
+}
+
+void GreedyMesher::appendQuadIndices(uint32_t baseVertex, std::vector<uint32_t>& outIndices) {
+    outIndices.push_back(baseVertex + 0);
+    outIndices.push_back(baseVertex + 1);
+    outIndices.push_back(baseVertex + 2);
+    outIndices.push_back(baseVertex + 0);
+    outIndices.push_back(baseVertex + 2);
+    outIndices.push_back(baseVertex + 3);
+}
+
+void GreedyMesher::appendGridIndices(uint32_t baseVertex, int cellsX, int cellsZ,
+                                     std::vector<uint32_t>& outIndices) {
+    const uint32_t rowStride = static_cast<uint32_t>(cellsX + 1);
+    for (int z = 0; z < cellsZ; ++z) {
+        for (int x = 0; x < cellsX; ++x) {
+            uint32_t topLeft = baseVertex + z * rowStride + x;
+            uint32_t topRight = topLeft + 1;
+            uint32_t bottomLeft = topLeft + rowStride;
+            uint32_t bottomRight = bottomLeft + 1;
+
+            outIndices.push_back(topLeft);
+            outIndices.push_back(bottomLeft);
+            outIndices.push_back(topRight);
+
+            outIndices.push_back(topRight);
+            outIndices.push_back(bottomLeft);
+            outIndices.push_back(bottomRight);
+        }
+    }
+}
+
+} // namespace WaterTown
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 合并后的矩形（以格子为单位）
+ */
+struct GreedyRect {
+    int x;          // 起始格子 X
+    int z;          // 起始格子 Z
+    int sizeX;      // X 方向格子数
+    int sizeZ;      // Z 方向格子数
+    uint8_t value;  // 矩形内所有格子的取值（例如 TerrainType）
+};
+
+/**
+ * @brief 贪心矩形合并网格器（不依赖 OpenGL）
+ *
+ * 把一块二维格子数据中取值相同的相邻格子合并为尽可能大的矩形，
+ * 并提供生成索引拓扑的辅助函数。地形顶面与自定义水面网格共用此类。
+ */
+class GreedyMesher {
+public:
+    /**
+     * @brief 合并矩形
+     * @param cells 格子数据，按 z * sizeX + x 排列
+     * @param sizeX X 方向格子数
+     * @param sizeZ Z 方向格子数
+     * @param valueMask 需要参与合并的取值集合（第 v 位为 1 表示取值 v 参与）
+     * @param outRects 输出矩形（会先清空）
+     */
+    void mergeRects(const uint8_t* cells, int sizeX, int sizeZ, uint32_t valueMask,
+                    std::vector<GreedyRect>& outRects);
+
+    /**
+     * @brief 追加一个四边形的索引（顶点顺序 v0..v3，两个三角形 v0-v1-v2、v0-v2-v3）
+     */
+    static void appendQuadIndices(uint32_t baseVertex, std::vector<uint32_t>& outIndices);
+
+    /**
+     * @brief 追加规则网格的索引
+     * @param baseVertex 网格第一个顶点的下标
+     * @param cellsX X 方向格子数（顶点数为 cellsX + 1）
+     * @param cellsZ Z 方向格子数（顶点数为 cellsZ + 1）
+     *
+     * 顶点按 z * (cellsX + 1) + x 排列，三角形朝向与 WaterSurface 的默认网格一致。
+     */
+    static void appendGridIndices(uint32_t baseVertex, int cellsX, int cellsZ,
+                                  std::vector<uint32_t>& outIndices);
+
+private:
+    std::vector<uint8_t> m_visited;  // 复用的访问标记
+};
+
+} // namespace WaterTown
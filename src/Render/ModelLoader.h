@@ -1,6 +1,8 @@
 #pragma once
 
 #include <glad/glad.h>
+#include "GLState.h"
+#include "GLCounters.h"
 #include <glm/glm.hpp>
 #include <string>
 #include <vector>
@@ -18,9 +20,9 @@ struct Mesh {
     Mesh() : VAO(0), VBO(0), EBO(0) {}
     
     ~Mesh() {
-        if (VAO) glDeleteVertexArrays(1, &VAO);
-        if (VBO) glDeleteBuffers(1, &VBO);
-        if (EBO) glDeleteBuffers(1, &EBO);
+        if (VAO) GLState::deleteVertexArrays(1, &VAO);
+        if (VBO) GLState::deleteBuffers(1, &VBO);
+        if (EBO) GLState::deleteBuffers(1, &EBO);
     }
     
     void setupMesh() {
@@ -28,12 +30,12 @@ struct Mesh {
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &EBO);
         
-        glBindVertexArray(VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+        GLState::bindVertexArray(VAO);
+        GLState::bindBuffer(GL_ARRAY_BUFFER, VBO);
+        GLCounters::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
         
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        GLCounters::bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
         
         // 位置属性
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
@@ -43,7 +45,7 @@ struct Mesh {
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
         glEnableVertexAttribArray(1);
         
-        glBindVertexArray(0);
+        GLState::bindVertexArray(0);
     }
 };
 
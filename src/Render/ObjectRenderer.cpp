@@ -1,32 +1,110 @@
 #include "ObjectRenderer.h"
 #include "Shader.h"
 #include "Camera.h"
+#include "GLState.h"
+#include "GLCounters.h"
+#include "../Core/Profiler.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 
 namespace WaterTown {
 
 ObjectRenderer::ObjectRenderer()
     : m_cubeVAO(0), m_cubeVBO(0), m_coneVAO(0), m_coneVBO(0),
       m_cylinderVAO(0), m_cylinderVBO(0), m_sphereVAO(0), m_sphereVBO(0),
-      m_coneVertexCount(0), m_cylinderVertexCount(0), m_sphereVertexCount(0) {
+      m_coneVertexCount(0), m_cylinderVertexCount(0), m_sphereVertexCount(0),
+      m_instancesChanged(true), m_buildingId(INVALID_OBJECT_ID), m_objectTransform(1.0f) {
     
     generateCube();
     generateCone();
     generateCylinder();
     generateSphere();
+    
+    glGenBuffers(PRIMITIVE_COUNT, m_instanceVBO);
+    for (int i = 0; i < PRIMITIVE_COUNT; ++i) {
+        m_instanceCapacityBytes[i] = 0;
+        setupInstanceAttributes(static_cast<PrimitiveType>(i));
+    }
 }
 
 ObjectRenderer::~ObjectRenderer() {
-    if (m_cubeVAO) glDeleteVertexArrays(1, &m_cubeVAO);
-    if (m_cubeVBO) glDeleteBuffers(1, &m_cubeVBO);
-    if (m_coneVAO) glDeleteVertexArrays(1, &m_coneVAO);
-    if (m_coneVBO) glDeleteBuffers(1, &m_coneVBO);
-    if (m_cylinderVAO) glDeleteVertexArrays(1, &m_cylinderVAO);
-    if (m_cylinderVBO) glDeleteBuffers(1, &m_cylinderVBO);
-    if (m_sphereVAO) glDeleteVertexArrays(1, &m_sphereVAO);
-    if (m_sphereVBO) glDeleteBuffers(1, &m_sphereVBO);
+    if (m_cubeVAO) GLState::deleteVertexArrays(1, &m_cubeVAO);
+    if (m_cubeVBO) GLState::deleteBuffers(1, &m_cubeVBO);
+    if (m_coneVAO) GLState::deleteVertexArrays(1, &m_coneVAO);
+    if (m_coneVBO) GLState::deleteBuffers(1, &m_coneVBO);
+    if (m_cylinderVAO) GLState::deleteVertexArrays(1, &m_cylinderVAO);
+    if (m_cylinderVBO) GLState::deleteBuffers(1, &m_cylinderVBO);
+    if (m_sphereVAO) GLState::deleteVertexArrays(1, &m_sphereVAO);
+    if (m_sphereVBO) GLState::deleteBuffers(1, &m_sphereVBO);
+    GLState::deleteBuffers(PRIMITIVE_COUNT, m_instanceVBO);
+}
+
+GLuint ObjectRenderer::getPrimitiveVAO(PrimitiveType type) const {
+    switch (type) {
+        case PrimitiveType::CUBE: return m_cubeVAO;
+        case PrimitiveType::CONE: return m_coneVAO;
+        case PrimitiveType::CYLINDER: return m_cylinderVAO;
+        case PrimitiveType::SPHERE: return m_sphereVAO;
+        default: return 0;
+    }
+}
+
+GLsizei ObjectRenderer::getPrimitiveVertexCount(PrimitiveType type) const {
+    switch (type) {
+        case PrimitiveType::CUBE: return 36;
+        case PrimitiveType::CONE: return static_cast<GLsizei>(m_coneVertexCount);
+        case PrimitiveType::CYLINDER: return static_cast<GLsizei>(m_cylinderVertexCount);
+        case PrimitiveType::SPHERE: return static_cast<GLsizei>(m_sphereVertexCount);
+        default: return 0;
+    }
+}
+
+void ObjectRenderer::setupInstanceAttributes(PrimitiveType type) {
+    int index = static_cast<int>(type);
+    GLState::bindVertexArray(getPrimitiveVAO(type));
+    GLState::bindBuffer(GL_ARRAY_BUFFER, m_instanceVBO[index]);
+    
+    const GLsizei stride = sizeof(PartInstance);
+    // 模型矩阵：location 4-7（每列一个 vec4）
+    for (int col = 0; col < 4; ++col) {
+        GLuint location = 4 + col;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(offsetof(PartInstance, model) + col * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    // 法线矩阵：location 8-10（每列一个 vec3）
+    for (int col = 0; col < 3; ++col) {
+        GLuint location = 8 + col;
+        glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(offsetof(PartInstance, normalMatrix) + col * sizeof(glm::vec3)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    // 颜色：location 11
+    glVertexAttribPointer(11, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(PartInstance, color));
+    glEnableVertexAttribArray(11);
+    glVertexAttribDivisor(11, 1);
+    
+    GLState::bindVertexArray(0);
+}
+
+void ObjectRenderer::addPart(PrimitiveType type, const glm::mat4& model, const glm::vec3& color) {
+    PartInstance instance;
+    instance.model = m_objectTransform * model;
+    instance.normalMatrix = glm::transpose(glm::inverse(glm::mat3(instance.model)));
+    instance.color = color;
+    
+    int primitive = static_cast<int>(type);
+    RetainedObject& object = m_objects[m_buildingId];
+    uint32_t slot = static_cast<uint32_t>(m_instances[primitive].size());
+    m_instances[primitive].push_back(instance);
+    m_slotOwners[primitive].push_back({m_buildingId, static_cast<uint32_t>(object.parts.size())});
+    object.parts.push_back({type, slot});
+    m_instancesChanged = true;
 }
 
 void ObjectRenderer::generateCube() {
@@ -79,16 +157,16 @@ void ObjectRenderer::generateCube() {
     glGenVertexArrays(1, &m_cubeVAO);
     glGenBuffers(1, &m_cubeVBO);
     
-    glBindVertexArray(m_cubeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_cubeVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    GLState::bindVertexArray(m_cubeVAO);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, m_cubeVBO);
+    GLCounters::bufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
     
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
 }
 
 void ObjectRenderer::generateCone() {
@@ -126,16 +204,16 @@ void ObjectRenderer::generateCone() {
     glGenVertexArrays(1, &m_coneVAO);
     glGenBuffers(1, &m_coneVBO);
     
-    glBindVertexArray(m_coneVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_coneVBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    GLState::bindVertexArray(m_coneVAO);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, m_coneVBO);
+    GLCounters::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
 }
 
 void ObjectRenderer::generateCylinder() {
@@ -182,16 +260,16 @@ void ObjectRenderer::generateCylinder() {
     glGenVertexArrays(1, &m_cylinderVAO);
     glGenBuffers(1, &m_cylinderVBO);
     
-    glBindVertexArray(m_cylinderVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_cylinderVBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    GLState::bindVertexArray(m_cylinderVAO);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, m_cylinderVBO);
+    GLCounters::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
 }
 
 void ObjectRenderer::generateSphere() {
@@ -245,155 +323,308 @@ void ObjectRenderer::generateSphere() {
     glGenVertexArrays(1, &m_sphereVAO);
     glGenBuffers(1, &m_sphereVBO);
     
-    glBindVertexArray(m_sphereVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_sphereVBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    GLState::bindVertexArray(m_sphereVAO);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, m_sphereVBO);
+    GLCounters::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
+}
+
+ObjectId ObjectRenderer::addObject(ObjectType type, const glm::vec3& position, float rotation) {
+    ObjectId id;
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    } else {
+        id = static_cast<ObjectId>(m_objects.size());
+        m_objects.push_back(RetainedObject());
+    }
+    
+    RetainedObject& object = m_objects[id];
+    object.desc = {type, position, rotation};
+    object.parts.clear();
+    object.indexHandle = INVALID_SPATIAL_HANDLE;
+    object.alive = true;
+    buildObjectParts(id);
+    return id;
+}
+
+void ObjectRenderer::updateObject(ObjectId id, const glm::vec3& position, float rotation) {
+    if (id >= m_objects.size() || !m_objects[id].alive) return;
+    
+    RetainedObject& object = m_objects[id];
+    if (object.desc.position == position && object.desc.rotation == rotation) return;
+    
+    releaseObjectParts(id);
+    object.desc.position = position;
+    object.desc.rotation = rotation;
+    buildObjectParts(id);
 }
 
-void ObjectRenderer::addObject(ObjectType type, const glm::vec3& position, float rotation) {
-    m_objects.push_back({type, position, rotation});
+void ObjectRenderer::removeObject(ObjectId id) {
+    if (id >= m_objects.size() || !m_objects[id].alive) return;
+    
+    releaseObjectParts(id);
+    m_objects[id].alive = false;
+    m_freeIds.push_back(id);
 }
 
 void ObjectRenderer::clear() {
     m_objects.clear();
+    m_freeIds.clear();
+    for (int i = 0; i < PRIMITIVE_COUNT; ++i) {
+        m_instances[i].clear();
+        m_slotOwners[i].clear();
+        m_visibleInstances[i].clear();
+    }
+    m_index.clear();
+    m_visibleIds.clear();
+    m_uploadedIds.clear();
+    m_instancesChanged = true;
+}
+
+void ObjectRenderer::releaseObjectParts(ObjectId id) {
+    RetainedObject& object = m_objects[id];
+    if (object.indexHandle != INVALID_SPATIAL_HANDLE) {
+        m_index.remove(object.indexHandle);
+        object.indexHandle = INVALID_SPATIAL_HANDLE;
+    }
+    std::vector<PartSlot>& parts = object.parts;
+    
+    // 按槽位从大到小删除：与末尾交换时，末尾不会是本物体尚未删除的部件
+    std::sort(parts.begin(), parts.end(), [](const PartSlot& a, const PartSlot& b) {
+        return a.index > b.index;
+    });
+    
+    for (const PartSlot& part : parts) {
+        int primitive = static_cast<int>(part.type);
+        auto& instances = m_instances[primitive];
+        auto& owners = m_slotOwners[primitive];
+        uint32_t last = static_cast<uint32_t>(instances.size() - 1);
+        
+        if (part.index != last) {
+            instances[part.index] = instances[last];
+            owners[part.index] = owners[last];
+            m_objects[owners[part.index].id].parts[owners[part.index].part].index = part.index;
+        }
+        instances.pop_back();
+        owners.pop_back();
+    }
+    if (!parts.empty()) {
+        m_instancesChanged = true;
+    }
+    parts.clear();
+}
+
+void ObjectRenderer::buildObjectParts(ObjectId id) {
+    const SceneObject obj = m_objects[id].desc;
+    const bool isBuilding = (obj.type == ObjectType::HOUSE ||
+                             obj.type == ObjectType::HOUSE_STYLE_1 ||
+                             obj.type == ObjectType::HOUSE_STYLE_2 ||
+                             obj.type == ObjectType::HOUSE_STYLE_3 ||
+                             obj.type == ObjectType::HOUSE_STYLE_4 ||
+                             obj.type == ObjectType::HOUSE_STYLE_5 ||
+                             obj.type == ObjectType::BRIDGE ||
+                             obj.type == ObjectType::WALL ||
+                             obj.type == ObjectType::PAVILION ||
+                             obj.type == ObjectType::LONG_HOUSE ||
+                             obj.type == ObjectType::ARCH_BRIDGE ||
+                             obj.type == ObjectType::PAIFANG ||
+                             obj.type == ObjectType::WATER_PAVILION ||
+                             obj.type == ObjectType::PIER ||
+                             obj.type == ObjectType::TEMPLE ||
+                             obj.type == ObjectType::LOTUS_POND);
+    
+    // 以物体位置为中心整体缩放：T(origin) * S(scale) * T(-origin)
+    float objectScale = isBuilding ? 7.5f : 5.0f;
+    m_objectTransform = glm::translate(glm::mat4(1.0f), obj.position);
+    m_objectTransform = glm::scale(m_objectTransform, glm::vec3(objectScale));
+    m_objectTransform = glm::translate(m_objectTransform, -obj.position);
+    m_buildingId = id;
+    
+    switch (obj.type) {
+        case ObjectType::HOUSE:
+            renderHouse(obj.position, obj.rotation);
+            break;
+        case ObjectType::HOUSE_STYLE_1:
+            renderHouseStyle1(obj.position, obj.rotation);
+            break;
+        case ObjectType::HOUSE_STYLE_2:
+            renderHouseStyle2(obj.position, obj.rotation);
+            break;
+        case ObjectType::HOUSE_STYLE_3:
+            renderHouseStyle3(obj.position, obj.rotation);
+            break;
+        case ObjectType::HOUSE_STYLE_4:
+            renderHouseStyle4(obj.position, obj.rotation);
+            break;
+        case ObjectType::HOUSE_STYLE_5:
+            renderHouseStyle5(obj.position, obj.rotation);
+            break;
+        case ObjectType::BRIDGE:
+            renderBridge(obj.position, obj.rotation);
+            break;
+        case ObjectType::TREE:
+            renderTree(obj.position, obj.rotation);
+            break;
+        case ObjectType::PLANT_1:
+            renderPlant1(obj.position, obj.rotation);
+            break;
+        case ObjectType::PLANT_2:
+            renderPlant2(obj.position, obj.rotation);
+            break;
+        case ObjectType::PLANT_4:
+            renderPlant4(obj.position, obj.rotation);
+            break;
+        case ObjectType::BOAT:
+            // 船由 BoatRenderer 单独处理
+            break;
+        case ObjectType::WALL:
+            renderWall(obj.position, obj.rotation);
+            break;
+        case ObjectType::PAVILION:
+            renderPavilion(obj.position, obj.rotation);
+            break;
+        case ObjectType::LONG_HOUSE:
+            renderLongHouse(obj.position, obj.rotation);
+            break;
+        case ObjectType::ARCH_BRIDGE:
+            renderArchBridge(obj.position, obj.rotation);
+            break;
+        case ObjectType::PAIFANG:
+            renderPaifang(obj.position, obj.rotation);
+            break;
+        case ObjectType::WATER_PAVILION:
+            renderWaterPavilion(obj.position, obj.rotation);
+            break;
+        case ObjectType::PIER:
+            renderPier(obj.position, obj.rotation);
+            break;
+        case ObjectType::TEMPLE:
+            renderTemple(obj.position, obj.rotation);
+            break;
+        case ObjectType::BAMBOO:
+            renderBamboo(obj.position, obj.rotation);
+            break;
+        case ObjectType::LOTUS_POND:
+            renderLotusPond(obj.position, obj.rotation);
+            break;
+        case ObjectType::FISHING_BOAT:
+            renderFishingBoat(obj.position, obj.rotation);
+            break;
+        case ObjectType::LANTERN:
+            renderLantern(obj.position, obj.rotation);
+            break;
+        case ObjectType::STONE_LION:
+            renderStoneLion(obj.position, obj.rotation);
+            break;
+    }
+    
+    m_buildingId = INVALID_OBJECT_ID;
+    
+    // 没有部件的物体（例如船）不进入空间索引，也就不会被收集为可见
+    if (!m_objects[id].parts.empty()) {
+        m_objects[id].indexHandle = m_index.insert(obj.position, computeBoundsRadius(id), id);
+    }
+}
+
+float ObjectRenderer::computeBoundsRadius(ObjectId id) const {
+    // 所有基础几何体都落在 [-0.5, 0.5] x [-0.5, 1] x [-0.5, 0.5] 内（圆锥 / 圆柱的 y 从 0 到 1）
+    const RetainedObject& object = m_objects[id];
+    float radius = 0.0f;
+    for (const PartSlot& part : object.parts) {
+        const glm::mat4& model = m_instances[static_cast<int>(part.type)][part.index].model;
+        for (int corner = 0; corner < 8; ++corner) {
+            glm::vec4 local((corner & 1) ? 0.5f : -0.5f, (corner & 2) ? 1.0f : -0.5f, (corner & 4) ? 0.5f : -0.5f, 1.0f);
+            radius = std::max(radius, glm::length(glm::vec3(model * local) - object.desc.position));
+        }
+    }
+    return radius;
+}
+
+void ObjectRenderer::collectVisibleObjects(Camera* camera) {
+    const glm::mat4 viewProjection = camera->getProjectionMatrix() * camera->getViewMatrix();
+    m_index.queryFrustum(viewProjection, m_visibleIds);
+    
+    if (renderDistance > 0.0f) {
+        const glm::vec3 viewPos = camera->getPosition();
+        const float maxDistanceSq = renderDistance * renderDistance;
+        m_visibleIds.erase(std::remove_if(m_visibleIds.begin(), m_visibleIds.end(), [&](uint32_t id) {
+            glm::vec3 toObject = m_objects[id].desc.position - viewPos;
+            return glm::dot(toObject, toObject) > maxDistanceSq;
+        }), m_visibleIds.end());
+    }
+    
+    // 排序后与上次上传的集合直接比较
+    std::sort(m_visibleIds.begin(), m_visibleIds.end());
+}
+
+void ObjectRenderer::uploadVisibleInstances(int primitive) {
+    const auto& instances = m_visibleInstances[primitive];
+    if (instances.empty()) return;
+    
+    GLState::bindBuffer(GL_ARRAY_BUFFER, m_instanceVBO[primitive]);
+    size_t bytes = instances.size() * sizeof(PartInstance);
+    if (bytes > m_instanceCapacityBytes[primitive]) {
+        // 容量不足：按 1.5 倍预留后重新分配
+        size_t capacity = std::max(bytes, m_instanceCapacityBytes[primitive] + m_instanceCapacityBytes[primitive] / 2);
+        GLCounters::bufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_DYNAMIC_DRAW);
+        m_instanceCapacityBytes[primitive] = capacity;
+    }
+    GLCounters::bufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
 }
 
 void ObjectRenderer::render(Shader* shader, Camera* camera) {
     if (!shader || !camera) return;
     
+    // 物体变体：实例化路径，颜色来自逐实例属性，整体缩放已预乘进实例矩阵
+    if (shader != m_variantSource) {
+        m_variantSource = shader;
+        m_shaderVariant = shader->getVariant({"VARIANT_INSTANCING 1", "VARIANT_OBJECT_SCALE 0",
+                                              "VARIANT_VERTEX_COLOR 1", "VARIANT_BOTTOM_TINT 0"});
+    }
+    shader = m_shaderVariant;
     shader->use();
-    shader->setBool("uUseVertexColor", false);
-    shader->setBool("uUseObjectScale", true);
-    shader->setVec3("uLightDir", -0.3f, -1.0f, -0.2f);
-    shader->setVec3("uLightColor", 1.0f, 0.98f, 0.95f);
-    shader->setVec3("uSkyColor", 0.6f, 0.75f, 0.95f);
-    shader->setVec3("uGroundColor", 0.35f, 0.3f, 0.25f);
-    shader->setFloat("uAmbientStrength", 0.35f);
-    shader->setBool("uUseFog", true);
-    shader->setVec3("uFogColor", 0.7f, 0.8f, 0.9f);
-    shader->setFloat("uFogDensity", 0.0025f);
-    shader->setVec3("uBottomTintColor", 0.2f, 0.45f, 0.65f);
-    shader->setFloat("uBottomTintStrength", 0.0f);
-    shader->setMat4("uView", camera->getViewMatrix());
-    shader->setMat4("uProjection", camera->getProjectionMatrix());
-    shader->setVec3("uViewPos", camera->getPosition());
-
-    const glm::vec3 cameraPos = camera->getPosition();
-    const float renderDistance = 350.0f; // 物体渲染半径
-    const float renderDistanceSq = renderDistance * renderDistance;
-    
-    for (const auto& obj : m_objects) {
-        const bool isBuilding = (obj.type == ObjectType::HOUSE ||
-                                 obj.type == ObjectType::HOUSE_STYLE_1 ||
-                                 obj.type == ObjectType::HOUSE_STYLE_2 ||
-                                 obj.type == ObjectType::HOUSE_STYLE_3 ||
-                                 obj.type == ObjectType::HOUSE_STYLE_4 ||
-                                 obj.type == ObjectType::HOUSE_STYLE_5 ||
-                                 obj.type == ObjectType::BRIDGE ||
-                                 obj.type == ObjectType::WALL ||
-                                 obj.type == ObjectType::PAVILION ||
-                                 obj.type == ObjectType::LONG_HOUSE ||
-                                 obj.type == ObjectType::ARCH_BRIDGE ||
-                                 obj.type == ObjectType::PAIFANG ||
-                                 obj.type == ObjectType::WATER_PAVILION ||
-                                 obj.type == ObjectType::PIER ||
-                                 obj.type == ObjectType::TEMPLE ||
-                                 obj.type == ObjectType::LOTUS_POND);
-
-        shader->setFloat("uObjectScale", isBuilding ? 7.5f : 5.0f);
-        shader->setVec3("uObjectScaleOrigin", obj.position);
-        glm::vec3 diff = obj.position - cameraPos;
-        if (glm::dot(diff, diff) > renderDistanceSq) {
-            continue;
+    
+    // 可见集合变化（相机移动、物体进出视野）或部件有增删时，重新打包可见物体的部件
+    collectVisibleObjects(camera);
+    if (m_instancesChanged || m_visibleIds != m_uploadedIds) {
+        PROFILE_SCOPE("ObjectRenderer::uploadVisibleInstances");
+        for (int i = 0; i < PRIMITIVE_COUNT; ++i) {
+            m_visibleInstances[i].clear();
+        }
+        for (uint32_t id : m_visibleIds) {
+            for (const PartSlot& part : m_objects[id].parts) {
+                const int primitive = static_cast<int>(part.type);
+                m_visibleInstances[primitive].push_back(m_instances[primitive][part.index]);
+            }
         }
-        switch (obj.type) {
-            case ObjectType::HOUSE:
-                renderHouse(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::HOUSE_STYLE_1:
-                renderHouseStyle1(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::HOUSE_STYLE_2:
-                renderHouseStyle2(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::HOUSE_STYLE_3:
-                renderHouseStyle3(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::HOUSE_STYLE_4:
-                renderHouseStyle4(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::HOUSE_STYLE_5:
-                renderHouseStyle5(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::BRIDGE:
-                renderBridge(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::TREE:
-                renderTree(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::PLANT_1:
-                renderPlant1(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::PLANT_2:
-                renderPlant2(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::PLANT_4:
-                renderPlant4(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::BOAT:
-                // 船由 BoatRenderer 单独处理
-                break;
-            case ObjectType::WALL:
-                renderWall(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::PAVILION:
-                renderPavilion(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::LONG_HOUSE:
-                renderLongHouse(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::ARCH_BRIDGE:
-                renderArchBridge(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::PAIFANG:
-                renderPaifang(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::WATER_PAVILION:
-                renderWaterPavilion(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::PIER:
-                renderPier(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::TEMPLE:
-                renderTemple(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::BAMBOO:
-                renderBamboo(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::LOTUS_POND:
-                renderLotusPond(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::FISHING_BOAT:
-                renderFishingBoat(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::LANTERN:
-                renderLantern(obj.position, obj.rotation, shader);
-                break;
-            case ObjectType::STONE_LION:
-                renderStoneLion(obj.position, obj.rotation, shader);
-                break;
+        for (int i = 0; i < PRIMITIVE_COUNT; ++i) {
+            uploadVisibleInstances(i);
+        }
+        m_uploadedIds.swap(m_visibleIds);
+        m_instancesChanged = false;
+    }
+    
+    // 每种几何体一次实例化绘制
+    for (int i = 0; i < PRIMITIVE_COUNT; ++i) {
+        if (m_visibleInstances[i].empty()) {
+            continue;
         }
+        
+        PrimitiveType type = static_cast<PrimitiveType>(i);
+        GLState::bindVertexArray(getPrimitiveVAO(type));
+        GLCounters::drawArraysInstanced(GL_TRIANGLES, 0, getPrimitiveVertexCount(type), static_cast<GLsizei>(m_visibleInstances[i].size()));
     }
+    GLState::bindVertexArray(0);
 }
 
-void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation) {
     // 江南水乡特色民居：白墙黑瓦，飞檐翘角，木结构门窗
     
     // 基础尺寸
@@ -408,15 +639,14 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
     
     // 1. 主墙体（白墙）
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, wallHeight * 0.5f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth, wallHeight, wallDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.9f, 0.86f, 0.78f);  // 暖米墙
+    color = glm::vec3(0.9f, 0.86f, 0.78f);  // 暖米墙
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 2. 屋顶主体（黑瓦）
     model = glm::mat4(1.0f);
@@ -424,11 +654,9 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth + roofOverhang, roofHeight * 0.8f, wallDepth + roofOverhang));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.2f, 0.2f, 0.2f);  // 黑瓦
+    color = glm::vec3(0.2f, 0.2f, 0.2f);  // 黑瓦
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 3. 飞檐（前檐翘角）
     model = glm::mat4(1.0f);
@@ -436,11 +664,9 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth + roofOverhang * 1.8f, roofHeight * 0.3f, roofOverhang * 1.2f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.15f, 0.15f, 0.15f);  // 深黑瓦
+    color = glm::vec3(0.15f, 0.15f, 0.15f);  // 深黑瓦
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 4. 后檐
     model = glm::mat4(1.0f);
@@ -448,9 +674,7 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth + roofOverhang * 1.8f, roofHeight * 0.3f, roofOverhang * 1.2f));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 5. 木门（深色）
     model = glm::mat4(1.0f);
@@ -458,11 +682,9 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(doorWidth, doorHeight, 0.05f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.3f, 0.2f, 0.1f);  // 深木色
+    color = glm::vec3(0.3f, 0.2f, 0.1f);  // 深木色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 6. 窗户（两个侧面窗户）
     for (int i = 0; i < 2; i++) {
@@ -472,11 +694,9 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(windowSize, windowSize, 0.05f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.4f, 0.6f, 0.8f);  // 浅蓝色窗户
+        color = glm::vec3(0.4f, 0.6f, 0.8f);  // 浅蓝色窗户
         
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        addPart(PrimitiveType::CUBE, model, color);
     }
     
     // 7. 木柱支撑（四个角）
@@ -488,18 +708,14 @@ void ObjectRenderer::renderHouse(const glm::vec3& position, float rotation, Shad
         model = glm::translate(model, position + glm::vec3(x, wallHeight * 0.5f, z));
         model = glm::scale(model, glm::vec3(0.1f, wallHeight, 0.1f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.4f, 0.3f, 0.2f);  // 木柱色
+        color = glm::vec3(0.4f, 0.3f, 0.2f);  // 木柱色
         
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addPart(PrimitiveType::CYLINDER, model, color);
     }
-    
-    glBindVertexArray(0);
 }
 
 
-void ObjectRenderer::renderLongHouse(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderLongHouse(const glm::vec3& position, float rotation) {
     // 长屋 = 扩展的房子，长度更长
     
     // 基础尺寸
@@ -511,15 +727,14 @@ void ObjectRenderer::renderLongHouse(const glm::vec3& position, float rotation,
     
     // 墙体（立方体）- 底部在地面上
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, houseHeight * 0.5f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(longHouseLength, houseHeight, houseScale));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.95f, 0.95f, 0.92f);  // 米白色
+    color = glm::vec3(0.95f, 0.95f, 0.92f);  // 米白色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 屋顶（锥体）- 放在墙体顶部
     model = glm::mat4(1.0f);
@@ -527,16 +742,12 @@ void ObjectRenderer::renderLongHouse(const glm::vec3& position, float rotation,
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(longHouseLength * 1.1f, houseRoofHeight, houseRoofScale));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.5f, 0.5f, 0.5f);  // 灰色
-    
-    glBindVertexArray(m_coneVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_coneVertexCount);
+    color = glm::vec3(0.5f, 0.5f, 0.5f);  // 灰色
     
-    glBindVertexArray(0);
+    addPart(PrimitiveType::CONE, model, color);
 }
 
-void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation) {
     // 现代中式别墅：融合传统与现代的豪华住宅
     
     // 基础尺寸
@@ -544,6 +755,7 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
     float baseDepth = 3.0f;   // 别墅深度
     float floorHeight = 2.8f; // 每层高度
     float roofHeight = 1.25f; // 屋顶高度
+    glm::vec3 color(1.0f);
     
     // 1. 主楼（两层）
     for (int floor = 0; floor < 2; floor++) {
@@ -554,11 +766,9 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(baseWidth, floorHeight, baseDepth));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.9f, 0.82f, 0.78f);  // 浅暖色墙
+        color = glm::vec3(0.9f, 0.82f, 0.78f);  // 浅暖色墙
         
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        addPart(PrimitiveType::CUBE, model, color);
     }
 
     glm::mat4 model = glm::mat4(1.0f);
@@ -573,10 +783,8 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
     model = glm::translate(model, position + glm::vec3(0, doorHeight * 0.5f, baseDepth * 0.51f));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(doorWidth, doorHeight, 0.06f));
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.4f, 0.25f, 0.15f);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    color = glm::vec3(0.4f, 0.25f, 0.15f);
+    addPart(PrimitiveType::CUBE, model, color);
 
     // 二层窗户
     for (int i = 0; i < 2; ++i) {
@@ -585,10 +793,8 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
         model = glm::translate(model, position + glm::vec3(baseWidth * 0.3f * side, floorHeight * 1.6f, baseDepth * 0.51f));
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(windowSize, windowSize, 0.05f));
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.55f, 0.75f, 0.9f);
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        color = glm::vec3(0.55f, 0.75f, 0.9f);
+        addPart(PrimitiveType::CUBE, model, color);
     }
     
     // 2. 现代中式屋顶（平顶+翘角）
@@ -598,11 +804,9 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(baseWidth + 0.5f, roofHeight * 0.6f, baseDepth + 0.5f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.2f, 0.2f, 0.2f);  // 深灰瓦
+    color = glm::vec3(0.2f, 0.2f, 0.2f);  // 深灰瓦
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 翘角装饰
     for (int i = 0; i < 4; i++) {
@@ -614,9 +818,7 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(0.3f, roofHeight * 0.4f, 0.3f));
         
-        shader->setMat4("uModel", model);
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        addPart(PrimitiveType::CUBE, model, color);
     }
     
     // 3. 玻璃幕墙（现代元素）
@@ -626,11 +828,9 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(baseWidth * 0.8f, floorHeight * 0.6f, 0.05f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.8f, 0.9f);  // 浅蓝玻璃
+    color = glm::vec3(0.6f, 0.8f, 0.9f);  // 浅蓝玻璃
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 4. 古典柱子（现代简约风格）
     for (int i = 0; i < 4; i++) {
@@ -641,17 +841,13 @@ void ObjectRenderer::renderHouseStyle4(const glm::vec3& position, float rotation
         model = glm::translate(model, position + glm::vec3(x, floorHeight, z));
         model = glm::scale(model, glm::vec3(0.08f, floorHeight * 2, 0.08f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.5f, 0.4f, 0.3f);  // 现代木色
+        color = glm::vec3(0.5f, 0.4f, 0.3f);  // 现代木色
         
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addPart(PrimitiveType::CYLINDER, model, color);
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation) {
     // 古朴农舍：简朴的乡村住宅，茅草屋顶
     
     // 基础尺寸
@@ -662,15 +858,14 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
     
     // 1. 石砌基础
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, 0.1f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(shedWidth + 0.2f, 0.2f, shedDepth + 0.2f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.5f, 0.5f, 0.5f);  // 石灰色
+    color = glm::vec3(0.5f, 0.5f, 0.5f);  // 石灰色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 2. 木墙主体
     model = glm::mat4(1.0f);
@@ -678,11 +873,9 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(shedWidth, shedHeight, shedDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.75f, 0.45f, 0.25f);  // 浅木墙色
+    color = glm::vec3(0.75f, 0.45f, 0.25f);  // 浅木墙色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 3. 茅草屋顶（圆锥形）
     model = glm::mat4(1.0f);
@@ -690,11 +883,9 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(shedWidth + 0.8f, roofHeight, shedDepth + 0.8f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.4f, 0.3f, 0.1f);  // 茅草色
+    color = glm::vec3(0.4f, 0.3f, 0.1f);  // 茅草色
     
-    glBindVertexArray(m_coneVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_coneVertexCount);
+    addPart(PrimitiveType::CONE, model, color);
     
     // 4. 小门
     model = glm::mat4(1.0f);
@@ -702,11 +893,9 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(0.5f, shedHeight * 0.5f, 0.05f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.3f, 0.2f, 0.1f);  // 旧木门
+    color = glm::vec3(0.3f, 0.2f, 0.1f);  // 旧木门
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
 
     // 4. 窗户
     for (int i = 0; i < 2; ++i) {
@@ -715,10 +904,8 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
         model = glm::translate(model, position + glm::vec3(shedWidth * 0.25f * side, shedHeight * 0.6f + 0.1f, shedDepth * 0.51f));
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(0.35f, 0.35f, 0.05f));
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.5f, 0.7f, 0.9f);
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        color = glm::vec3(0.5f, 0.7f, 0.9f);
+        addPart(PrimitiveType::CUBE, model, color);
     }
     
     // 5. 烟囱（小砖砌）
@@ -726,11 +913,9 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
     model = glm::translate(model, position + glm::vec3(shedWidth * 0.3f, shedHeight + roofHeight * 0.8f + 0.1f, 0));
     model = glm::scale(model, glm::vec3(0.15f, roofHeight * 0.4f, 0.15f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.3f, 0.3f);  // 砖红色
+    color = glm::vec3(0.6f, 0.3f, 0.3f);  // 砖红色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 6. 木柱支撑
     for (int i = 0; i < 4; i++) {
@@ -741,17 +926,13 @@ void ObjectRenderer::renderHouseStyle5(const glm::vec3& position, float rotation
         model = glm::translate(model, position + glm::vec3(x, shedHeight * 0.5f + 0.1f, z));
         model = glm::scale(model, glm::vec3(0.08f, shedHeight, 0.08f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.4f, 0.3f, 0.2f);  // 粗糙木色
+        color = glm::vec3(0.4f, 0.3f, 0.2f);  // 粗糙木色
         
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addPart(PrimitiveType::CYLINDER, model, color);
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderBridge(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderBridge(const glm::vec3& position, float rotation) {
     // 石头 = 灰色立方体
     
     // 基础尺寸
@@ -759,20 +940,17 @@ void ObjectRenderer::renderBridge(const glm::vec3& position, float rotation, Sha
     float bridgeHeight = 1.0f; // 石头高度
     
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, bridgeHeight * 0.5f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(bridgeScale, bridgeHeight, bridgeScale));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.6f, 0.6f);  // 灰色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    color = glm::vec3(0.6f, 0.6f, 0.6f);  // 灰色
     
-    glBindVertexArray(0);
+    addPart(PrimitiveType::CUBE, model, color);
 }
 
-void ObjectRenderer::renderTree(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderTree(const glm::vec3& position, float rotation) {
     // 树 = 棕色圆柱（树干） + 绿色球体（树冠）
     
     // 基础尺寸
@@ -782,15 +960,14 @@ void ObjectRenderer::renderTree(const glm::vec3& position, float rotation, Shade
     
     // 树干（圆柱）- 底部贴地（圆柱模型 y=0..1）
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position);
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(treeScale, treeHeight, treeScale));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.4f, 0.25f, 0.1f);  // 棕色
+    color = glm::vec3(0.4f, 0.25f, 0.1f);  // 棕色
     
-    glBindVertexArray(m_cylinderVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+    addPart(PrimitiveType::CYLINDER, model, color);
     
     // 树冠（球体）- 放在树干顶部
     model = glm::mat4(1.0f);
@@ -798,62 +975,50 @@ void ObjectRenderer::renderTree(const glm::vec3& position, float rotation, Shade
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(treeCrownScale, treeCrownScale, treeCrownScale));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.2f, 0.7f, 0.2f);  // 绿色
+    color = glm::vec3(0.2f, 0.7f, 0.2f);  // 绿色
     
-    glBindVertexArray(m_sphereVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_sphereVertexCount);
-    
-    glBindVertexArray(0);
+    addPart(PrimitiveType::SPHERE, model, color);
 }
 
-void ObjectRenderer::renderPlant1(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderPlant1(const glm::vec3& position, float rotation) {
     // 灌木：低矮圆球
     float shrubSize = 1.2f;
 
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, shrubSize * 0.35f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(shrubSize, shrubSize * 0.7f, shrubSize));
 
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.2f, 0.6f, 0.2f);
-
-    glBindVertexArray(m_sphereVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_sphereVertexCount);
+    color = glm::vec3(0.2f, 0.6f, 0.2f);
 
-    glBindVertexArray(0);
+    addPart(PrimitiveType::SPHERE, model, color);
 }
 
-void ObjectRenderer::renderPlant2(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderPlant2(const glm::vec3& position, float rotation) {
     // 花丛：扁平花盘 + 花心
     float flowerRadius = 0.8f;
 
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, 0.1f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(flowerRadius, 0.2f, flowerRadius));
 
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.9f, 0.5f, 0.7f);
+    color = glm::vec3(0.9f, 0.5f, 0.7f);
 
-    glBindVertexArray(m_sphereVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_sphereVertexCount);
+    addPart(PrimitiveType::SPHERE, model, color);
 
     model = glm::mat4(1.0f);
     model = glm::translate(model, position + glm::vec3(0, 0.32f, 0));
     model = glm::scale(model, glm::vec3(0.25f, 0.25f, 0.25f));
 
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.95f, 0.85f, 0.3f);
+    color = glm::vec3(0.95f, 0.85f, 0.3f);
 
-    glBindVertexArray(m_sphereVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_sphereVertexCount);
-
-    glBindVertexArray(0);
+    addPart(PrimitiveType::SPHERE, model, color);
 }
 
-void ObjectRenderer::renderPlant4(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderPlant4(const glm::vec3& position, float rotation) {
     // 松树：细干 + 高锥树冠
     float trunkHeight = 3.0f;
     float trunkRadius = 0.15f;
@@ -861,31 +1026,26 @@ void ObjectRenderer::renderPlant4(const glm::vec3& position, float rotation, Sha
     float crownRadius = 1.5f;
 
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position);
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(trunkRadius, trunkHeight, trunkRadius));
 
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.33f, 0.2f, 0.12f);
+    color = glm::vec3(0.33f, 0.2f, 0.12f);
 
-    glBindVertexArray(m_cylinderVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+    addPart(PrimitiveType::CYLINDER, model, color);
 
     model = glm::mat4(1.0f);
     model = glm::translate(model, position + glm::vec3(0, trunkHeight - crownHeight * 0.1f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(crownRadius, crownHeight, crownRadius));
 
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.18f, 0.45f, 0.2f);
-
-    glBindVertexArray(m_coneVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_coneVertexCount);
+    color = glm::vec3(0.18f, 0.45f, 0.2f);
 
-    glBindVertexArray(0);
+    addPart(PrimitiveType::CONE, model, color);
 }
 
-void ObjectRenderer::renderWall(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderWall(const glm::vec3& position, float rotation) {
     // 围墙 = 灰色长方体
     
     // 基础尺寸
@@ -894,22 +1054,21 @@ void ObjectRenderer::renderWall(const glm::vec3& position, float rotation, Shade
     float wallWidth = 0.2f;  // 围墙宽度
     
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, wallHeight * 0.5f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallLength, wallHeight, wallWidth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.6f, 0.6f);  // 灰色
+    color = glm::vec3(0.6f, 0.6f, 0.6f);  // 灰色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
+    addPart(PrimitiveType::CUBE, model, color);
 }
 
-void ObjectRenderer::renderPavilion(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderPavilion(const glm::vec3& position, float rotation) {
     // 凉亭 = 红色柱子 + 绿色屋顶
     float pavilionSize = 2.0f;
     float pavilionHeight = 2.5f;
+    glm::vec3 color(1.0f);
     
     // 四个柱子
     for (int i = 0; i < 4; i++) {
@@ -920,11 +1079,9 @@ void ObjectRenderer::renderPavilion(const glm::vec3& position, float rotation, S
         model = glm::translate(model, position + offset);
         model = glm::scale(model, glm::vec3(0.2f, pavilionHeight * 0.6f, 0.2f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.8f, 0.3f, 0.3f);  // 红色
+        color = glm::vec3(0.8f, 0.3f, 0.3f);  // 红色
         
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addPart(PrimitiveType::CYLINDER, model, color);
     }
     
     // 屋顶（圆锥）
@@ -932,16 +1089,12 @@ void ObjectRenderer::renderPavilion(const glm::vec3& position, float rotation, S
     model = glm::translate(model, position + glm::vec3(0, pavilionHeight * 0.8f, 0));
     model = glm::scale(model, glm::vec3(pavilionSize * 0.8f, pavilionHeight * 0.4f, pavilionSize * 0.8f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.2f, 0.6f, 0.2f);  // 绿色
-    
-    glBindVertexArray(m_coneVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_coneVertexCount);
+    color = glm::vec3(0.2f, 0.6f, 0.2f);  // 绿色
     
-    glBindVertexArray(0);
+    addPart(PrimitiveType::CONE, model, color);
 }
 
-void ObjectRenderer::renderArchBridge(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderArchBridge(const glm::vec3& position, float rotation) {
     // 拱桥 = 石灰色桥身 + 拱形结构
     
     // 基础尺寸
@@ -950,15 +1103,14 @@ void ObjectRenderer::renderArchBridge(const glm::vec3& position, float rotation,
     float archBridgeWidth = 2.0f;  // 桥宽度
     
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, archBridgeHeight * 0.3f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(archBridgeLength, archBridgeHeight * 0.6f, archBridgeWidth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.7f, 0.7f, 0.6f);  // 石灰色
+    color = glm::vec3(0.7f, 0.7f, 0.6f);  // 石灰色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 拱形部分（多个半圆柱）
     for (int i = 0; i < 5; i++) {
@@ -969,15 +1121,11 @@ void ObjectRenderer::renderArchBridge(const glm::vec3& position, float rotation,
         model = glm::rotate(model, glm::radians(90.0f), glm::vec3(0, 0, 1));
         model = glm::scale(model, glm::vec3(archBridgeWidth * 0.3f, archBridgeLength * 0.15f, archBridgeWidth * 0.3f));
         
-        shader->setMat4("uModel", model);
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addPart(PrimitiveType::CYLINDER, model, color);
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation) {
     // 江南水乡特色民居：两层楼房，带天井
     
     // 基础尺寸
@@ -989,15 +1137,14 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
     
     // 1. 底层墙体（白墙）
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, wallHeight * 0.5f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth, wallHeight, wallDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.82f, 0.9f, 0.86f);  // 淡青墙
+    color = glm::vec3(0.82f, 0.9f, 0.86f);  // 淡青墙
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 2. 二层墙体（更小的）
     model = glm::mat4(1.0f);
@@ -1005,9 +1152,7 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth * 0.8f, 0.8f, wallDepth * 0.8f));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
 
     // 门和窗户（底层）
     float doorWidth = 0.7f;
@@ -1019,10 +1164,8 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
     model = glm::translate(model, position + glm::vec3(0, doorHeight * 0.5f, wallDepth * 0.51f));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(doorWidth, doorHeight, 0.05f));
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.35f, 0.2f, 0.1f);  // 木门
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    color = glm::vec3(0.35f, 0.2f, 0.1f);  // 木门
+    addPart(PrimitiveType::CUBE, model, color);
 
     // 窗户
     for (int i = 0; i < 2; ++i) {
@@ -1031,10 +1174,8 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
         model = glm::translate(model, position + glm::vec3(wallWidth * 0.25f * side, wallHeight * 0.6f, wallDepth * 0.51f));
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(windowSize, windowSize, 0.05f));
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.45f, 0.65f, 0.9f);  // 玻璃
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        color = glm::vec3(0.45f, 0.65f, 0.9f);  // 玻璃
+        addPart(PrimitiveType::CUBE, model, color);
     }
     
     // 3. 屋顶（黑瓦）
@@ -1043,11 +1184,9 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth + roofOverhang, roofHeight, wallDepth + roofOverhang));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.25f, 0.25f, 0.25f);  // 黑瓦
+    color = glm::vec3(0.25f, 0.25f, 0.25f);  // 黑瓦
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 4. 天井（中间空出的庭院）
     // 底层门廊
@@ -1056,11 +1195,9 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wallWidth * 0.6f, wallHeight * 0.4f, wallDepth * 0.6f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.1f, 0.1f, 0.1f);  // 天井（深色表示阴影）
+    color = glm::vec3(0.1f, 0.1f, 0.1f);  // 天井（深色表示阴影）
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 5. 柱子（木质）
     for (int i = 0; i < 4; i++) {
@@ -1071,17 +1208,13 @@ void ObjectRenderer::renderHouseStyle1(const glm::vec3& position, float rotation
         model = glm::translate(model, position + offset);
         model = glm::scale(model, glm::vec3(0.1f, wallHeight, 0.1f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.4f, 0.25f, 0.1f);  // 木色
+        color = glm::vec3(0.4f, 0.25f, 0.1f);  // 木色
         
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addPart(PrimitiveType::CYLINDER, model, color);
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation) {
     // 精致庭院住宅：带花园的豪华住宅
     
     // 基础尺寸
@@ -1094,15 +1227,14 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
     
     // 1. 主建筑
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, mainHeight * 0.5f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(mainWidth, mainHeight, mainDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.9f, 0.83f, 0.92f);  // 淡紫墙
+    color = glm::vec3(0.9f, 0.83f, 0.92f);  // 淡紫墙
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 2. 左侧翼
     model = glm::mat4(1.0f);
@@ -1110,9 +1242,7 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wingWidth, mainHeight * 0.8f, wingDepth));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
 
     // 门和窗户（主立面）
     float doorWidth = 0.8f;
@@ -1124,10 +1254,8 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
     model = glm::translate(model, position + glm::vec3(0, doorHeight * 0.5f, mainDepth * 0.51f));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(doorWidth, doorHeight, 0.05f));
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.4f, 0.25f, 0.15f);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    color = glm::vec3(0.4f, 0.25f, 0.15f);
+    addPart(PrimitiveType::CUBE, model, color);
 
     // 窗户（左右翼前侧）
     for (int i = 0; i < 2; ++i) {
@@ -1136,10 +1264,8 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
         model = glm::translate(model, position + glm::vec3(xOffset, mainHeight * 0.6f, wingDepth * 0.51f));
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(windowSize, windowSize, 0.05f));
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.5f, 0.7f, 0.9f);
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        color = glm::vec3(0.5f, 0.7f, 0.9f);
+        addPart(PrimitiveType::CUBE, model, color);
     }
     
     // 3. 右侧翼
@@ -1148,9 +1274,7 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(wingWidth, mainHeight * 0.8f, wingDepth));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 4. 精致屋顶（多层）
     // 主屋顶
@@ -1159,11 +1283,9 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(mainWidth + 0.5f, roofHeight * 0.8f, mainDepth + 0.5f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.2f, 0.2f, 0.2f);  // 深黑瓦
+    color = glm::vec3(0.2f, 0.2f, 0.2f);  // 深黑瓦
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 翼屋顶
     for (int i = 0; i < 2; i++) {
@@ -1173,9 +1295,7 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(wingWidth + 0.3f, roofHeight * 0.6f, wingDepth + 0.3f));
         
-        shader->setMat4("uModel", model);
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        addPart(PrimitiveType::CUBE, model, color);
     }
     
     // 5. 花园装饰（小池塘）
@@ -1183,16 +1303,12 @@ void ObjectRenderer::renderHouseStyle2(const glm::vec3& position, float rotation
     model = glm::translate(model, position + glm::vec3(0, 0.05f, mainDepth * 0.7f));
     model = glm::scale(model, glm::vec3(1.5f, 0.1f, 1.0f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.3f, 0.6f, 0.8f);  // 水蓝色
+    color = glm::vec3(0.3f, 0.6f, 0.8f);  // 水蓝色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    
-    glBindVertexArray(0);
+    addPart(PrimitiveType::CUBE, model, color);
 }
 
-void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation) {
     // 传统祠堂：庄严肃穆的家族祠堂
     
     // 基础尺寸
@@ -1205,15 +1321,14 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
     
     // 1. 主厅
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, hallHeight * 0.5f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(hallWidth, hallHeight, hallDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.86f, 0.78f, 0.65f);  // 土黄墙
+    color = glm::vec3(0.86f, 0.78f, 0.65f);  // 土黄墙
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 2. 门廊
     model = glm::mat4(1.0f);
@@ -1221,11 +1336,9 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(porchWidth, hallHeight * 0.6f, porchDepth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.1f, 0.1f, 0.1f);  // 门廊（深色）
+    color = glm::vec3(0.1f, 0.1f, 0.1f);  // 门廊（深色）
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 3. 庄重屋顶（多重檐）
     // 底层屋顶
@@ -1234,11 +1347,9 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(hallWidth + 0.8f, roofHeight * 0.4f, hallDepth + 0.8f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.15f, 0.15f, 0.15f);  // 深黑瓦
+    color = glm::vec3(0.15f, 0.15f, 0.15f);  // 深黑瓦
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 上层屋顶
     model = glm::mat4(1.0f);
@@ -1246,9 +1357,7 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(hallWidth + 0.4f, roofHeight * 0.3f, hallDepth + 0.4f));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
 
     // 门和窗户
     float doorWidth = 1.0f;
@@ -1260,10 +1369,8 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
     model = glm::translate(model, position + glm::vec3(0, doorHeight * 0.5f, hallDepth * 0.62f));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(doorWidth, doorHeight, 0.06f));
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.35f, 0.2f, 0.1f);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    color = glm::vec3(0.35f, 0.2f, 0.1f);
+    addPart(PrimitiveType::CUBE, model, color);
 
     // 窗户（左右）
     for (int i = 0; i < 2; ++i) {
@@ -1272,10 +1379,8 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
         model = glm::translate(model, position + glm::vec3(hallWidth * 0.3f * side, hallHeight * 0.6f, hallDepth * 0.52f));
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(windowSize, windowSize, 0.05f));
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.45f, 0.65f, 0.85f);
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        color = glm::vec3(0.45f, 0.65f, 0.85f);
+        addPart(PrimitiveType::CUBE, model, color);
     }
     
     // 4. 柱子（粗壮的木柱）
@@ -1287,11 +1392,9 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
         model = glm::translate(model, position + glm::vec3(x, hallHeight * 0.5f, z));
         model = glm::scale(model, glm::vec3(0.15f, hallHeight, 0.15f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.3f, 0.2f, 0.1f);  // 深木色
+        color = glm::vec3(0.3f, 0.2f, 0.1f);  // 深木色
         
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addPart(PrimitiveType::CYLINDER, model, color);
     }
     
     // 5. 牌匾位置（装饰性立方体）
@@ -1300,17 +1403,13 @@ void ObjectRenderer::renderHouseStyle3(const glm::vec3& position, float rotation
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(1.0f, 0.3f, 0.05f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.8f, 0.6f, 0.2f);  // 金黄色
-    
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    color = glm::vec3(0.8f, 0.6f, 0.2f);  // 金黄色
     
-    glBindVertexArray(0);
+    addPart(PrimitiveType::CUBE, model, color);
 }
 
 
-void ObjectRenderer::renderPaifang(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderPaifang(const glm::vec3& position, float rotation) {
     // 牌坊 = 红色柱子和横梁
     
     // 基础尺寸
@@ -1318,15 +1417,14 @@ void ObjectRenderer::renderPaifang(const glm::vec3& position, float rotation, Sh
     float paifangHeight = 5.0f; // 牌坊高度
     
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, paifangHeight * 0.5f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(paifangWidth, paifangHeight, 0.3f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.9f, 0.2f, 0.2f);  // 深红色
+    color = glm::vec3(0.9f, 0.2f, 0.2f);  // 深红色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 装饰性拱顶
     model = glm::mat4(1.0f);
@@ -1334,14 +1432,10 @@ void ObjectRenderer::renderPaifang(const glm::vec3& position, float rotation, Sh
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(paifangWidth * 0.8f, paifangHeight * 0.2f, 0.4f));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    
-    glBindVertexArray(0);
+    addPart(PrimitiveType::CUBE, model, color);
 }
 
-void ObjectRenderer::renderWaterPavilion(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderWaterPavilion(const glm::vec3& position, float rotation) {
     // 水榭 = 建在水上的凉亭，带平台
     
     // 基础尺寸
@@ -1349,35 +1443,33 @@ void ObjectRenderer::renderWaterPavilion(const glm::vec3& position, float rotati
     
     // 平台
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, 0.1f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(waterPavilionSize, 0.2f, waterPavilionSize));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.8f, 0.8f, 0.7f);  // 浅灰色
+    color = glm::vec3(0.8f, 0.8f, 0.7f);  // 浅灰色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 柱子和屋顶（类似凉亭但更精致）
-    renderPavilion(position + glm::vec3(0, 0.2f, 0), rotation, shader);
+    renderPavilion(position + glm::vec3(0, 0.2f, 0), rotation);
 }
 
-void ObjectRenderer::renderPier(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderPier(const glm::vec3& position, float rotation) {
     // 码头 = 木质平台伸入水中
     float pierLength = 3.0f;  // 码头长度
     float pierWidth = 1.5f;   // 码头宽度
     
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, 0.05f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(pierLength, 0.1f, pierWidth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.4f, 0.2f);  // 木色
+    color = glm::vec3(0.6f, 0.4f, 0.2f);  // 木色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 支撑柱子
     for (int i = 0; i < 6; i++) {
@@ -1386,15 +1478,11 @@ void ObjectRenderer::renderPier(const glm::vec3& position, float rotation, Shade
         model = glm::translate(model, position + glm::vec3((i - 2.5f) * pierLength * 0.15f, -0.5f, z));
         model = glm::scale(model, glm::vec3(0.1f, 1.0f, 0.1f));
         
-        shader->setMat4("uModel", model);
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addPart(PrimitiveType::CYLINDER, model, color);
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderTemple(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderTemple(const glm::vec3& position, float rotation) {
     // 寺庙 = 多层建筑，带屋檐
     
     // 基础尺寸
@@ -1403,15 +1491,14 @@ void ObjectRenderer::renderTemple(const glm::vec3& position, float rotation, Sha
     
     // 主体建筑
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, templeHeight * 0.4f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(templeSize, templeHeight * 0.8f, templeSize));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.75f, 0.72f, 0.68f);  // 石灰色
+    color = glm::vec3(0.75f, 0.72f, 0.68f);  // 石灰色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 屋顶
     model = glm::mat4(1.0f);
@@ -1419,11 +1506,9 @@ void ObjectRenderer::renderTemple(const glm::vec3& position, float rotation, Sha
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(templeSize * 1.2f, templeHeight * 0.3f, templeSize * 1.2f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.7f, 0.3f, 0.3f);  // 红色屋顶
+    color = glm::vec3(0.7f, 0.3f, 0.3f);  // 红色屋顶
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
 
     // 门与窗户
     float doorWidth = 1.0f;
@@ -1435,10 +1520,8 @@ void ObjectRenderer::renderTemple(const glm::vec3& position, float rotation, Sha
     model = glm::translate(model, position + glm::vec3(0, doorHeight * 0.5f, templeSize * 0.51f));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(doorWidth, doorHeight, 0.06f));
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.4f, 0.25f, 0.15f);
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    color = glm::vec3(0.4f, 0.25f, 0.15f);
+    addPart(PrimitiveType::CUBE, model, color);
 
     // 窗户
     for (int i = 0; i < 2; ++i) {
@@ -1447,16 +1530,12 @@ void ObjectRenderer::renderTemple(const glm::vec3& position, float rotation, Sha
         model = glm::translate(model, position + glm::vec3(templeSize * 0.25f * side, templeHeight * 0.5f, templeSize * 0.51f));
         model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
         model = glm::scale(model, glm::vec3(windowSize, windowSize, 0.05f));
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.5f, 0.7f, 0.9f);
-        glBindVertexArray(m_cubeVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+        color = glm::vec3(0.5f, 0.7f, 0.9f);
+        addPart(PrimitiveType::CUBE, model, color);
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderBamboo(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderBamboo(const glm::vec3& position, float rotation) {
     // 树B（松树风格）：棕色树干 + 绿色锥形树冠
     float trunkHeight = 2.8f;
     float trunkRadius = 0.18f;
@@ -1464,44 +1543,38 @@ void ObjectRenderer::renderBamboo(const glm::vec3& position, float rotation, Sha
     float crownRadius = 1.6f;
 
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position);
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(trunkRadius, trunkHeight, trunkRadius));
 
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.35f, 0.22f, 0.12f);  // 树干棕色
+    color = glm::vec3(0.35f, 0.22f, 0.12f);  // 树干棕色
 
-    glBindVertexArray(m_cylinderVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+    addPart(PrimitiveType::CYLINDER, model, color);
 
     model = glm::mat4(1.0f);
     model = glm::translate(model, position + glm::vec3(0, trunkHeight - crownHeight * 0.1f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(crownRadius, crownHeight, crownRadius));
 
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.15f, 0.5f, 0.2f);  // 深绿树冠
+    color = glm::vec3(0.15f, 0.5f, 0.2f);  // 深绿树冠
 
-    glBindVertexArray(m_coneVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_coneVertexCount);
-
-    glBindVertexArray(0);
+    addPart(PrimitiveType::CONE, model, color);
 }
 
-void ObjectRenderer::renderLotusPond(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderLotusPond(const glm::vec3& position, float rotation) {
     // 荷花池 = 水面 + 荷叶 + 荷花
     float lotusPondSize = 3.0f;     // 荷花池大小
     
     // 水面（浅蓝色圆形区域）
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, 0.01f, 0));
     model = glm::scale(model, glm::vec3(lotusPondSize, 0.02f, lotusPondSize));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.4f, 0.7f, 0.9f);  // 浅蓝色
+    color = glm::vec3(0.4f, 0.7f, 0.9f);  // 浅蓝色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 荷叶（绿色扁平圆形）
     for (int i = 0; i < 5; i++) {
@@ -1513,92 +1586,75 @@ void ObjectRenderer::renderLotusPond(const glm::vec3& position, float rotation,
         model = glm::translate(model, position + offset);
         model = glm::scale(model, glm::vec3(0.5f, 0.01f, 0.5f));
         
-        shader->setMat4("uModel", model);
-        shader->setVec3("uObjectColor", 0.2f, 0.6f, 0.2f);  // 绿色
+        color = glm::vec3(0.2f, 0.6f, 0.2f);  // 绿色
         
-        glBindVertexArray(m_cylinderVAO);
-        glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+        addPart(PrimitiveType::CYLINDER, model, color);
     }
-    
-    glBindVertexArray(0);
 }
 
-void ObjectRenderer::renderFishingBoat(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderFishingBoat(const glm::vec3& position, float rotation) {
     // 渔船 = 小型船只，带桅杆
     float fishingBoatLength = 2.5f; // 渔船长度
     float fishingBoatWidth = 0.8f;  // 渔船宽度
     
     // 船身
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, 0.2f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(fishingBoatLength, 0.4f, fishingBoatWidth));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.6f, 0.4f, 0.2f);  // 木色
+    color = glm::vec3(0.6f, 0.4f, 0.2f);  // 木色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    addPart(PrimitiveType::CUBE, model, color);
     
     // 桅杆
     model = glm::mat4(1.0f);
     model = glm::translate(model, position + glm::vec3(0, 1.5f, 0));
     model = glm::scale(model, glm::vec3(0.05f, 1.0f, 0.05f));
     
-    shader->setMat4("uModel", model);
-    glBindVertexArray(m_cylinderVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
-    
-    glBindVertexArray(0);
+    addPart(PrimitiveType::CYLINDER, model, color);
 }
 
-void ObjectRenderer::renderLantern(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderLantern(const glm::vec3& position, float rotation) {
     // 灯笼 = 红色圆柱 + 顶部装饰
     float lanternHeight = 1.2f;     // 灯笼高度
     float lanternSize = 0.3f;       // 灯笼大小
     
     // 灯笼主体
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, lanternHeight * 0.4f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(lanternSize, lanternHeight * 0.8f, lanternSize));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.9f, 0.2f, 0.2f);  // 红色
+    color = glm::vec3(0.9f, 0.2f, 0.2f);  // 红色
     
-    glBindVertexArray(m_cylinderVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_cylinderVertexCount);
+    addPart(PrimitiveType::CYLINDER, model, color);
     
     // 顶部装饰
     model = glm::mat4(1.0f);
     model = glm::translate(model, position + glm::vec3(0, lanternHeight * 0.9f, 0));
     model = glm::scale(model, glm::vec3(lanternSize * 1.2f, lanternSize * 0.1f, lanternSize * 1.2f));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.8f, 0.8f, 0.2f);  // 金色
+    color = glm::vec3(0.8f, 0.8f, 0.2f);  // 金色
     
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    
-    glBindVertexArray(0);
+    addPart(PrimitiveType::CUBE, model, color);
 }
 
-void ObjectRenderer::renderStoneLion(const glm::vec3& position, float rotation, Shader* shader) {
+void ObjectRenderer::renderStoneLion(const glm::vec3& position, float rotation) {
     // 石狮子 = 灰色雕像
     float stoneLionSize = 0.8f;     // 石狮子大小
     
     glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color(1.0f);
     model = glm::translate(model, position + glm::vec3(0, stoneLionSize * 0.5f, 0));
     model = glm::rotate(model, glm::radians(rotation), glm::vec3(0, 1, 0));
     model = glm::scale(model, glm::vec3(stoneLionSize, stoneLionSize, stoneLionSize));
     
-    shader->setMat4("uModel", model);
-    shader->setVec3("uObjectColor", 0.5f, 0.5f, 0.5f);  // 灰色
-    
-    glBindVertexArray(m_sphereVAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_sphereVertexCount);
+    color = glm::vec3(0.5f, 0.5f, 0.5f);  // 灰色
     
-    glBindVertexArray(0);
+    addPart(PrimitiveType::SPHERE, model, color);
 }
 
 
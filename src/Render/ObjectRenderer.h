@@ -2,8 +2,10 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 #include "../Editor/SceneEditor.h"
+#include "../Core/SpatialIndex.h"
 
 namespace WaterTown {
 
@@ -19,8 +21,30 @@ struct SceneObject {
     float rotation;  // Y轴旋转角度
 };
 
+/**
+ * @brief 保留模式物体句柄
+ */
+using ObjectId = uint32_t;
+constexpr ObjectId INVALID_OBJECT_ID = 0xFFFFFFFFu;
+
+/**
+ * @brief 基础几何体类型
+ */
+enum class PrimitiveType {
+    CUBE,
+    CONE,
+    CYLINDER,
+    SPHERE,
+    COUNT
+};
+
 /**
  * @brief 建筑物和物体渲染器（使用简单几何体拼接）
+ *
+ * 保留模式：物体在添加/更新时拆成部件实例（模型矩阵、法线矩阵、颜色），
+ * 按几何体类型存放在各自的实例数组中并长期保留。删除采用"与末尾交换"保持数组紧凑。
+ * 每帧用空间索引收集视锥内且在渲染半径内的物体，只把这些物体的部件打包进实例缓冲，
+ * 再对每种几何体做一次实例化绘制；可见集合和实例都没有变化时不重新上传。
  */
 class ObjectRenderer {
 public:
@@ -29,14 +53,30 @@ public:
     
     /**
      * @brief 添加物体
+     * @return 物体句柄，用于之后的更新和删除
      */
-    void addObject(ObjectType type, const glm::vec3& position, float rotation = 0.0f);
+    ObjectId addObject(ObjectType type, const glm::vec3& position, float rotation = 0.0f);
+    
+    /**
+     * @brief 更新物体的位置和旋转（只重写该物体的实例）
+     */
+    void updateObject(ObjectId id, const glm::vec3& position, float rotation = 0.0f);
+    
+    /**
+     * @brief 删除物体
+     */
+    void removeObject(ObjectId id);
     
     /**
      * @brief 清空所有物体
      */
     void clear();
     
+    /**
+     * @brief 当前保留的物体数量
+     */
+    size_t getObjectCount() const { return m_objects.size() - m_freeIds.size(); }
+    
     /**
      * @brief 渲染所有物体
      */
@@ -62,8 +102,41 @@ public:
     
     float longHouseLength = 2.0f;   // Length multiplier for long house
     
+    float renderDistance = 350.0f;  // 物体渲染半径（<= 0 表示不按距离剔除）
+    
 private:
-    std::vector<SceneObject> m_objects;
+    /**
+     * @brief 部件在实例数组中的位置
+     */
+    struct PartSlot {
+        PrimitiveType type;
+        uint32_t index;
+    };
+    
+    /**
+     * @brief 保留的物体及其拥有的部件槽位
+     */
+    struct RetainedObject {
+        SceneObject desc;
+        std::vector<PartSlot> parts;
+        SpatialHandle indexHandle;  // 在 m_index 中的句柄（没有部件时无效）
+        bool alive;
+    };
+    
+    /**
+     * @brief 实例槽位的拥有者（用于交换删除后回写槽位下标）
+     */
+    struct SlotOwner {
+        ObjectId id;
+        uint32_t part;
+    };
+    
+    std::vector<RetainedObject> m_objects;  // 下标即 ObjectId
+    std::vector<ObjectId> m_freeIds;        // 可复用的句柄
+    
+    // 本渲染器使用的着色器变体（基础着色器变化时重新获取）
+    Shader* m_variantSource = nullptr;
+    Shader* m_shaderVariant = nullptr;
     
     // 几何体VAO/VBO
     GLuint m_cubeVAO, m_cubeVBO;
@@ -73,6 +146,71 @@ private:
     
     unsigned int m_coneVertexCount, m_cylinderVertexCount, m_sphereVertexCount;
     
+    static constexpr int PRIMITIVE_COUNT = static_cast<int>(PrimitiveType::COUNT);
+    
+    /**
+     * @brief 部件实例数据（逐实例顶点属性，location 4-12）
+     */
+    struct PartInstance {
+        glm::mat4 model;         // 已包含物体整体缩放
+        glm::mat3 normalMatrix;  // 预先计算的法线矩阵
+        glm::vec3 color;
+    };
+    
+    std::vector<PartInstance> m_instances[PRIMITIVE_COUNT];
+    std::vector<SlotOwner> m_slotOwners[PRIMITIVE_COUNT];
+    GLuint m_instanceVBO[PRIMITIVE_COUNT];
+    size_t m_instanceCapacityBytes[PRIMITIVE_COUNT];
+    
+    // 可见性剔除：物体位置索引（值为 ObjectId），以及上一次打包上传的可见物体
+    SpatialIndex m_index;
+    std::vector<uint32_t> m_visibleIds;   // 本帧可见的物体（已排序）
+    std::vector<uint32_t> m_uploadedIds;  // 实例缓冲当前对应的可见物体
+    std::vector<PartInstance> m_visibleInstances[PRIMITIVE_COUNT];
+    bool m_instancesChanged;              // 上次上传后有部件增删
+    
+    // 正在拆分的物体（addPart 把部件登记到该物体下）
+    ObjectId m_buildingId;
+    // 当前物体的整体缩放变换（绕物体位置缩放），在拆分每个物体前设置
+    glm::mat4 m_objectTransform;
+    
+    /**
+     * @brief 为几何体 VAO 配置逐实例属性
+     */
+    void setupInstanceAttributes(PrimitiveType type);
+    GLuint getPrimitiveVAO(PrimitiveType type) const;
+    GLsizei getPrimitiveVertexCount(PrimitiveType type) const;
+    
+    /**
+     * @brief 收集一个部件实例
+     */
+    void addPart(PrimitiveType type, const glm::mat4& model, const glm::vec3& color);
+    
+    /**
+     * @brief 把物体拆分为部件实例并登记到 id 下
+     */
+    void buildObjectParts(ObjectId id);
+    
+    /**
+     * @brief 释放物体的全部部件槽位
+     */
+    void releaseObjectParts(ObjectId id);
+    
+    /**
+     * @brief 物体所有部件的包围球半径（以物体位置为球心）
+     */
+    float computeBoundsRadius(ObjectId id) const;
+    
+    /**
+     * @brief 用空间索引收集本帧可见的物体（视锥 + 渲染半径）
+     */
+    void collectVisibleObjects(Camera* camera);
+    
+    /**
+     * @brief 把可见物体的部件打包后写入对应几何体的实例缓冲
+     */
+    void uploadVisibleInstances(int primitive);
+    
     /**
      * @brief 生成基础几何体
      */
@@ -82,32 +220,32 @@ private:
     void generateSphere();
     
     /**
-     * @brief 渲染不同类型的物体
-     */
-    void renderHouse(const glm::vec3& position, float rotation, Shader* shader);
-    void renderHouseStyle1(const glm::vec3& position, float rotation, Shader* shader);
-    void renderHouseStyle2(const glm::vec3& position, float rotation, Shader* shader);
-    void renderHouseStyle3(const glm::vec3& position, float rotation, Shader* shader);
-    void renderHouseStyle4(const glm::vec3& position, float rotation, Shader* shader);
-    void renderHouseStyle5(const glm::vec3& position, float rotation, Shader* shader);
-    void renderLongHouse(const glm::vec3& position, float rotation, Shader* shader);
-    void renderBridge(const glm::vec3& position, float rotation, Shader* shader);
-    void renderTree(const glm::vec3& position, float rotation, Shader* shader);
-    void renderPlant1(const glm::vec3& position, float rotation, Shader* shader);
-    void renderPlant2(const glm::vec3& position, float rotation, Shader* shader);
-    void renderPlant4(const glm::vec3& position, float rotation, Shader* shader);
-    void renderWall(const glm::vec3& position, float rotation, Shader* shader);
-    void renderPavilion(const glm::vec3& position, float rotation, Shader* shader);
-    void renderArchBridge(const glm::vec3& position, float rotation, Shader* shader);
-    void renderPaifang(const glm::vec3& position, float rotation, Shader* shader);
-    void renderWaterPavilion(const glm::vec3& position, float rotation, Shader* shader);
-    void renderPier(const glm::vec3& position, float rotation, Shader* shader);
-    void renderTemple(const glm::vec3& position, float rotation, Shader* shader);
-    void renderBamboo(const glm::vec3& position, float rotation, Shader* shader);
-    void renderLotusPond(const glm::vec3& position, float rotation, Shader* shader);
-    void renderFishingBoat(const glm::vec3& position, float rotation, Shader* shader);
-    void renderLantern(const glm::vec3& position, float rotation, Shader* shader);
-    void renderStoneLion(const glm::vec3& position, float rotation, Shader* shader);
+     * @brief 把不同类型的物体拆分为部件实例
+     */
+    void renderHouse(const glm::vec3& position, float rotation);
+    void renderHouseStyle1(const glm::vec3& position, float rotation);
+    void renderHouseStyle2(const glm::vec3& position, float rotation);
+    void renderHouseStyle3(const glm::vec3& position, float rotation);
+    void renderHouseStyle4(const glm::vec3& position, float rotation);
+    void renderHouseStyle5(const glm::vec3& position, float rotation);
+    void renderLongHouse(const glm::vec3& position, float rotation);
+    void renderBridge(const glm::vec3& position, float rotation);
+    void renderTree(const glm::vec3& position, float rotation);
+    void renderPlant1(const glm::vec3& position, float rotation);
+    void renderPlant2(const glm::vec3& position, float rotation);
+    void renderPlant4(const glm::vec3& position, float rotation);
+    void renderWall(const glm::vec3& position, float rotation);
+    void renderPavilion(const glm::vec3& position, float rotation);
+    void renderArchBridge(const glm::vec3& position, float rotation);
+    void renderPaifang(const glm::vec3& position, float rotation);
+    void renderWaterPavilion(const glm::vec3& position, float rotation);
+    void renderPier(const glm::vec3& position, float rotation);
+    void renderTemple(const glm::vec3& position, float rotation);
+    void renderBamboo(const glm::vec3& position, float rotation);
+    void renderLotusPond(const glm::vec3& position, float rotation);
+    void renderFishingBoat(const glm::vec3& position, float rotation);
+    void renderLantern(const glm::vec3& position, float rotation);
+    void renderStoneLion(const glm::vec3& position, float rotation);
 };
 
 } // namespace WaterTown
@@ -1,4 +1,9 @@
 #include "Shader.h"
+#include "UniformBuffers.h"
+#include "ShaderCache.h"
+#include "GLState.h"
+#include "GLCounters.h"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -6,70 +11,233 @@
 
 namespace WaterTown {
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath) {
-    // 1. 从文件加载着色器源代码
-    std::string vertexCode = loadShaderSource(vertexPath);
-    std::string fragmentCode = loadShaderSource(fragmentPath);
+Shader::Shader(const char* vertexPath, const char* fragmentPath) : m_programID(0) {
+    // 1. 从文件加载着色器源代码（保留下来供变体使用）
+    m_vertexSource = loadShaderSource(vertexPath);
+    m_fragmentSource = loadShaderSource(fragmentPath);
     
-    const char* vShaderCode = vertexCode.c_str();
-    const char* fShaderCode = fragmentCode.c_str();
+    // 2. 构建默认程序（不带任何宏）
+    buildProgram(m_vertexSource, m_fragmentSource);
+}
+
+Shader::Shader(const std::string& vertexCode, const std::string& fragmentCode) : m_programID(0) {
+    buildProgram(vertexCode, fragmentCode);
+}
+
+void Shader::buildProgram(const std::string& vertexCode, const std::string& fragmentCode) {
+    // 优先从程序二进制缓存恢复（键包含源码，不同变体自然区分开）
+    std::string cacheKey = ShaderCache::makeKey(vertexCode, fragmentCode);
+    m_programID = ShaderCache::loadProgram(cacheKey);
+    if (m_programID != 0) {
+        std::cout << "Shader program loaded from cache (ID: " << m_programID << ")" << std::endl;
+    } else {
+        m_programID = compileProgram(vertexCode.c_str(), fragmentCode.c_str());
+        
+        GLint linked = GL_FALSE;
+        glGetProgramiv(m_programID, GL_LINK_STATUS, &linked);
+        if (linked) {
+            ShaderCache::storeProgram(cacheKey, m_programID);
+        }
+        std::cout << "Shader program created successfully (ID: " << m_programID << ")" << std::endl;
+    }
+    
+    UniformBuffers::bindProgramBlocks(m_programID);
+    cacheUniformLocations();
+}
+
+Shader* Shader::getVariant(const std::vector<std::string>& defines) {
+    if (defines.empty()) return this;
     
-    // 2. 编译着色器
-    unsigned int vertex = compileShader(vShaderCode, GL_VERTEX_SHADER);
-    unsigned int fragment = compileShader(fShaderCode, GL_FRAGMENT_SHADER);
+    // 排序后拼接作为键，调用方传入的顺序不影响结果
+    std::vector<std::string> sorted(defines);
+    std::sort(sorted.begin(), sorted.end());
+    std::string defineBlock;
+    for (const std::string& define : sorted) {
+        defineBlock += "#define " + define + "\n";
+    }
     
-    // 3. 链接着色器程序
-    m_programID = glCreateProgram();
-    glAttachShader(m_programID, vertex);
-    glAttachShader(m_programID, fragment);
-    glLinkProgram(m_programID);
-    checkCompileErrors(m_programID, "PROGRAM");
+    auto it = m_variants.find(defineBlock);
+    if (it != m_variants.end()) return it->second;
     
-    // 4. 删除着色器对象（已经链接到程序中，不再需要）
+    Shader* variant = new Shader(injectDefines(m_vertexSource, defineBlock),
+                                 injectDefines(m_fragmentSource, defineBlock));
+    m_variants[defineBlock] = variant;
+    return variant;
+}
+
+std::string Shader::injectDefines(const std::string& source, const std::string& defineBlock) {
+    // GLSL 要求 #version 是第一条语句，宏只能放在它后面
+    size_t versionPos = source.find("#version");
+    if (versionPos == std::string::npos) {
+        return defineBlock + source;
+    }
+    size_t lineEnd = source.find('\n', versionPos);
+    if (lineEnd == std::string::npos) {
+        return source + "\n" + defineBlock;
+    }
+    std::string result;
+    result.reserve(source.size() + defineBlock.size());
+    result.append(source, 0, lineEnd + 1);
+    result += defineBlock;
+    // 恢复行号，编译错误日志仍对应源文件中的行
+    long nextLine = std::count(source.begin(), source.begin() + lineEnd + 1, '\n') + 1;
+    result += "#line " + std::to_string(nextLine) + "\n";
+    result.append(source, lineEnd + 1, std::string::npos);
+    return result;
+}
+
+unsigned int Shader::compileProgram(const char* vertexSource, const char* fragmentSource) {
+    // 编译着色器
+    unsigned int vertex = compileShader(vertexSource, GL_VERTEX_SHADER);
+    unsigned int fragment = compileShader(fragmentSource, GL_FRAGMENT_SHADER);
+    
+    // 链接着色器程序
+    unsigned int program = glCreateProgram();
+    ShaderCache::prepareProgram(program);
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    glLinkProgram(program);
+    checkCompileErrors(program, "PROGRAM");
+    
+    // 删除着色器对象（已经链接到程序中，不再需要）
     glDeleteShader(vertex);
     glDeleteShader(fragment);
-    
-    std::cout << "Shader program created successfully (ID: " << m_programID << ")" << std::endl;
+    return program;
 }
 
 Shader::~Shader() {
-    glDeleteProgram(m_programID);
+    for (auto& entry : m_variants) {
+        delete entry.second;
+    }
+    GLState::deleteProgram(m_programID);
 }
 
 void Shader::use() const {
-    glUseProgram(m_programID);
+    GLState::useProgram(m_programID);
+}
+
+void Shader::cacheUniformLocations() {
+    m_uniformLocations.clear();
+    
+    GLint uniformCount = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(m_programID, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(m_programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    if (uniformCount <= 0 || maxNameLength <= 0) return;
+    
+    std::string nameBuffer(static_cast<size_t>(maxNameLength), '\0');
+    for (GLint i = 0; i < uniformCount; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_programID, static_cast<GLuint>(i), maxNameLength, &length, &size, &type, &nameBuffer[0]);
+        std::string name(nameBuffer.data(), static_cast<size_t>(length));
+        
+        GLint location = glGetUniformLocation(m_programID, name.c_str());
+        if (location < 0) continue;  // uniform block 中的成员没有位置
+        m_uniformLocations[name] = location;
+        
+        // 基础类型数组：驱动只报告 "name[0]"，补全其余元素和不带下标的名字
+        const std::string arraySuffix = "[0]";
+        if (name.size() > arraySuffix.size() &&
+            name.compare(name.size() - arraySuffix.size(), arraySuffix.size(), arraySuffix) == 0) {
+            std::string baseName = name.substr(0, name.size() - arraySuffix.size());
+            m_uniformLocations[baseName] = location;
+            for (GLint element = 1; element < size; ++element) {
+                std::string elementName = baseName + "[" + std::to_string(element) + "]";
+                m_uniformLocations[elementName] = glGetUniformLocation(m_programID, elementName.c_str());
+            }
+        }
+    }
+}
+
+GLint Shader::getUniformLocation(const std::string& name) const {
+    auto it = m_uniformLocations.find(name);
+    return it != m_uniformLocations.end() ? it->second : -1;
 }
 
 void Shader::setBool(const std::string& name, bool value) const {
-    glUniform1i(glGetUniformLocation(m_programID, name.c_str()), static_cast<int>(value));
+    GLCounters::recordUniform();
+    glUniform1i(getUniformLocation(name), static_cast<int>(value));
 }
 
 void Shader::setInt(const std::string& name, int value) const {
-    glUniform1i(glGetUniformLocation(m_programID, name.c_str()), value);
+    GLCounters::recordUniform();
+    glUniform1i(getUniformLocation(name), value);
 }
 
 void Shader::setFloat(const std::string& name, float value) const {
-    glUniform1f(glGetUniformLocation(m_programID, name.c_str()), value);
+    GLCounters::recordUniform();
+    glUniform1f(getUniformLocation(name), value);
 }
 
 void Shader::setVec3(const std::string& name, const glm::vec3& value) const {
-    glUniform3fv(glGetUniformLocation(m_programID, name.c_str()), 1, glm::value_ptr(value));
+    GLCounters::recordUniform();
+    glUniform3fv(getUniformLocation(name), 1, glm::value_ptr(value));
 }
 
 void Shader::setVec3(const std::string& name, float x, float y, float z) const {
-    glUniform3f(glGetUniformLocation(m_programID, name.c_str()), x, y, z);
+    GLCounters::recordUniform();
+    glUniform3f(getUniformLocation(name), x, y, z);
 }
 
 void Shader::setVec2(const std::string& name, const glm::vec2& value) const {
-    glUniform2fv(glGetUniformLocation(m_programID, name.c_str()), 1, glm::value_ptr(value));
+    GLCounters::recordUniform();
+    glUniform2fv(getUniformLocation(name), 1, glm::value_ptr(value));
 }
 
 void Shader::setVec2(const std::string& name, float x, float y) const {
-    glUniform2f(glGetUniformLocation(m_programID, name.c_str()), x, y);
+    GLCounters::recordUniform();
+    glUniform2f(getUniformLocation(name), x, y);
 }
 
 void Shader::setMat4(const std::string& name, const glm::mat4& value) const {
-    glUniformMatrix4fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+    GLCounters::recordUniform();
+    glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Shader::setBool(UniformHandle handle, bool value) const {
+    GLCounters::recordUniform();
+    glUniform1i(handle.location, static_cast<int>(value));
+}
+
+void Shader::setInt(UniformHandle handle, int value) const {
+    GLCounters::recordUniform();
+    glUniform1i(handle.location, value);
+}
+
+void Shader::setFloat(UniformHandle handle, float value) const {
+    GLCounters::recordUniform();
+    glUniform1f(handle.location, value);
+}
+
+void Shader::setVec2(UniformHandle handle, const glm::vec2& value) const {
+    GLCounters::recordUniform();
+    glUniform2fv(handle.location, 1, glm::value_ptr(value));
+}
+
+void Shader::setVec3(UniformHandle handle, const glm::vec3& value) const {
+    GLCounters::recordUniform();
+    glUniform3fv(handle.location, 1, glm::value_ptr(value));
+}
+
+void Shader::setMat4(UniformHandle handle, const glm::mat4& value) const {
+    GLCounters::recordUniform();
+    glUniformMatrix4fv(handle.location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Shader::setFloatArray(UniformHandle handle, const float* values, int count) const {
+    if (count > 0) {
+        GLCounters::recordUniform();
+        glUniform1fv(handle.location, count, values);
+    }
+}
+
+void Shader::setVec3Array(UniformHandle handle, const glm::vec3* values, int count) const {
+    if (count > 0) {
+        GLCounters::recordUniform();
+        glUniform3fv(handle.location, count, glm::value_ptr(values[0]));
+    }
 }
 
 std::string Shader::loadShaderSource(const char* path) {
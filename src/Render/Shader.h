@@ -2,12 +2,32 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace WaterTown {
 
+/**
+ * @brief 预先解析好的 uniform 位置
+ *
+ * 通过 Shader::getUniform 获取一次后保存，热点路径用它设置 uniform，不再做任何字符串处理。
+ * 位置为 -1 时设置操作会被 OpenGL 忽略（与 uniform 不存在时的行为一致）。
+ */
+struct UniformHandle {
+    GLint location = -1;
+    
+    bool isValid() const { return location >= 0; }
+};
+
 /**
  * @brief 着色器管理类，支持从文件加载、编译、链接着色器程序
+ *
+ * 链接结果会通过 ShaderCache 写入磁盘，下次启动时源码和驱动未变则直接加载二进制。
+ *
+ * 同一对源文件可以派生出多个变体（getVariant）：在 #version 行之后注入 #define，
+ * 让着色器在编译期裁掉用不到的分支。变体在第一次请求时编译，之后一直复用。
  */
 class Shader {
 public:
@@ -27,6 +47,20 @@ public:
     Shader(const Shader&) = delete;
     Shader& operator=(const Shader&) = delete;
     
+    /**
+     * @brief 获取带预定义宏的变体（首次请求时编译并缓存）
+     * @param defines 宏列表，每项形如 "NAME" 或 "NAME VALUE"，顺序无关
+     * @return 变体着色器，由本对象持有；defines 为空时返回自身
+     *
+     * 查找需要拼接字符串，调用方应保存返回的指针，而不是每帧调用。
+     */
+    Shader* getVariant(const std::vector<std::string>& defines);
+    
+    /**
+     * @brief 已编译的变体数量（不含自身）
+     */
+    size_t getVariantCount() const { return m_variants.size(); }
+    
     /**
      * @brief 使用/激活着色器程序
      */
@@ -38,6 +72,17 @@ public:
      */
     unsigned int getID() const { return m_programID; }
     
+    /**
+     * @brief 查询 uniform 位置（链接时已缓存所有活跃 uniform，不访问驱动）
+     * @return 位置，不存在时返回 -1
+     */
+    GLint getUniformLocation(const std::string& name) const;
+    
+    /**
+     * @brief 获取 uniform 句柄（应在初始化时调用并保存结果）
+     */
+    UniformHandle getUniform(const std::string& name) const { return {getUniformLocation(name)}; }
+    
     // Uniform 设置方法
     void setBool(const std::string& name, bool value) const;
     void setInt(const std::string& name, int value) const;
@@ -47,9 +92,50 @@ public:
     void setVec3(const std::string& name, const glm::vec3& value) const;
     void setVec3(const std::string& name, float x, float y, float z) const;
     void setMat4(const std::string& name, const glm::mat4& value) const;
+    
+    // 通过句柄设置（无字符串查找）
+    void setBool(UniformHandle handle, bool value) const;
+    void setInt(UniformHandle handle, int value) const;
+    void setFloat(UniformHandle handle, float value) const;
+    void setVec2(UniformHandle handle, const glm::vec2& value) const;
+    void setVec3(UniformHandle handle, const glm::vec3& value) const;
+    void setMat4(UniformHandle handle, const glm::mat4& value) const;
+    
+    /**
+     * @brief 一次设置整个数组（handle 为数组第 0 个元素）
+     */
+    void setFloatArray(UniformHandle handle, const float* values, int count) const;
+    void setVec3Array(UniformHandle handle, const glm::vec3* values, int count) const;
 
 private:
     unsigned int m_programID;
+    std::unordered_map<std::string, GLint> m_uniformLocations;  // 活跃 uniform 的位置缓存
+    
+    std::string m_vertexSource;                  // 原始源码（用于编译变体）
+    std::string m_fragmentSource;
+    std::map<std::string, Shader*> m_variants;   // 宏集合 -> 变体（本对象持有）
+    
+    /**
+     * @brief 变体使用的构造函数，直接从源码构建
+     */
+    Shader(const std::string& vertexCode, const std::string& fragmentCode);
+    
+    /**
+     * @brief 从缓存加载或编译程序，然后绑定 uniform block 并缓存 uniform 位置
+     */
+    void buildProgram(const std::string& vertexCode, const std::string& fragmentCode);
+    
+    /**
+     * @brief 把宏定义插入到 #version 行之后（没有 #version 时插入到开头）
+     */
+    static std::string injectDefines(const std::string& source, const std::string& defineBlock);
+    
+    /**
+     * @brief 链接后遍历所有活跃 uniform，缓存它们的位置
+     *
+     * 数组会同时登记 "name"、"name[0]" 到 "name[n-1]"。
+     */
+    void cacheUniformLocations();
     
     /**
      * @brief 从文件加载着色器源代码
@@ -58,6 +144,11 @@ private:
      */
     std::string loadShaderSource(const char* path);
     
+    /**
+     * @brief 从源码编译并链接程序（缓存未命中时使用）
+     */
+    unsigned int compileProgram(const char* vertexSource, const char* fragmentSource);
+    
     /**
      * @brief 编译着色器
      * @param source 着色器源代码
@@ -0,0 +1,157 @@
+#include "ShaderCache.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+namespace WaterTown {
+
+namespace {
+
+const uint32_t CACHE_MAGIC = 0x42505457;  // "WTPB"
+const uint32_t CACHE_VERSION = 1;
+
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t format;  // glGetProgramBinary 返回的二进制格式
+    uint32_t length;  // 二进制字节数
+};
+
+std::string& cacheDirectory() {
+    static std::string directory = "shader_cache";
+    return directory;
+}
+
+// FNV-1a 64 位哈希
+void hashAppend(uint64_t& hash, const std::string& data) {
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    // 分隔符，避免 "ab"+"c" 与 "a"+"bc" 相同
+    hash ^= 0xFF;
+    hash *= 1099511628211ULL;
+}
+
+std::string glString(GLenum name) {
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+bool ensureDirectory(const std::string& path) {
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0) {
+        return (info.st_mode & S_IFDIR) != 0;
+    }
+#ifdef _WIN32
+    return _mkdir(path.c_str()) == 0;
+#else
+    return mkdir(path.c_str(), 0755) == 0;
+#endif
+}
+
+} // namespace
+
+void ShaderCache::setDirectory(const std::string& directory) {
+    cacheDirectory() = directory;
+}
+
+const std::string& ShaderCache::getDirectory() {
+    return cacheDirectory();
+}
+
+bool ShaderCache::isSupported() {
+    if (cacheDirectory().empty()) return false;
+    if (!GLAD_GL_VERSION_4_1 && !GLAD_GL_ARB_get_program_binary) return false;
+
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+std::string ShaderCache::makeKey(const std::string& vertexSource, const std::string& fragmentSource) {
+    uint64_t hash = 14695981039346656037ULL;
+    hashAppend(hash, vertexSource);
+    hashAppend(hash, fragmentSource);
+    hashAppend(hash, glString(GL_VENDOR));
+    hashAppend(hash, glString(GL_RENDERER));
+    hashAppend(hash, glString(GL_VERSION));
+
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+std::string ShaderCache::cachePath(const std::string& key) {
+    return cacheDirectory() + "/" + key + ".bin";
+}
+
+GLuint ShaderCache::loadProgram(const std::string& key) {
+    if (!isSupported()) return 0;
+
+    std::ifstream in(cachePath(key), std::ios::binary);
+    if (!in) return 0;
+
+    CacheHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.length == 0) {
+        return 0;
+    }
+
+    std::vector<char> binary(header.length);
+    if (!in.read(binary.data(), binary.size())) {
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    // 驱动升级等情况下旧二进制会被拒绝，此时回退到源码编译
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+void ShaderCache::prepareProgram(GLuint program) {
+    if (isSupported()) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+}
+
+void ShaderCache::storeProgram(const std::string& key, GLuint program) {
+    if (!isSupported()) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    if (!ensureDirectory(cacheDirectory())) {
+        std::cerr << "Shader cache: cannot create directory " << cacheDirectory() << std::endl;
+        return;
+    }
+
+    std::ofstream out(cachePath(key), std::ios::binary | std::ios::trunc);
+    if (!out) return;
+
+    CacheHeader header = {CACHE_MAGIC, CACHE_VERSION, static_cast<uint32_t>(format), static_cast<uint32_t>(written)};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(binary.data(), written);
+}
+
+} // namespace WaterTown
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <string>
+
+namespace WaterTown {
+
+/**
+ * @brief 着色器程序二进制磁盘缓存
+ *
+ * 以 (顶点源码, 片段源码, GL 厂商, 渲染器, 驱动版本) 的哈希作为键，
+ * 用 glGetProgramBinary / glProgramBinary 保存和恢复已链接的程序。
+ * 缓存缺失、驱动不支持或驱动拒绝旧二进制时返回 0，由调用方照常编译。
+ */
+class ShaderCache {
+public:
+    /**
+     * @brief 设置缓存目录（为空表示禁用缓存），默认 "shader_cache"
+     */
+    static void setDirectory(const std::string& directory);
+    static const std::string& getDirectory();
+
+    /**
+     * @brief 当前上下文是否支持程序二进制（GL 4.1 或 ARB_get_program_binary，且至少有一种格式）
+     */
+    static bool isSupported();
+
+    /**
+     * @brief 计算缓存键（需要有效的 GL 上下文）
+     */
+    static std::string makeKey(const std::string& vertexSource, const std::string& fragmentSource);
+
+    /**
+     * @brief 尝试从缓存创建程序
+     * @return 链接成功的程序 ID，缓存缺失或失效时返回 0
+     */
+    static GLuint loadProgram(const std::string& key);
+
+    /**
+     * @brief 链接前调用，提示驱动保留可读取的二进制
+     */
+    static void prepareProgram(GLuint program);
+
+    /**
+     * @brief 把已链接的程序写入缓存
+     */
+    static void storeProgram(const std::string& key, GLuint program);
+
+private:
+    static std::string cachePath(const std::string& key);
+};
+
+} // namespace WaterTown
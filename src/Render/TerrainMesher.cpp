@@ -0,0 +1,255 @@
+#include "TerrainMesher.h"
+#include <algorithm>
+
+namespace WaterTown {
+
+TerrainMesher::TerrainMesher(float cellSize, float waterLevel)
+    : m_cellSize(cellSize), m_waterLevel(waterLevel) {}
+
+glm::vec3 TerrainMesher::getTerrainColor(TerrainType type) {
+    switch (type) {
+        case TerrainType::GRASS:
+            return glm::vec3(0.3f, 0.7f, 0.3f);
+        case TerrainType::WATER:
+            return glm::vec3(0.2f, 0.4f, 0.9f);
+        case TerrainType::STONE:
+            return glm::vec3(0.7f, 0.7f, 0.7f);
+        case TerrainType::EMPTY:
+            return glm::vec3(0.0f); // 透明/不可见
+        default:
+            return glm::vec3(1.0f, 1.0f, 1.0f);
+    }
+}
+
+float TerrainMesher::getTerrainHeight(TerrainType type) const {
+    switch (type) {
+        case TerrainType::GRASS:
+            return 1.0f;
+        case TerrainType::STONE:
+            return 1.1f;
+        case TerrainType::WATER:
+            return m_waterLevel;
+        default:
+            return 0.3f;
+    }
+}
+
+void TerrainMesher::buildChunk(const TerrainMap& terrain, int chunkX, int chunkZ, TerrainChunkMesh& out) {
+    const float cellSize = m_cellSize;
+    const float expand = cellSize * 0.05f; // slight overlap to avoid cracks on the plane
+    const glm::vec3 upNormal(0.0f, 1.0f, 0.0f);
+
+    out.clear();
+
+    // 地形存储与渲染区块对齐，区块内的格子是连续的一段内存
+    if (chunkX < 0 || chunkX >= terrain.getChunksX() || chunkZ < 0 || chunkZ >= terrain.getChunksZ()) {
+        return;
+    }
+    const float halfSizeX = terrain.getSizeX() / 2.0f;
+    const float halfSizeZ = terrain.getSizeZ() / 2.0f;
+    const TerrainType* cellTypes = terrain.chunkTypes(chunkX, chunkZ);
+    const uint8_t* waterMasks = terrain.chunkWaterMask(chunkX, chunkZ);
+
+    // 陆地顶面：同类型的相邻格子合并为一个矩形（区块填充部分为 EMPTY，不参与合并）
+    static_assert(sizeof(TerrainType) == sizeof(uint8_t), "TerrainType must be 1 byte");
+    const uint32_t landMask = (1u << static_cast<uint32_t>(TerrainType::GRASS)) |
+                              (1u << static_cast<uint32_t>(TerrainType::STONE));
+    m_mesher.mergeRects(reinterpret_cast<const uint8_t*>(cellTypes), CHUNK_SIZE, CHUNK_SIZE, landMask, m_rects);
+
+    for (const auto& rect : m_rects) {
+        TerrainType type = static_cast<TerrainType>(rect.value);
+        float height = getTerrainHeight(type);
+        glm::vec3 color = getTerrainColor(type);
+
+        int x = chunkX * CHUNK_SIZE + rect.x;
+        int z = chunkZ * CHUNK_SIZE + rect.z;
+        float x0 = (x - halfSizeX) * cellSize - expand * 0.5f;
+        float z0 = (z - halfSizeZ) * cellSize - expand * 0.5f;
+        float x1 = x0 + rect.sizeX * cellSize + expand;
+        float z1 = z0 + rect.sizeZ * cellSize + expand;
+
+        uint32_t base = static_cast<uint32_t>(out.vertices.size());
+        out.vertices.push_back({glm::vec3(x0, height, z0), upNormal, color});
+        out.vertices.push_back({glm::vec3(x1, height, z0), upNormal, color});
+        out.vertices.push_back({glm::vec3(x1, height, z1), upNormal, color});
+        out.vertices.push_back({glm::vec3(x0, height, z1), upNormal, color});
+        GreedyMesher::appendQuadIndices(base, out.indices);
+    }
+
+    // 河岸砖墙：与水面相邻的陆地格子记录一个 (模板, 格子偏移) 实例
+    // 邻接水面掩码由 TerrainMap 维护，越界邻居视为非水面，河岸只在陆地和水之间生成
+    for (int cell = 0; cell < TerrainMap::CHUNK_CELLS; ++cell) {
+        int templateIndex = brickTemplateIndex(cellTypes[cell], waterMasks[cell]);
+        if (templateIndex < 0) {
+            continue;
+        }
+        int x = chunkX * CHUNK_SIZE + cell % CHUNK_SIZE;
+        int z = chunkZ * CHUNK_SIZE + cell / CHUNK_SIZE;
+        float tileX0 = (x - halfSizeX) * cellSize;
+        float tileZ0 = (z - halfSizeZ) * cellSize;
+        out.brickOffsets.push_back(glm::vec3(tileX0, 0.0f, tileZ0));
+        out.brickTemplates.push_back(static_cast<uint8_t>(templateIndex));
+    }
+}
+
+int TerrainMesher::brickTemplateIndex(TerrainType type, uint8_t waterMask) {
+    if (waterMask == 0 || waterMask >= BRICK_MASK_COUNT) {
+        return -1;
+    }
+    switch (type) {
+        case TerrainType::GRASS:
+            return waterMask;
+        case TerrainType::STONE:
+            return BRICK_MASK_COUNT + waterMask;
+        default:
+            return -1;
+    }
+}
+
+void TerrainMesher::buildBrickTemplates(std::vector<TerrainVertex>& outVertices, std::vector<uint32_t>& outIndices,
+                                        uint32_t outFirstIndex[BRICK_TEMPLATE_COUNT],
+                                        uint32_t outIndexCount[BRICK_TEMPLATE_COUNT]) const {
+    const float cellSize = m_cellSize;
+    const float waterSurface = getTerrainHeight(TerrainType::WATER);
+    const float wallBase = waterSurface - 0.1f; // sink a bit into the river to avoid gaps
+    const float brickScale = 4.0f;
+    const float wallThickness = cellSize * 0.45f * brickScale;
+    const float verticalGap = 0.01f * brickScale;
+    const float horizontalGap = cellSize * 0.04f * brickScale;
+    const float baseBrickHeight = cellSize * 0.15f;
+    const float baseBrickLength = cellSize * 0.25f;
+    const float scaledBrickHeight = baseBrickHeight * brickScale;
+    const float scaledBrickLength = baseBrickLength * brickScale;
+    const glm::vec3 wallColorDark(0.35f, 0.35f, 0.35f);
+    const glm::vec3 wallColorLight(0.45f, 0.45f, 0.45f);
+
+    std::vector<TerrainVertex>& vertices = outVertices;
+    std::vector<uint32_t>& indices = outIndices;
+    vertices.clear();
+    indices.clear();
+    std::fill(outFirstIndex, outFirstIndex + BRICK_TEMPLATE_COUNT, 0u);
+    std::fill(outIndexCount, outIndexCount + BRICK_TEMPLATE_COUNT, 0u);
+
+    auto addQuad = [&vertices, &indices](const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, const glm::vec3& v3,
+                       const glm::vec3& normal, const glm::vec3& color) {
+        uint32_t base = static_cast<uint32_t>(vertices.size());
+        vertices.push_back({v0, normal, color});
+        vertices.push_back({v1, normal, color});
+        vertices.push_back({v2, normal, color});
+        vertices.push_back({v3, normal, color});
+        GreedyMesher::appendQuadIndices(base, indices);
+    };
+
+    auto addBox = [&addQuad](const glm::vec3& minCorner, const glm::vec3& maxCorner, const glm::vec3& color) {
+        glm::vec3 v000(minCorner.x, minCorner.y, minCorner.z);
+        glm::vec3 v001(minCorner.x, minCorner.y, maxCorner.z);
+        glm::vec3 v010(minCorner.x, maxCorner.y, minCorner.z);
+        glm::vec3 v011(minCorner.x, maxCorner.y, maxCorner.z);
+        glm::vec3 v100(maxCorner.x, minCorner.y, minCorner.z);
+        glm::vec3 v101(maxCorner.x, minCorner.y, maxCorner.z);
+        glm::vec3 v110(maxCorner.x, maxCorner.y, minCorner.z);
+        glm::vec3 v111(maxCorner.x, maxCorner.y, maxCorner.z);
+
+        addQuad(v001, v101, v111, v011, glm::vec3(0.0f, 0.0f, 1.0f), color);   // front (+Z)
+        addQuad(v100, v000, v010, v110, glm::vec3(0.0f, 0.0f, -1.0f), color);  // back (-Z)
+        addQuad(v000, v001, v011, v010, glm::vec3(-1.0f, 0.0f, 0.0f), color);  // left (-X)
+        addQuad(v101, v100, v110, v111, glm::vec3(1.0f, 0.0f, 0.0f), color);   // right (+X)
+        addQuad(v010, v011, v111, v110, glm::vec3(0.0f, 1.0f, 0.0f), color);   // top (+Y)
+        addQuad(v000, v100, v101, v001, glm::vec3(0.0f, -1.0f, 0.0f), color);  // bottom (-Y)
+    };
+
+    auto addWallBricks = [&addBox, wallBase, verticalGap, horizontalGap, scaledBrickHeight, scaledBrickLength, wallColorDark, wallColorLight](float minX, float maxX, float minZ, float maxZ, float topHeight, bool alongZ) {
+        float usableHeight = topHeight - wallBase;
+        if (usableHeight <= 0.05f) {
+            return;
+        }
+
+        float runLength = alongZ ? (maxZ - minZ) : (maxX - minX);
+        if (runLength <= 0.05f) {
+            return;
+        }
+
+        float gapY = std::min(verticalGap, usableHeight * 0.25f);
+        float gapRun = std::min(horizontalGap, runLength * 0.5f);
+        float brickHeight = std::min(scaledBrickHeight, usableHeight);
+        float brickLength = std::min(scaledBrickLength, runLength);
+
+        if (brickHeight <= 0.0f || brickLength <= 0.0f) {
+            return;
+        }
+
+        int layerIndex = 0;
+        for (float y0 = wallBase; y0 < topHeight - 0.001f; y0 += brickHeight + gapY, ++layerIndex) {
+            float y1 = std::min(y0 + brickHeight, topHeight);
+
+            int segmentIndex = 0;
+            for (float offset = 0.0f; offset < runLength - 0.001f; offset += brickLength + gapRun, ++segmentIndex) {
+                float segStart = (alongZ ? minZ : minX) + offset;
+                float segEnd = std::min(segStart + brickLength, alongZ ? maxZ : maxX);
+                if (segEnd <= segStart + 0.0005f) {
+                    break;
+                }
+
+                glm::vec3 minCorner;
+                glm::vec3 maxCorner;
+                if (alongZ) {
+                    minCorner = glm::vec3(minX, y0, segStart);
+                    maxCorner = glm::vec3(maxX, y1, segEnd);
+                } else {
+                    minCorner = glm::vec3(segStart, y0, minZ);
+                    maxCorner = glm::vec3(segEnd, y1, maxZ);
+                }
+
+                glm::vec3 color = ((layerIndex + segmentIndex) % 2 == 0) ? wallColorDark : wallColorLight;
+                addBox(minCorner, maxCorner, color);
+
+                if (segEnd >= (alongZ ? maxZ : maxX) - 0.001f) {
+                    break;
+                }
+            }
+        }
+    };
+
+    // 格子局部坐标：格子占据 [0, cellSize] x [0, cellSize]，实例偏移为格子最小角的世界坐标
+    const float tileX0 = 0.0f;
+    const float tileZ0 = 0.0f;
+    const float tileX1 = cellSize;
+    const float tileZ1 = cellSize;
+    const TerrainType landTypes[2] = {TerrainType::GRASS, TerrainType::STONE};
+    const int directions[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    const uint8_t directionBits[4] = {WATER_NEIGHBOR_POS_X, WATER_NEIGHBOR_NEG_X,
+                                      WATER_NEIGHBOR_POS_Z, WATER_NEIGHBOR_NEG_Z};
+
+    for (TerrainType type : landTypes) {
+        float height = getTerrainHeight(type);
+        for (int mask = 1; mask < BRICK_MASK_COUNT; ++mask) {
+            int templateIndex = brickTemplateIndex(type, static_cast<uint8_t>(mask));
+            size_t firstIndex = indices.size();
+
+            // 对每个与水面相邻的方向生成挡水墙砖块
+            for (int d = 0; d < 4; ++d) {
+                const int* dir = directions[d];
+                if ((mask & directionBits[d]) == 0) {
+                    continue;
+                }
+
+                if (dir[0] != 0) {
+                    float boundaryX = (dir[0] > 0) ? tileX1 : tileX0;
+                    float minX = (dir[0] > 0) ? boundaryX : boundaryX - wallThickness;
+                    float maxX = (dir[0] > 0) ? boundaryX + wallThickness : boundaryX;
+                    addWallBricks(minX, maxX, tileZ0, tileZ1, height, true);
+                } else {
+                    float boundaryZ = (dir[1] > 0) ? tileZ1 : tileZ0;
+                    float minZ = (dir[1] > 0) ? boundaryZ : boundaryZ - wallThickness;
+                    float maxZ = (dir[1] > 0) ? boundaryZ + wallThickness : boundaryZ;
+                    addWallBricks(tileX0, tileX1, minZ, maxZ, height, false);
+                }
+            }
+
+            outFirstIndex[templateIndex] = static_cast<uint32_t>(firstIndex);
+            outIndexCount[templateIndex] = static_cast<uint32_t>(indices.size() - firstIndex);
+        }
+    }
+}
+
+} // namespace WaterTown
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "../Core/TerrainMap.h"
+#include "GreedyMesher.h"
+
+namespace WaterTown {
+
+/**
+ * @brief 地形顶点（位置、法线、顶点色）
+ */
+struct TerrainVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec3 color;
+};
+
+/**
+ * @brief 单个区块的 CPU 端网格数据
+ */
+struct TerrainChunkMesh {
+    std::vector<TerrainVertex> vertices;   // 陆地顶面顶点
+    std::vector<uint32_t> indices;         // 陆地顶面索引
+    std::vector<glm::vec3> brickOffsets;   // 河岸砖墙实例（格子最小角的世界坐标）
+    std::vector<uint8_t> brickTemplates;   // 与偏移一一对应的模板编号
+
+    void clear() {
+        vertices.clear();
+        indices.clear();
+        brickOffsets.clear();
+        brickTemplates.clear();
+    }
+};
+
+/**
+ * @brief 地形网格生成器（不依赖 OpenGL）
+ *
+ * 从 TerrainMap 生成区块的陆地顶面（GreedyMesher 合并矩形）和河岸砖墙实例，
+ * 以及所有砖墙模板的共享网格。只产出 CPU 缓冲，上传与绘制由 TerrainRenderer 负责。
+ */
+class TerrainMesher {
+public:
+    static constexpr int CHUNK_SIZE = TerrainMap::CHUNK_SIZE;
+    static constexpr int BRICK_MASK_COUNT = 16;                        // 4 个方向的邻接水面掩码组合
+    static constexpr int BRICK_TEMPLATE_COUNT = 2 * BRICK_MASK_COUNT;  // GRASS / STONE 两种墙高
+
+    /**
+     * @brief 构造函数
+     * @param cellSize 格子边长（世界单位）
+     * @param waterLevel 水面高度（砖墙从水面下方开始砌）
+     */
+    TerrainMesher(float cellSize, float waterLevel);
+
+    /**
+     * @brief 生成单个区块的陆地顶面索引网格，并收集河岸砖墙实例（输出会先清空）
+     *
+     * 网格以地形中心为原点，区块越界时输出为空。
+     */
+    void buildChunk(const TerrainMap& terrain, int chunkX, int chunkZ, TerrainChunkMesh& out);
+
+    /**
+     * @brief 生成全部砖墙模板（格子局部坐标，原点为格子的最小角）
+     * @param outFirstIndex 每个模板在索引数组中的起始位置
+     * @param outIndexCount 每个模板的索引数
+     */
+    void buildBrickTemplates(std::vector<TerrainVertex>& outVertices, std::vector<uint32_t>& outIndices,
+                             uint32_t outFirstIndex[BRICK_TEMPLATE_COUNT],
+                             uint32_t outIndexCount[BRICK_TEMPLATE_COUNT]) const;
+
+    /**
+     * @brief 模板编号；该类型没有砖墙或掩码为 0 时返回 -1
+     */
+    static int brickTemplateIndex(TerrainType type, uint8_t waterMask);
+
+    static glm::vec3 getTerrainColor(TerrainType type);
+    float getTerrainHeight(TerrainType type) const;
+
+private:
+    float m_cellSize;
+    float m_waterLevel;
+    GreedyMesher m_mesher;
+    std::vector<GreedyRect> m_rects;  // 复用的合并矩形
+};
+
+} // namespace WaterTown
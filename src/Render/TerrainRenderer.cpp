@@ -1,6 +1,10 @@
 #include "TerrainRenderer.h"
 #include "Shader.h"
 #include "Camera.h"
+#include "GLState.h"
+#include "GLCounters.h"
+#include "../Core/JobSystem.h"
+#include "../Core/Profiler.h"
 #include "../Editor/SceneEditor.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <vector>
@@ -9,219 +13,193 @@
 namespace WaterTown {
 
 TerrainRenderer::TerrainRenderer(int gridSizeX, int gridSizeZ)
-    : m_gridSizeX(gridSizeX), m_gridSizeZ(gridSizeZ), m_planeVAO(0), m_planeVBO(0) {
-    glGenVertexArrays(1, &m_planeVAO);
-    glGenBuffers(1, &m_planeVBO);
+    : m_gridSizeX(gridSizeX), m_gridSizeZ(gridSizeZ),
+      m_mesher(SceneEditor::CELL_SIZE, SceneEditor::WATER_LEVEL) {
+    buildBrickTemplates();  // 区块 VAO 需要引用模板缓冲，必须先生成
+    allocateChunks();
 }
 
 TerrainRenderer::~TerrainRenderer() {
-    if (m_planeVAO) glDeleteVertexArrays(1, &m_planeVAO);
-    if (m_planeVBO) glDeleteBuffers(1, &m_planeVBO);
+    releaseChunks();
+    releaseBrickTemplates();
 }
 
-glm::vec3 TerrainRenderer::getTerrainColor(TerrainType type) const {
-    switch (type) {
-        case TerrainType::GRASS:
-            return glm::vec3(0.3f, 0.7f, 0.3f);
-        case TerrainType::WATER:
-            return glm::vec3(0.2f, 0.4f, 0.9f);
-        case TerrainType::STONE:
-            return glm::vec3(0.7f, 0.7f, 0.7f);
-        case TerrainType::EMPTY:
-            return glm::vec3(0.0f); // 透明/不可见
-        default:
-            return glm::vec3(1.0f, 1.0f, 1.0f);
+void TerrainRenderer::allocateChunks() {
+    m_chunksX = (m_gridSizeX + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunksZ = (m_gridSizeZ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunks.resize(static_cast<size_t>(m_chunksX) * m_chunksZ);
+
+    for (auto& chunk : m_chunks) {
+        glGenVertexArrays(1, &chunk.vao);
+        glGenBuffers(1, &chunk.vbo);
+        glGenBuffers(1, &chunk.ebo);
+
+        // 顶点格式固定，VAO 只需配置一次（EBO 绑定也记录在 VAO 中）
+        GLState::bindVertexArray(chunk.vao);
+        GLState::bindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+        GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, chunk.ebo);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)(sizeof(glm::vec3)));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)(2 * sizeof(glm::vec3)));
+        glEnableVertexAttribArray(2);
+
+        // 砖墙 VAO：顶点/索引来自共享模板，location 3 为逐实例的格子偏移
+        glGenVertexArrays(1, &chunk.brickVao);
+        glGenBuffers(1, &chunk.instanceVbo);
+        GLState::bindVertexArray(chunk.brickVao);
+        GLState::bindBuffer(GL_ARRAY_BUFFER, m_brickVBO);
+        GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_brickEBO);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)(sizeof(glm::vec3)));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)(2 * sizeof(glm::vec3)));
+        glEnableVertexAttribArray(2);
+        GLState::bindBuffer(GL_ARRAY_BUFFER, chunk.instanceVbo);
+        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+        glEnableVertexAttribArray(3);
+        glVertexAttribDivisor(3, 1);
     }
+    GLState::bindVertexArray(0);
 }
 
-float TerrainRenderer::getTerrainHeight(TerrainType type) const {
-    switch (type) {
-        case TerrainType::GRASS:
-            return 1.0f;
-        case TerrainType::STONE:
-            return 1.1f;
-        case TerrainType::WATER:
-            return SceneEditor::WATER_LEVEL;
-        default:
-            return 0.3f;
+void TerrainRenderer::releaseChunks() {
+    for (auto& chunk : m_chunks) {
+        if (chunk.vao) GLState::deleteVertexArrays(1, &chunk.vao);
+        if (chunk.vbo) GLState::deleteBuffers(1, &chunk.vbo);
+        if (chunk.ebo) GLState::deleteBuffers(1, &chunk.ebo);
+        if (chunk.brickVao) GLState::deleteVertexArrays(1, &chunk.brickVao);
+        if (chunk.instanceVbo) GLState::deleteBuffers(1, &chunk.instanceVbo);
     }
+    m_chunks.clear();
+    m_chunksX = 0;
+    m_chunksZ = 0;
 }
 
-void TerrainRenderer::buildTerrainVertices(SceneEditor* editor, std::vector<TerrainVertex>& outVertices, const glm::vec3& cameraPos) {
-    const float cellSize = SceneEditor::CELL_SIZE;
-    const float expand = cellSize * 0.05f; // slight overlap to avoid cracks on the plane
-    const glm::vec3 upNormal(0.0f, 1.0f, 0.0f);
-    const float waterSurface = getTerrainHeight(TerrainType::WATER);
-    const float wallBase = waterSurface - 0.1f; // sink a bit into the river to avoid gaps
-    const float brickScale = 4.0f;
-    const float wallThickness = cellSize * 0.45f * brickScale;
-    const float verticalGap = 0.01f * brickScale;
-    const float horizontalGap = cellSize * 0.04f * brickScale;
-    const float baseBrickHeight = cellSize * 0.15f;
-    const float baseBrickLength = cellSize * 0.25f;
-    const float scaledBrickHeight = baseBrickHeight * brickScale;
-    const float scaledBrickLength = baseBrickLength * brickScale;
-    const glm::vec3 wallColorDark(0.35f, 0.35f, 0.35f);
-    const glm::vec3 wallColorLight(0.45f, 0.45f, 0.45f);
-
-    outVertices.clear();
-    outVertices.reserve(m_gridSizeX * m_gridSizeZ * 18);
-
-    const float worldLengthZ = m_gridSizeZ * cellSize;
-    const float renderDistance = worldLengthZ; // 覆盖全部长度，避免远处缺失陆地
-    const float renderDistanceSq = renderDistance * renderDistance;
-
-    auto addQuad = [this, &outVertices](const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, const glm::vec3& v3,
-                       const glm::vec3& normal, const glm::vec3& color) {
-        outVertices.push_back({v0, normal, color});
-        outVertices.push_back({v1, normal, color});
-        outVertices.push_back({v2, normal, color});
-        outVertices.push_back({v0, normal, color});
-        outVertices.push_back({v2, normal, color});
-        outVertices.push_back({v3, normal, color});
-    };
+void TerrainRenderer::setGridSize(int sizeX, int sizeZ) {
+    if (sizeX == m_gridSizeX && sizeZ == m_gridSizeZ) {
+        return;
+    }
+    m_gridSizeX = sizeX;
+    m_gridSizeZ = sizeZ;
+    releaseChunks();
+    allocateChunks();  // 新区块默认为脏
+}
 
-    auto addBox = [this, &outVertices, &addQuad](const glm::vec3& minCorner, const glm::vec3& maxCorner, const glm::vec3& color) {
-        glm::vec3 v000(minCorner.x, minCorner.y, minCorner.z);
-        glm::vec3 v001(minCorner.x, minCorner.y, maxCorner.z);
-        glm::vec3 v010(minCorner.x, maxCorner.y, minCorner.z);
-        glm::vec3 v011(minCorner.x, maxCorner.y, maxCorner.z);
-        glm::vec3 v100(maxCorner.x, minCorner.y, minCorner.z);
-        glm::vec3 v101(maxCorner.x, minCorner.y, maxCorner.z);
-        glm::vec3 v110(maxCorner.x, maxCorner.y, minCorner.z);
-        glm::vec3 v111(maxCorner.x, maxCorner.y, maxCorner.z);
-
-        addQuad(v001, v101, v111, v011, glm::vec3(0.0f, 0.0f, 1.0f), color);   // front (+Z)
-        addQuad(v100, v000, v010, v110, glm::vec3(0.0f, 0.0f, -1.0f), color);  // back (-Z)
-        addQuad(v000, v001, v011, v010, glm::vec3(-1.0f, 0.0f, 0.0f), color);  // left (-X)
-        addQuad(v101, v100, v110, v111, glm::vec3(1.0f, 0.0f, 0.0f), color);   // right (+X)
-        addQuad(v010, v011, v111, v110, glm::vec3(0.0f, 1.0f, 0.0f), color);   // top (+Y)
-        addQuad(v000, v100, v101, v001, glm::vec3(0.0f, -1.0f, 0.0f), color);  // bottom (-Y)
-    };
+void TerrainRenderer::markDirty() {
+    for (auto& chunk : m_chunks) {
+        chunk.dirty = true;
+    }
+}
 
-    auto addWallBricks = [this, &outVertices, &addBox, wallBase, brickScale, wallThickness, verticalGap, horizontalGap, scaledBrickHeight, scaledBrickLength, wallColorDark, wallColorLight](float minX, float maxX, float minZ, float maxZ, float topHeight, bool alongZ) {
-        float usableHeight = topHeight - wallBase;
-        if (usableHeight <= 0.05f) {
-            return;
-        }
+void TerrainRenderer::markCellDirty(int gridX, int gridZ) {
+    // 相邻格子的砖墙取决于本格类型，所以 3x3 邻域覆盖到的区块都要重建
+    int minChunkX = std::max(gridX - 1, 0) / CHUNK_SIZE;
+    int maxChunkX = std::min(gridX + 1, m_gridSizeX - 1) / CHUNK_SIZE;
+    int minChunkZ = std::max(gridZ - 1, 0) / CHUNK_SIZE;
+    int maxChunkZ = std::min(gridZ + 1, m_gridSizeZ - 1) / CHUNK_SIZE;
 
-        float runLength = alongZ ? (maxZ - minZ) : (maxX - minX);
-        if (runLength <= 0.05f) {
-            return;
+    for (int cz = minChunkZ; cz <= maxChunkZ && cz < m_chunksZ; ++cz) {
+        for (int cx = minChunkX; cx <= maxChunkX && cx < m_chunksX; ++cx) {
+            m_chunks[cz * m_chunksX + cx].dirty = true;
         }
+    }
+}
 
-        float gapY = std::min(verticalGap, usableHeight * 0.25f);
-        float gapRun = std::min(horizontalGap, runLength * 0.5f);
-        float brickHeight = std::min(scaledBrickHeight, usableHeight);
-        float brickLength = std::min(scaledBrickLength, runLength);
+void TerrainRenderer::uploadChunk(TerrainChunk& chunk, const TerrainChunkMesh& mesh) {
+    const std::vector<TerrainVertex>& vertices = mesh.vertices;
+    const std::vector<uint32_t>& indices = mesh.indices;
+    chunk.indexCount = static_cast<GLsizei>(indices.size());
+    if (indices.empty()) {
+        return;
+    }
 
-        if (brickHeight <= 0.0f || brickLength <= 0.0f) {
-            return;
-        }
-
-        int layerIndex = 0;
-        for (float y0 = wallBase; y0 < topHeight - 0.001f; y0 += brickHeight + gapY, ++layerIndex) {
-            float y1 = std::min(y0 + brickHeight, topHeight);
-
-            int segmentIndex = 0;
-            for (float offset = 0.0f; offset < runLength - 0.001f; offset += brickLength + gapRun, ++segmentIndex) {
-                float segStart = (alongZ ? minZ : minX) + offset;
-                float segEnd = std::min(segStart + brickLength, alongZ ? maxZ : maxX);
-                if (segEnd <= segStart + 0.0005f) {
-                    break;
-                }
-
-                glm::vec3 minCorner;
-                glm::vec3 maxCorner;
-                if (alongZ) {
-                    minCorner = glm::vec3(minX, y0, segStart);
-                    maxCorner = glm::vec3(maxX, y1, segEnd);
-                } else {
-                    minCorner = glm::vec3(segStart, y0, minZ);
-                    maxCorner = glm::vec3(segEnd, y1, maxZ);
-                }
-
-                glm::vec3 color = ((layerIndex + segmentIndex) % 2 == 0) ? wallColorDark : wallColorLight;
-                addBox(minCorner, maxCorner, color);
-
-                if (segEnd >= (alongZ ? maxZ : maxX) - 0.001f) {
-                    break;
-                }
-            }
+    // 容量足够时原地覆盖，避免重新分配显存
+    auto upload = [](GLenum target, GLuint buffer, const void* data, size_t bytes, size_t& capacity) {
+        GLState::bindBuffer(target, buffer);
+        if (bytes <= capacity) {
+            GLCounters::bufferSubData(target, 0, bytes, data);
+        } else {
+            GLCounters::bufferData(target, bytes, data, GL_DYNAMIC_DRAW);
+            capacity = bytes;
         }
     };
 
-    for (int z = 0; z < m_gridSizeZ; ++z) {
-        for (int x = 0; x < m_gridSizeX; ++x) {
-            // 距离剔除：只渲染距离相机较近的网格
-            float centerX = (x - m_gridSizeX / 2.0f) * cellSize + cellSize * 0.5f;
-            float centerZ = (z - m_gridSizeZ / 2.0f) * cellSize + cellSize * 0.5f;
-            glm::vec3 tileCenter(centerX, 0.0f, centerZ);
-            glm::vec3 diff = tileCenter - cameraPos;
-            float distSq = glm::dot(diff, diff);
-            if (distSq > renderDistanceSq) {
-                continue;
-            }
+    // 绑定 VAO 后再上传 EBO，避免改动其他 VAO 的索引绑定
+    GLState::bindVertexArray(chunk.vao);
+    upload(GL_ARRAY_BUFFER, chunk.vbo, vertices.data(), vertices.size() * sizeof(TerrainVertex), chunk.vertexCapacityBytes);
+    upload(GL_ELEMENT_ARRAY_BUFFER, chunk.ebo, indices.data(), indices.size() * sizeof(uint32_t), chunk.indexCapacityBytes);
+    GLState::bindVertexArray(0);
+}
 
-            TerrainType type = editor->getTerrainAt(x, z);
-            // 修改点：同时跳过 WATER 和 EMPTY
-            if (type == TerrainType::WATER || type == TerrainType::EMPTY) {
-                continue; // 水面由 WaterSurface 渲染，空地不渲染
-            }
+void TerrainRenderer::uploadBrickInstances(TerrainChunk& chunk, const TerrainChunkMesh& mesh) {
+    // 按模板做计数排序，使同一模板的实例在缓冲中连续
+    const size_t count = mesh.brickOffsets.size();
+    for (int t = 0; t < BRICK_TEMPLATE_COUNT; ++t) {
+        chunk.brickCount[t] = 0;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        ++chunk.brickCount[mesh.brickTemplates[i]];
+    }
+    GLint first = 0;
+    for (int t = 0; t < BRICK_TEMPLATE_COUNT; ++t) {
+        chunk.brickFirst[t] = first;
+        first += chunk.brickCount[t];
+    }
 
-            float height = getTerrainHeight(type);
-            glm::vec3 color = getTerrainColor(type);
-
-            float tileX0 = (x - m_gridSizeX / 2.0f) * cellSize;
-            float tileZ0 = (z - m_gridSizeZ / 2.0f) * cellSize;
-            float tileX1 = tileX0 + cellSize;
-            float tileZ1 = tileZ0 + cellSize;
-
-            float x0 = tileX0 - expand * 0.5f;
-            float x1 = tileX1 + expand * 0.5f;
-            float z0 = tileZ0 - expand * 0.5f;
-            float z1 = tileZ1 + expand * 0.5f;
-
-            TerrainVertex v0{{x0, height, z0}, upNormal, color};
-            TerrainVertex v1{{x1, height, z0}, upNormal, color};
-            TerrainVertex v2{{x1, height, z1}, upNormal, color};
-            TerrainVertex v3{{x0, height, z1}, upNormal, color};
-
-            outVertices.push_back(v0);
-            outVertices.push_back(v1);
-            outVertices.push_back(v2);
-            outVertices.push_back(v0);
-            outVertices.push_back(v2);
-            outVertices.push_back(v3);
-
-            // 检查四个方向是否与河面相邻，生成挡水墙砖块
-            const int directions[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-            for (const auto& dir : directions) {
-                int neighborX = x + dir[0];
-                int neighborZ = z + dir[1];
-                
-                // 注意：如果超出边界，getTerrainAt 可能返回默认值(EMPTY)，所以这里不仅要检测是否是 WATER，
-                // 还要考虑是否是 EMPTY？不，河岸只在陆地和水之间生成。
-                // 如果陆地旁边是空地，不需要生成墙。
-                // 所以只检测邻居是否为 WATER 即可。
-                if (editor->getTerrainAt(neighborX, neighborZ) != TerrainType::WATER) {
-                    continue;
-                }
-
-                if (dir[0] != 0) {
-                    float boundaryX = (dir[0] > 0) ? tileX1 : tileX0;
-                    float minX = (dir[0] > 0) ? boundaryX : boundaryX - wallThickness;
-                    float maxX = (dir[0] > 0) ? boundaryX + wallThickness : boundaryX;
-                    addWallBricks(minX, maxX, tileZ0, tileZ1, height, true);
-                } else {
-                    float boundaryZ = (dir[1] > 0) ? tileZ1 : tileZ0;
-                    float minZ = (dir[1] > 0) ? boundaryZ : boundaryZ - wallThickness;
-                    float maxZ = (dir[1] > 0) ? boundaryZ + wallThickness : boundaryZ;
-                    addWallBricks(tileX0, tileX1, minZ, maxZ, height, false);
-                }
-            }
-        }
+    m_sortedBrickOffsets.resize(count);
+    GLint cursor[BRICK_TEMPLATE_COUNT];
+    std::copy(chunk.brickFirst, chunk.brickFirst + BRICK_TEMPLATE_COUNT, cursor);
+    for (size_t i = 0; i < count; ++i) {
+        m_sortedBrickOffsets[cursor[mesh.brickTemplates[i]]++] = mesh.brickOffsets[i];
+    }
+
+    chunk.brickInstanceCount = static_cast<GLsizei>(count);
+    if (count == 0) {
+        return;
     }
+
+    size_t bytes = count * sizeof(glm::vec3);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, chunk.instanceVbo);
+    if (bytes <= chunk.instanceCapacityBytes) {
+        GLCounters::bufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_sortedBrickOffsets.data());
+    } else {
+        GLCounters::bufferData(GL_ARRAY_BUFFER, bytes, m_sortedBrickOffsets.data(), GL_DYNAMIC_DRAW);
+        chunk.instanceCapacityBytes = bytes;
+    }
+}
+
+void TerrainRenderer::buildBrickTemplates() {
+    std::vector<TerrainVertex> vertices;
+    std::vector<uint32_t> indices;
+    uint32_t firstIndex[BRICK_TEMPLATE_COUNT];
+    uint32_t indexCount[BRICK_TEMPLATE_COUNT];
+    m_mesher.buildBrickTemplates(vertices, indices, firstIndex, indexCount);
+    for (int t = 0; t < BRICK_TEMPLATE_COUNT; ++t) {
+        m_brickTemplates[t].indexOffsetBytes = firstIndex[t] * sizeof(uint32_t);
+        m_brickTemplates[t].indexCount = static_cast<GLsizei>(indexCount[t]);
+    }
+
+    glGenBuffers(1, &m_brickVBO);
+    glGenBuffers(1, &m_brickEBO);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, m_brickVBO);
+    GLCounters::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(TerrainVertex), vertices.data(), GL_STATIC_DRAW);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // EBO 绑定属于 VAO 状态，上传时先解绑 VAO，避免改动其他 VAO
+    GLState::bindVertexArray(0);
+    GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_brickEBO);
+    GLCounters::bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+    GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void TerrainRenderer::releaseBrickTemplates() {
+    if (m_brickVBO) GLState::deleteBuffers(1, &m_brickVBO);
+    if (m_brickEBO) GLState::deleteBuffers(1, &m_brickEBO);
+    m_brickVBO = 0;
+    m_brickEBO = 0;
 }
 
 void TerrainRenderer::render(SceneEditor* editor, Shader* shader, Camera* camera) {
@@ -230,78 +208,84 @@ void TerrainRenderer::render(SceneEditor* editor, Shader* shader, Camera* camera
     }
 
     // 同步动态网格尺寸（用于河岸/陆地加长）
-    int newGridSizeX = editor->getGridSizeX();
-    int newGridSizeZ = editor->getGridSizeZ();
-    
-    if (newGridSizeX != m_gridSizeX || newGridSizeZ != m_gridSizeZ) {
-        m_gridSizeX = newGridSizeX;
-        m_gridSizeZ = newGridSizeZ;
-        m_terrainDirty = true;
-    }
+    setGridSize(editor->getGridSizeX(), editor->getGridSizeZ());
 
-    // 在地形编辑模式下强制每帧更新，否则按相机移动更新
-    glm::vec3 cameraPos = camera->getPosition();
-    bool isTerrainEditMode = (editor->getCurrentMode() == EditorMode::TERRAIN);
-    
-    if (isTerrainEditMode) {
-        // 地形编辑模式：每帧更新以实时显示编辑结果
-        m_terrainDirty = true;
-    } else {
-        // 非编辑模式：只在相机移动足够远时更新（性能优化）
-        float cameraMoveDistSq = glm::dot(cameraPos - m_lastCameraPos, cameraPos - m_lastCameraPos);
-        const float rebuildThreshold = 25.0f;  // 相机移动5单位以上才重建
-        
-        if (cameraMoveDistSq > rebuildThreshold * rebuildThreshold) {
-            m_terrainDirty = true;
-            m_lastCameraPos = cameraPos;
+    // 只重建被编辑过的区块；相机移动不会触发重建
+    m_dirtyChunks.clear();
+    for (int i = 0; i < static_cast<int>(m_chunks.size()); ++i) {
+        if (m_chunks[i].dirty) {
+            m_dirtyChunks.push_back(i);
         }
     }
+    if (!m_dirtyChunks.empty()) {
+        PROFILE_SCOPE("TerrainRenderer::rebuildChunks");
+        const int dirtyCount = static_cast<int>(m_dirtyChunks.size());
+        if (static_cast<int>(m_chunkMeshes.size()) < dirtyCount) {
+            m_chunkMeshes.resize(dirtyCount);
+        }
+        // 每个线程一个网格器（内部有复用的临时缓冲）
+        if (static_cast<int>(m_workerMeshers.size()) < JobSystem::getThreadCount()) {
+            m_workerMeshers.resize(JobSystem::getThreadCount(), m_mesher);
+        }
 
-    // 只有在地形脏时才重建顶点
-    if (m_terrainDirty) {
-        buildTerrainVertices(editor, m_cachedVertices, cameraPos);
-        m_terrainDirty = false;
-    }
-    
-    if (m_cachedVertices.empty()) {
-        return;
+        // CPU 网格生成分给所有线程，GL 上传留在主线程
+        const TerrainMap& terrain = editor->getTerrainMap();
+        JobSystem::parallelFor(0, dirtyCount, MESH_JOB_GRAIN, [this, &terrain](int begin, int end) {
+            TerrainMesher& mesher = m_workerMeshers[JobSystem::currentThreadIndex()];
+            for (int i = begin; i < end; ++i) {
+                const int index = m_dirtyChunks[i];
+                mesher.buildChunk(terrain, index % m_chunksX, index / m_chunksX, m_chunkMeshes[i]);
+            }
+        });
+
+        for (int i = 0; i < dirtyCount; ++i) {
+            TerrainChunk& chunk = m_chunks[m_dirtyChunks[i]];
+            uploadChunk(chunk, m_chunkMeshes[i]);
+            uploadBrickInstances(chunk, m_chunkMeshes[i]);
+            chunk.dirty = false;
+        }
     }
 
+    // 地形变体：顶点色、无整体缩放、无底部色调、不走物体实例化路径
+    if (shader != m_variantSource) {
+        m_variantSource = shader;
+        m_shaderVariant = shader->getVariant({"VARIANT_INSTANCING 0", "VARIANT_OBJECT_SCALE 0",
+                                              "VARIANT_VERTEX_COLOR 1", "VARIANT_BOTTOM_TINT 0"});
+    }
+    shader = m_shaderVariant;
     shader->use();
-    shader->setBool("uUseVertexColor", true);
-    shader->setBool("uUseObjectScale", false);
-    shader->setFloat("uObjectScale", 1.0f);
-    shader->setVec3("uObjectScaleOrigin", 0.0f, 0.0f, 0.0f);
-    shader->setVec3("uLightDir", -0.3f, -1.0f, -0.2f);
-    shader->setVec3("uLightColor", 1.0f, 0.98f, 0.95f);
-    shader->setVec3("uSkyColor", 0.6f, 0.75f, 0.95f);
-    shader->setVec3("uGroundColor", 0.35f, 0.3f, 0.25f);
-    shader->setFloat("uAmbientStrength", 0.35f);
-    shader->setBool("uUseFog", true);
-    shader->setVec3("uFogColor", 0.7f, 0.8f, 0.9f);
-    shader->setFloat("uFogDensity", 0.0025f);
-    shader->setVec3("uBottomTintColor", 0.2f, 0.45f, 0.65f);
-    shader->setFloat("uBottomTintStrength", 0.0f);
     shader->setMat4("uModel", glm::mat4(1.0f));
-    shader->setMat4("uView", camera->getViewMatrix());
-    shader->setMat4("uProjection", camera->getProjectionMatrix());
-    shader->setVec3("uViewPos", camera->getPosition());
-
-    glBindVertexArray(m_planeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_planeVBO);
-    glBufferData(GL_ARRAY_BUFFER, m_cachedVertices.size() * sizeof(TerrainVertex), m_cachedVertices.data(), GL_DYNAMIC_DRAW);
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)(sizeof(glm::vec3)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertex), (void*)(2 * sizeof(glm::vec3)));
-    glEnableVertexAttribArray(2);
+    for (const auto& chunk : m_chunks) {
+        if (chunk.indexCount == 0) {
+            continue;
+        }
+        GLState::bindVertexArray(chunk.vao);
+        GLCounters::drawElements(GL_TRIANGLES, chunk.indexCount, GL_UNSIGNED_INT, 0);
+    }
 
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_cachedVertices.size()));
+    // 河岸砖墙：每个区块按模板分段做实例化绘制
+    // GL 3.3 没有 baseInstance，所以每段重新指定实例属性的起始偏移
+    shader->setBool("uUseInstanceOffset", true);
+    for (const auto& chunk : m_chunks) {
+        if (chunk.brickInstanceCount == 0) {
+            continue;
+        }
+        GLState::bindVertexArray(chunk.brickVao);
+        GLState::bindBuffer(GL_ARRAY_BUFFER, chunk.instanceVbo);
+        for (int t = 0; t < BRICK_TEMPLATE_COUNT; ++t) {
+            if (chunk.brickCount[t] == 0 || m_brickTemplates[t].indexCount == 0) {
+                continue;
+            }
+            glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3),
+                                  (void*)(chunk.brickFirst[t] * sizeof(glm::vec3)));
+            GLCounters::drawElementsInstanced(GL_TRIANGLES, m_brickTemplates[t].indexCount, GL_UNSIGNED_INT,
+                                              (void*)m_brickTemplates[t].indexOffsetBytes, chunk.brickCount[t]);
+        }
+    }
+    shader->setBool("uUseInstanceOffset", false);
 
-    glBindVertexArray(0);
-    shader->setBool("uUseVertexColor", false);
+    GLState::bindVertexArray(0);
 }
 
 } // namespace WaterTown
@@ -4,6 +4,7 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include "../Editor/SceneEditor.h"
+#include "TerrainMesher.h"
 
 namespace WaterTown {
 
@@ -12,12 +13,27 @@ class Camera;
 
 /**
  * @brief 地形网格渲染器
+ *
+ * 地形按 CHUNK_SIZE x CHUNK_SIZE 的格子划分为区块，每个区块拥有独立的
+ * VBO/EBO 和脏标记。编辑时只重建受影响的区块，相机移动不会触发重建。
+ * 陆地顶面由 GreedyMesher 合并为尽可能大的矩形，以索引方式绘制。
+ * 河岸砖墙按 (陆地类型, 邻接水面掩码) 预先生成模板网格，常驻显存，
+ * 区块只保存每个河岸格子的实例偏移，以实例化方式绘制。
+ * 网格数据由 TerrainMesher 在 CPU 端生成，本类只负责上传和绘制。
  */
 class TerrainRenderer {
 public:
+    static constexpr int CHUNK_SIZE = TerrainMap::CHUNK_SIZE;  // 区块边长（与地形存储的区块一致）
+    static constexpr int BRICK_TEMPLATE_COUNT = TerrainMesher::BRICK_TEMPLATE_COUNT;
+    static constexpr int MESH_JOB_GRAIN = 4;  // 每个作业生成的区块数
+
     TerrainRenderer(int gridSizeX, int gridSizeZ);
     ~TerrainRenderer();
     
+    // 禁止拷贝（持有 GL 资源）
+    TerrainRenderer(const TerrainRenderer&) = delete;
+    TerrainRenderer& operator=(const TerrainRenderer&) = delete;
+    
     /**
      * @brief 渲染地形网格
      * @param editor 场景编辑器（获取地形数据）
@@ -27,45 +43,82 @@ public:
     void render(SceneEditor* editor, Shader* shader, Camera* camera);
     
     /**
-     * @brief 设置网格大小
+     * @brief 设置网格大小（重新划分区块并全部标记为脏）
+     */
+    void setGridSize(int sizeX, int sizeZ);
+    
+    /**
+     * @brief 标记全部区块需要重建（整体替换地形时使用）
      */
-    void setGridSize(int sizeX, int sizeZ) { 
-        m_gridSizeX = sizeX; 
-        m_gridSizeZ = sizeZ;
-        m_terrainDirty = true;  // 标记需要重建
-    }
+    void markDirty();
     
     /**
-     * @brief 标记地形需要更新
+     * @brief 标记某个格子所在区块及其相邻区块需要重建
+     * 河岸砖墙依赖相邻格子，因此编辑区块边缘时相邻区块也要重建
      */
-    void markDirty() { m_terrainDirty = true; }
+    void markCellDirty(int gridX, int gridZ);
     
 private:
     int m_gridSizeX;
     int m_gridSizeZ;
     
-    struct TerrainVertex {
-        glm::vec3 position;
-        glm::vec3 normal;
-        glm::vec3 color;
+    /**
+     * @brief 地形区块（独立的顶点缓冲与脏标记）
+     */
+    struct TerrainChunk {
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        GLuint ebo = 0;
+        GLsizei indexCount = 0;
+        size_t vertexCapacityBytes = 0;  // 当前 VBO 已分配的大小
+        size_t indexCapacityBytes = 0;   // 当前 EBO 已分配的大小
+        
+        // 河岸砖墙实例（按模板分段连续存放的格子偏移）
+        GLuint brickVao = 0;
+        GLuint instanceVbo = 0;
+        size_t instanceCapacityBytes = 0;
+        GLsizei brickInstanceCount = 0;
+        GLint brickFirst[BRICK_TEMPLATE_COUNT] = {};
+        GLsizei brickCount[BRICK_TEMPLATE_COUNT] = {};
+        
+        bool dirty = true;
     };
     
-    GLuint m_planeVAO, m_planeVBO;
+    /**
+     * @brief 砖墙模板在共享索引缓冲中的范围
+     */
+    struct BrickTemplate {
+        GLsizei indexCount = 0;
+        size_t indexOffsetBytes = 0;
+    };
+    
+    int m_chunksX = 0;
+    int m_chunksZ = 0;
+    std::vector<TerrainChunk> m_chunks;
+    std::vector<int> m_dirtyChunks;                 // 本帧需要重建的区块下标
+    std::vector<TerrainChunkMesh> m_chunkMeshes;   // 与 m_dirtyChunks 一一对应的 CPU 网格（复用容量）
+    std::vector<glm::vec3> m_sortedBrickOffsets;   // 按模板分段排序后的实例偏移
+    TerrainMesher m_mesher;                        // 主线程用（砖墙模板），也是每线程网格器的原型
+    std::vector<TerrainMesher> m_workerMeshers;    // 按 JobSystem 线程编号索引
+    
+    GLuint m_brickVBO = 0;
+    GLuint m_brickEBO = 0;
+    BrickTemplate m_brickTemplates[BRICK_TEMPLATE_COUNT];
     
-    // 缓存相关
-    bool m_terrainDirty = true;  // 标记地形是否需要重建
-    std::vector<TerrainVertex> m_cachedVertices;  // 缓存的顶点数据
-    glm::vec3 m_lastCameraPos = glm::vec3(0.0f);  // 上次渲染时的相机位置
+    void allocateChunks();
+    void releaseChunks();
+    void uploadChunk(TerrainChunk& chunk, const TerrainChunkMesh& mesh);
+    void uploadBrickInstances(TerrainChunk& chunk, const TerrainChunkMesh& mesh);
     
-    // 增加 addWallBricks 声明，这在 Sec 版本的 cpp 中用到，但在 h 文件中通常是辅助函数，这里显式声明以便使用
-    // 注意：如果在 cpp 中是类成员函数，则需要在此声明；如果是静态辅助函数则不需要。
-    // 根据先前的 view_file 结果，addWallBricks 似乎是一个私有成员函数。
-    void addWallBricks(std::vector<TerrainVertex>& vertices, float x, float z, float size, 
-                      bool top, bool bottom, bool left, bool right);
-                      
-    void buildTerrainVertices(SceneEditor* editor, std::vector<TerrainVertex>& outVertices, const glm::vec3& cameraPos);
-    glm::vec3 getTerrainColor(TerrainType type) const;
-    float getTerrainHeight(TerrainType type) const;
+    /**
+     * @brief 生成并上传全部砖墙模板
+     */
+    void buildBrickTemplates();
+    void releaseBrickTemplates();
+
+    // 本渲染器使用的着色器变体（基础着色器变化时重新获取）
+    Shader* m_variantSource = nullptr;
+    Shader* m_shaderVariant = nullptr;
 };
 
 } // namespace WaterTown
@@ -0,0 +1,97 @@
+#include "UniformBuffers.h"
+#include "Camera.h"
+#include "GLState.h"
+#include "GLCounters.h"
+
+namespace WaterTown {
+
+namespace {
+
+GLuint createUniformBuffer(GLsizeiptr size, GLuint binding) {
+    GLuint ubo = 0;
+    glGenBuffers(1, &ubo);
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, ubo);
+    GLCounters::bufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    GLState::bindBufferBase(GL_UNIFORM_BUFFER, binding, ubo);
+    return ubo;
+}
+
+void bindBlock(GLuint program, const char* blockName, GLuint binding) {
+    GLuint index = glGetUniformBlockIndex(program, blockName);
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, index, binding);
+    }
+}
+
+} // namespace
+
+UniformBuffers::UniformBuffers()
+    : m_frameUBO(0), m_lightingUBO(0), m_waveUBO(0),
+      m_lighting(defaultLighting()), m_lightingDirty(true) {
+    m_frameUBO = createUniformBuffer(sizeof(FrameUniforms), FRAME_BLOCK_BINDING);
+    m_lightingUBO = createUniformBuffer(sizeof(LightingUniforms), LIGHTING_BLOCK_BINDING);
+    m_waveUBO = createUniformBuffer(sizeof(WaveUniforms), WAVE_BLOCK_BINDING);
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+    flush();
+}
+
+UniformBuffers::~UniformBuffers() {
+    if (m_frameUBO) GLState::deleteBuffers(1, &m_frameUBO);
+    if (m_lightingUBO) GLState::deleteBuffers(1, &m_lightingUBO);
+    if (m_waveUBO) GLState::deleteBuffers(1, &m_waveUBO);
+}
+
+LightingUniforms UniformBuffers::defaultLighting() {
+    LightingUniforms lighting = {};
+    lighting.lightDir = glm::vec3(-0.3f, -1.0f, -0.2f);
+    lighting.lightColor = glm::vec3(1.0f, 0.98f, 0.95f);
+    lighting.skyColor = glm::vec3(0.6f, 0.75f, 0.95f);
+    lighting.groundColor = glm::vec3(0.35f, 0.3f, 0.25f);
+    lighting.ambientStrength = 0.35f;
+    lighting.useFog = 1;
+    lighting.fogColor = glm::vec3(0.7f, 0.8f, 0.9f);
+    lighting.fogDensity = 0.0025f;
+    return lighting;
+}
+
+void UniformBuffers::updateFrame(const Camera* camera, float time) {
+    if (!camera) return;
+
+    FrameUniforms frame;
+    frame.view = camera->getViewMatrix();
+    frame.projection = camera->getProjectionMatrix();
+    frame.viewPos = camera->getPosition();
+    frame.time = time;
+
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, m_frameUBO);
+    GLCounters::bufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &frame);
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBuffers::setLighting(const LightingUniforms& lighting) {
+    m_lighting = lighting;
+    m_lightingDirty = true;
+}
+
+void UniformBuffers::updateWaves(const WaveUniforms& waves) {
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, m_waveUBO);
+    GLCounters::bufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(WaveUniforms), &waves);
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBuffers::flush() {
+    if (!m_lightingDirty) return;
+
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, m_lightingUBO);
+    GLCounters::bufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightingUniforms), &m_lighting);
+    GLState::bindBuffer(GL_UNIFORM_BUFFER, 0);
+    m_lightingDirty = false;
+}
+
+void UniformBuffers::bindProgramBlocks(GLuint program) {
+    bindBlock(program, "FrameBlock", FRAME_BLOCK_BINDING);
+    bindBlock(program, "LightingBlock", LIGHTING_BLOCK_BINDING);
+    bindBlock(program, "WaveBlock", WAVE_BLOCK_BINDING);
+}
+
+} // namespace WaterTown
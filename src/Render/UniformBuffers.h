@@ -0,0 +1,129 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace WaterTown {
+
+class Camera;
+
+/**
+ * @brief 共享 uniform block 的绑定点（与着色器中的 block 名对应）
+ */
+enum UniformBlockBinding : GLuint {
+    FRAME_BLOCK_BINDING = 0,     // FrameBlock：相机矩阵、相机位置、时间
+    LIGHTING_BLOCK_BINDING = 1,  // LightingBlock：太阳光、半球环境光、雾
+    WAVE_BLOCK_BINDING = 2       // WaveBlock：Gerstner 波浪数组
+};
+
+/**
+ * @brief FrameBlock 的 std140 内存布局
+ */
+struct FrameUniforms {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec3 viewPos;
+    float time;
+};
+
+/**
+ * @brief LightingBlock 的 std140 内存布局（vec3 后紧跟一个标量，正好填满 16 字节）
+ */
+struct LightingUniforms {
+    glm::vec3 lightDir;      // 光线照射方向（从太阳指向场景）
+    float ambientStrength;
+    glm::vec3 lightColor;
+    float fogDensity;
+    glm::vec3 skyColor;
+    int32_t useFog;          // GLSL bool 在 std140 中占 4 字节
+    glm::vec3 groundColor;
+    float padding0;
+    glm::vec3 fogColor;
+    float padding1;
+};
+
+/**
+ * @brief WaveBlock 中单个波浪的 std140 布局（结构体按 16 字节对齐，共 32 字节）
+ */
+struct WaveUniform {
+    glm::vec2 direction;
+    float amplitude;
+    float wavelength;
+    float speed;
+    float steepness;
+    float padding[2];
+};
+
+/**
+ * @brief WaveBlock 的 std140 内存布局
+ */
+struct WaveUniforms {
+    static constexpr int MAX_WAVES = 4;  // 与着色器中 uWaves 数组长度一致
+
+    WaveUniform waves[MAX_WAVES];
+    int32_t waveCount;
+    int32_t padding[3];
+};
+
+static_assert(sizeof(FrameUniforms) == 144, "FrameUniforms must match std140 layout");
+static_assert(sizeof(LightingUniforms) == 80, "LightingUniforms must match std140 layout");
+static_assert(sizeof(WaveUniform) == 32, "WaveUniform must match std140 layout");
+static_assert(sizeof(WaveUniforms) == 144, "WaveUniforms must match std140 layout");
+
+/**
+ * @brief 所有着色器共享的 uniform buffer
+ *
+ * 每帧由应用上传一次相机、光照和波浪数据，各渲染器只设置与自身绘制相关的 uniform。
+ * 着色器在链接后通过 bindProgramBlocks 把声明的 block 关联到固定绑定点。
+ */
+class UniformBuffers {
+public:
+    UniformBuffers();
+    ~UniformBuffers();
+
+    // 禁止拷贝（持有 GL 资源）
+    UniformBuffers(const UniformBuffers&) = delete;
+    UniformBuffers& operator=(const UniformBuffers&) = delete;
+
+    /**
+     * @brief 上传本帧的相机数据
+     */
+    void updateFrame(const Camera* camera, float time);
+
+    /**
+     * @brief 修改光照参数（下次 flush 时上传）
+     */
+    void setLighting(const LightingUniforms& lighting);
+    const LightingUniforms& getLighting() const { return m_lighting; }
+
+    /**
+     * @brief 上传波浪参数
+     */
+    void updateWaves(const WaveUniforms& waves);
+
+    /**
+     * @brief 上传尚未提交的光照参数
+     */
+    void flush();
+
+    /**
+     * @brief 把程序中声明的共享 block 关联到对应绑定点（未声明的 block 忽略）
+     */
+    static void bindProgramBlocks(GLuint program);
+
+    /**
+     * @brief 场景默认光照
+     */
+    static LightingUniforms defaultLighting();
+
+private:
+    GLuint m_frameUBO;
+    GLuint m_lightingUBO;
+    GLuint m_waveUBO;
+
+    LightingUniforms m_lighting;
+    bool m_lightingDirty;
+};
+
+} // namespace WaterTown
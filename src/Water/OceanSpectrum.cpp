@@ -0,0 +1,203 @@
+#include "OceanSpectrum.h"
+#include "PeriodicSample.h"
+#include "../Core/JobSystem.h"
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace WaterTown {
+
+constexpr int OceanSpectrum::DEFAULT_RESOLUTION;
+constexpr float OceanSpectrum::DEFAULT_TILE_SIZE;
+
+namespace {
+
+const float GRAVITY = 9.81f;
+const float PHILLIPS_CONSTANT = 1e-3f;  // Phillips 谱的 A：5 m/s 风速时有效波高约 0.3 米
+const float UPWIND_DAMPING = 0.07f;     // Phillips 谱中逆风方向传播的波的衰减
+const int INVERSE_ITERATIONS = 3;       // 反解水平位移的不动点迭代次数
+
+} // namespace
+
+OceanSpectrum::OceanSpectrum(int resolution, float tileSize)
+    : m_resolution(resolution), m_tileSize(tileSize), m_fft(resolution),
+      m_time(0.0f), m_updated(false), m_updateCount(0) {
+    const size_t count = static_cast<size_t>(resolution) * resolution;
+    m_h0.resize(count);
+    m_h0MinusConj.resize(count);
+    m_omega.resize(count);
+    m_heightDispX.resize(count);
+    m_dispZSlopeX.resize(count);
+    m_slopeZ.resize(count);
+    m_displacement.assign(count * 3, 0.0f);
+    m_slope.assign(count * 2, 0.0f);
+    setParams(m_params);
+}
+
+glm::vec2 OceanSpectrum::waveVector(int i, int j) const {
+    const int n = m_resolution;
+    const float dk = 2.0f * glm::pi<float>() / m_tileSize;
+    return glm::vec2(static_cast<float>(i < n / 2 ? i : i - n) * dk,
+                     static_cast<float>(j < n / 2 ? j : j - n) * dk);
+}
+
+float OceanSpectrum::spectrumDensity(const glm::vec2& k) const {
+    const float kLength = glm::length(k);
+    if (kLength < 1e-6f) {
+        return 0.0f;
+    }
+    const glm::vec2 wind = glm::normalize(m_params.windDirection);
+    const float cosTheta = glm::dot(k / kLength, wind);
+    const float windSpeed = std::max(m_params.windSpeed, 0.1f);
+
+    if (m_params.spectrum == OceanSpectrumType::PHILLIPS) {
+        const float largestWave = windSpeed * windSpeed / GRAVITY;
+        const float kl = kLength * largestWave;
+        float density = PHILLIPS_CONSTANT * std::exp(-1.0f / (kl * kl)) / (kLength * kLength * kLength * kLength);
+        density *= cosTheta * cosTheta;
+        if (cosTheta < 0.0f) {
+            density *= UPWIND_DAMPING;
+        }
+        // 压制远小于最大波长的细碎波纹
+        const float smallWave = largestWave * 0.001f;
+        return density * std::exp(-kLength * kLength * smallWave * smallWave);
+    }
+
+    // JONSWAP：先求频率谱 S(ω)，再按深水色散关系换算到波数，方向分布取 cos²
+    if (cosTheta <= 0.0f) {
+        return 0.0f;
+    }
+    const float fetch = std::max(m_params.fetch, 1.0f);
+    const float omega = std::sqrt(GRAVITY * kLength);
+    const float alpha = 0.076f * std::pow(windSpeed * windSpeed / (fetch * GRAVITY), 0.22f);
+    const float peakOmega = 22.0f * std::pow(GRAVITY * GRAVITY / (windSpeed * fetch), 1.0f / 3.0f);
+    const float sigma = omega <= peakOmega ? 0.07f : 0.09f;
+    const float peakDelta = (omega - peakOmega) / (sigma * peakOmega);
+    const float peakEnhancement = std::pow(3.3f, std::exp(-0.5f * peakDelta * peakDelta));
+    const float ratio = peakOmega / omega;
+    const float omegaDensity = alpha * GRAVITY * GRAVITY / std::pow(omega, 5.0f) *
+                               std::exp(-1.25f * ratio * ratio * ratio * ratio) * peakEnhancement;
+    const float waveNumberDensity = omegaDensity * GRAVITY / (2.0f * omega);  // dω/dk
+    const float spreading = 2.0f / glm::pi<float>() * cosTheta * cosTheta;
+    return waveNumberDensity / kLength * spreading;  // 极坐标到直角坐标的面积元
+}
+
+void OceanSpectrum::setParams(const OceanParams& params) {
+    m_params = params;
+    const int n = m_resolution;
+    const float dk = 2.0f * glm::pi<float>() / m_tileSize;
+    const float scale = m_params.heightScale;
+
+    // Box-Muller：直接用 mt19937 的原始输出，不同标准库得到相同的随机海面
+    std::mt19937 rng(m_params.seed);
+    auto uniform = [&rng]() { return (static_cast<float>(rng() >> 8) + 0.5f) / 16777216.0f; };
+    auto gaussianPair = [&uniform]() {
+        const float radius = std::sqrt(-2.0f * std::log(uniform()));
+        const float angle = 2.0f * glm::pi<float>() * uniform();
+        return std::complex<float>(radius * std::cos(angle), radius * std::sin(angle));
+    };
+
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            const size_t index = static_cast<size_t>(j) * n + i;
+            const std::complex<float> xi = gaussianPair();
+            // Nyquist 行列没有对应的负频率，置零保证各个场都是实数
+            const glm::vec2 k = waveVector(i, j);
+            float density = (i == n / 2 || j == n / 2) ? 0.0f : spectrumDensity(k);
+            // E|h0|² = S(k)·Δk² / 2，h(k,t) 与 conj(h0(-k)) 合在一起方差为 S(k)·Δk²
+            const float amplitude = scale * std::sqrt(density * dk * dk * 0.5f);
+            m_h0[index] = xi * (amplitude * 0.70710678f);
+            m_omega[index] = std::sqrt(GRAVITY * glm::length(k));
+        }
+    }
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            const size_t minus = static_cast<size_t>((n - j) % n) * n + (n - i) % n;
+            m_h0MinusConj[static_cast<size_t>(j) * n + i] = std::conj(m_h0[minus]);
+        }
+    }
+    m_updated = false;
+}
+
+void OceanSpectrum::update(float time) {
+    const int n = m_resolution;
+    const float choppiness = m_params.choppiness;
+
+    // 推进相位：h(k,t) = h0(k)·e^{-iωt} + conj(h0(-k))·e^{iωt}，再派生位移和坡度的频谱
+    // 逆 FFT 的基是 e^{ik·x}，h0(k) 分量即 e^{i(k·x - ωt)}，沿 +k（顺风）传播，与 Gerstner 波的 +d 方向一致
+    JobSystem::parallelFor(0, n, JOB_GRAIN, [&](int begin, int end) {
+        for (int j = begin; j < end; ++j) {
+            for (int i = 0; i < n; ++i) {
+                const size_t index = static_cast<size_t>(j) * n + i;
+                const float phase = m_omega[index] * time;
+                const std::complex<float> rotation(std::cos(phase), std::sin(phase));
+                const std::complex<float> h = m_h0[index] * std::conj(rotation) + m_h0MinusConj[index] * rotation;
+                const std::complex<float> ih(-h.imag(), h.real());
+
+                const glm::vec2 k = waveVector(i, j);
+                const float kLength = glm::length(k);
+                const glm::vec2 direction = kLength > 1e-6f ? k / kLength : glm::vec2(0.0f);
+
+                // 位移 D = i·λ·k̂·h（波峰两侧的点向波峰收拢，与 water.vert 的 Gerstner 位移同向），坡度 = i·k·h
+                m_heightDispX[index] = h - (choppiness * direction.x) * h;            // h + i·Dx
+                m_dispZSlopeX[index] = (choppiness * direction.y) * ih - k.x * h;    // Dz + i·Sx
+                m_slopeZ[index] = k.y * ih;                                          // Sz
+            }
+        }
+    });
+
+    m_fft.inverse(m_heightDispX.data());
+    m_fft.inverse(m_dispZSlopeX.data());
+    m_fft.inverse(m_slopeZ.data());
+
+    JobSystem::parallelFor(0, n, JOB_GRAIN, [&](int begin, int end) {
+        for (size_t index = static_cast<size_t>(begin) * n; index < static_cast<size_t>(end) * n; ++index) {
+            m_displacement[index * 3 + 0] = m_heightDispX[index].imag();
+            m_displacement[index * 3 + 1] = m_heightDispX[index].real();
+            m_displacement[index * 3 + 2] = m_dispZSlopeX[index].real();
+            m_slope[index * 2 + 0] = m_dispZSlopeX[index].imag();
+            m_slope[index * 2 + 1] = m_slopeZ[index].real();
+        }
+    });
+
+    m_time = time;
+    m_updated = true;
+    ++m_updateCount;
+}
+
+void OceanSpectrum::findOrigin(float x, float z, float& u, float& v) const {
+    const float toTexel = m_resolution / m_tileSize;
+    const float targetU = x * toTexel;
+    const float targetV = z * toTexel;
+    u = targetU;
+    v = targetV;
+    for (int iteration = 0; iteration < INVERSE_ITERATIONS; ++iteration) {
+        const PeriodicSample s = PeriodicSample::locate(u, v, m_resolution);
+        u = targetU - s.sample(&m_displacement[0], 3) * toTexel;
+        v = targetV - s.sample(&m_displacement[2], 3) * toTexel;
+    }
+}
+
+float OceanSpectrum::getWaveHeight(float x, float z) const {
+    float u, v;
+    findOrigin(x, z, u, v);
+    return PeriodicSample::locate(u, v, m_resolution).sample(&m_displacement[1], 3);
+}
+
+void OceanSpectrum::getWaveHeights(const float* xs, const float* zs, float* outHeights, float* outGradX,
+                                   float* outGradZ, size_t count) const {
+    const bool gradients = outGradX && outGradZ;
+    for (size_t i = 0; i < count; ++i) {
+        float u, v;
+        findOrigin(xs[i], zs[i], u, v);
+        const PeriodicSample s = PeriodicSample::locate(u, v, m_resolution);
+        outHeights[i] = s.sample(&m_displacement[1], 3);
+        if (gradients) {
+            outGradX[i] = s.sample(&m_slope[0], 2);
+            outGradZ[i] = s.sample(&m_slope[1], 2);
+        }
+    }
+}
+
+} // namespace WaterTown
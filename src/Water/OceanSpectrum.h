@@ -0,0 +1,137 @@
+#pragma once
+
+#include "../Core/FFT.h"
+#include <glm/glm.hpp>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 海浪能量谱类型
+ */
+enum class OceanSpectrumType {
+    PHILLIPS,  // Tessendorf 论文中的 Phillips 谱
+    JONSWAP    // 有限风区的 JONSWAP 谱（适合河道 / 湖面这类风区较短的水面）
+};
+
+/**
+ * @brief FFT 海面参数
+ */
+struct OceanParams {
+    OceanSpectrumType spectrum = OceanSpectrumType::PHILLIPS;
+    float windSpeed = 5.0f;                            // 风速（米/秒）
+    glm::vec2 windDirection = glm::vec2(0.0f, 1.0f);   // 风向（默认沿主河道）
+    float fetch = 2000.0f;                             // 风区长度（米，仅 JONSWAP）
+    float heightScale = 1.0f;                          // 整体振幅缩放
+    float choppiness = 1.0f;                           // 水平位移系数，0 为纯竖直起伏
+    uint32_t seed = 1;                                 // 初始相位的随机种子
+};
+
+/**
+ * @brief Tessendorf FFT 海面（不依赖 OpenGL）
+ *
+ * 由能量谱生成初始频谱 h0(k)，每个模拟步按深水色散关系 ω = sqrt(g|k|) 推进相位，
+ * 再用三次二维逆 FFT 合成一块可平铺的位移图 (dx, h, dz) 和坡度图 (dh/dx, dh/dz)。
+ * 两张图都定义在拉格朗日网格上（顶点的原始位置），water.vert 按顶点原始坐标采样后直接相加。
+ * 成本只取决于分辨率，与波浪分量数量（N² 个）和水面网格密度无关。
+ */
+class OceanSpectrum {
+public:
+    static constexpr int DEFAULT_RESOLUTION = 128;
+    static constexpr float DEFAULT_TILE_SIZE = 32.0f;
+
+    /**
+     * @param resolution 每边采样数（2 的幂）
+     * @param tileSize 瓦片边长（米）
+     */
+    explicit OceanSpectrum(int resolution = DEFAULT_RESOLUTION, float tileSize = DEFAULT_TILE_SIZE);
+
+    /**
+     * @brief 设置参数并重新生成初始频谱
+     */
+    void setParams(const OceanParams& params);
+    const OceanParams& getParams() const { return m_params; }
+
+    /**
+     * @brief 合成指定时刻的位移图和坡度图（每个模拟步调用一次）
+     */
+    void update(float time);
+
+    /**
+     * @brief 是否已合成该时刻的海面
+     */
+    bool isUpdatedAt(float time) const { return m_updated && m_time == time; }
+
+    /**
+     * @brief 每次 update 加一，渲染端据此判断是否需要重新上传
+     */
+    uint64_t getUpdateCount() const { return m_updateCount; }
+
+    int getResolution() const { return m_resolution; }
+    float getTileSize() const { return m_tileSize; }
+
+    /**
+     * @brief 位移图，每个采样 3 个 float：(dx, h, dz)
+     */
+    const std::vector<float>& getDisplacementMap() const { return m_displacement; }
+
+    /**
+     * @brief 坡度图，每个采样 2 个 float：(dh/dx, dh/dz)
+     */
+    const std::vector<float>& getSlopeMap() const { return m_slope; }
+
+    /**
+     * @brief 查询世界坐标处的波浪高度（不含基准高度），反解水平位移后双线性采样
+     */
+    float getWaveHeight(float x, float z) const;
+
+    /**
+     * @brief 批量查询波浪高度和坡度，outGradX / outGradZ 可为空
+     */
+    void getWaveHeights(const float* xs, const float* zs, float* outHeights, float* outGradX, float* outGradZ,
+                        size_t count) const;
+
+private:
+    static constexpr int JOB_GRAIN = 8;  // 每个作业处理的行数
+
+    /**
+     * @brief 频率下标对应的波矢（FFT 顺序：下标 >= N/2 为负频率）
+     */
+    glm::vec2 waveVector(int i, int j) const;
+
+    /**
+     * @brief 能量谱密度 S(k)（单位面积波数上的方差）
+     */
+    float spectrumDensity(const glm::vec2& k) const;
+
+    /**
+     * @brief 反解水平位移：返回被推到 (x, z) 的顶点原始位置（以采样为单位）
+     */
+    void findOrigin(float x, float z, float& u, float& v) const;
+
+    int m_resolution;
+    float m_tileSize;
+    OceanParams m_params;
+    FFT2D m_fft;
+
+    std::vector<std::complex<float>> m_h0;          // h0(k)
+    std::vector<std::complex<float>> m_h0MinusConj; // conj(h0(-k))
+    std::vector<float> m_omega;                     // ω(k)
+
+    // 打包的频谱：两个实数场放进一个复数场的实部 / 虚部，三次 FFT 得到五个场
+    std::vector<std::complex<float>> m_heightDispX;  // h + i·dx
+    std::vector<std::complex<float>> m_dispZSlopeX;  // dz + i·dh/dx
+    std::vector<std::complex<float>> m_slopeZ;       // dh/dz
+
+    std::vector<float> m_displacement;
+    std::vector<float> m_slope;
+
+    float m_time;
+    bool m_updated;
+    uint64_t m_updateCount;
+};
+
+} // namespace WaterTown
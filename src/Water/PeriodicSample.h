@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+
+namespace WaterTown {
+
+/**
+ * @brief 可平铺网格上的一次双线性采样（分辨率为 2 的幂，坐标按周期回绕）
+ *
+ * WaveHeightfield 和 OceanSpectrum 的 CPU 查询共用。
+ */
+struct PeriodicSample {
+    size_t i00, i10, i01, i11;  // 四个格子的下标（按行存储）
+    float fx, fz;               // 格子内的插值权重
+
+    /**
+     * @brief 定位采样点
+     * @param u 以格子为单位的 X 坐标
+     * @param v 以格子为单位的 Z 坐标
+     * @param resolution 每边格子数（2 的幂）
+     */
+    static PeriodicSample locate(float u, float v, int resolution) {
+        // 截断后对负数修正一位即为向下取整（SSE2 下 std::floor 是函数调用，这里是热点）
+        int iu = static_cast<int>(u);
+        int iv = static_cast<int>(v);
+        iu -= u < static_cast<float>(iu) ? 1 : 0;
+        iv -= v < static_cast<float>(iv) ? 1 : 0;
+        // 负数按补码取掩码同样得到正确的回绕位置
+        const int mask = resolution - 1;
+        const int x0 = iu & mask;
+        const int z0 = iv & mask;
+        const int x1 = (x0 + 1) & mask;
+        const int z1 = (z0 + 1) & mask;
+
+        PeriodicSample s;
+        s.i00 = static_cast<size_t>(z0) * resolution + x0;
+        s.i10 = static_cast<size_t>(z0) * resolution + x1;
+        s.i01 = static_cast<size_t>(z1) * resolution + x0;
+        s.i11 = static_cast<size_t>(z1) * resolution + x1;
+        s.fx = u - static_cast<float>(iu);
+        s.fz = v - static_cast<float>(iv);
+        return s;
+    }
+
+    /**
+     * @brief 采样一个通道：field[index * stride]（交错存储时 field 指向该通道的第一个元素）
+     */
+    float sample(const float* field, size_t stride = 1) const {
+        const float v00 = field[i00 * stride];
+        const float v10 = field[i10 * stride];
+        const float v01 = field[i01 * stride];
+        const float v11 = field[i11 * stride];
+        const float top = v00 + (v10 - v00) * fx;
+        const float bottom = v01 + (v11 - v01) * fx;
+        return top + (bottom - top) * fz;
+    }
+};
+
+} // namespace WaterTown
@@ -0,0 +1,113 @@
+#include "WaterClipmap.h"
+#include "../Render/GreedyMesher.h"
+#include <cmath>
+#include <cstdint>
+
+namespace WaterTown {
+
+constexpr int WaterClipmap::GRID_SIZE;
+constexpr int WaterClipmap::LEVEL_COUNT;
+constexpr float WaterClipmap::BASE_CELL_SIZE;
+constexpr int WaterClipmap::MORPH_CELLS;
+constexpr int WaterClipmap::VERTEX_FLOATS;
+
+namespace {
+
+static_assert(WaterClipmap::GRID_SIZE % 4 == 0, "clipmap grid size must be a multiple of 4");
+
+const int HOLE_SIZE = WaterClipmap::GRID_SIZE / 2;
+const int HOLE_START = WaterClipmap::GRID_SIZE / 4;  // 洞的左下角（还要加上 0 或 1 格的偏移）
+
+} // namespace
+
+WaterClipmap::WaterClipmap() {
+    const int n = GRID_SIZE;
+    m_vertices.reserve(static_cast<size_t>(n + 1) * (n + 1) * VERTEX_FLOATS);
+    for (int z = 0; z <= n; ++z) {
+        for (int x = 0; x <= n; ++x) {
+            m_vertices.push_back(static_cast<float>(x));
+            m_vertices.push_back(0.0f);
+            m_vertices.push_back(static_cast<float>(z));
+            m_vertices.push_back(static_cast<float>(x) / n);
+            m_vertices.push_back(static_cast<float>(z) / n);
+        }
+    }
+
+    GreedyMesher::appendGridIndices(0, n, n, m_indices);
+    m_fullIndexCount = static_cast<uint32_t>(m_indices.size());
+    for (int offsetZ = 0; offsetZ < 2; ++offsetZ) {
+        for (int offsetX = 0; offsetX < 2; ++offsetX) {
+            appendRingIndices(HOLE_START + offsetX, HOLE_START + offsetZ);
+        }
+    }
+    m_ringIndexCount = static_cast<uint32_t>((m_indices.size() - m_fullIndexCount) / 4);
+
+    update(glm::vec3(0.0f));
+}
+
+void WaterClipmap::appendRingIndices(int holeX, int holeZ) {
+    const uint32_t rowStride = static_cast<uint32_t>(GRID_SIZE + 1);
+    for (int z = 0; z < GRID_SIZE; ++z) {
+        const bool rowInHole = z >= holeZ && z < holeZ + HOLE_SIZE;
+        for (int x = 0; x < GRID_SIZE; ++x) {
+            if (rowInHole && x >= holeX && x < holeX + HOLE_SIZE) {
+                continue;
+            }
+            // 与 GreedyMesher::appendGridIndices 相同的三角形划分和环绕方向
+            uint32_t topLeft = z * rowStride + x;
+            uint32_t topRight = topLeft + 1;
+            uint32_t bottomLeft = topLeft + rowStride;
+            uint32_t bottomRight = bottomLeft + 1;
+
+            m_indices.push_back(topLeft);
+            m_indices.push_back(bottomLeft);
+            m_indices.push_back(topRight);
+
+            m_indices.push_back(topRight);
+            m_indices.push_back(bottomLeft);
+            m_indices.push_back(bottomRight);
+        }
+    }
+}
+
+void WaterClipmap::update(const glm::vec3& cameraPos) {
+    // 对齐在整数格子上计算：第 l 层中心 = snap_l * 2 * cell_l，相邻两层的偏移只能是 0 或 1 个 cell_l
+    int64_t previousSnapX = 0;
+    int64_t previousSnapZ = 0;
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        const float cellSize = BASE_CELL_SIZE * static_cast<float>(1 << level);
+        const double snapSize = 2.0 * cellSize;
+        const int64_t snapX = static_cast<int64_t>(std::floor(cameraPos.x / snapSize));
+        const int64_t snapZ = static_cast<int64_t>(std::floor(cameraPos.z / snapSize));
+
+        Level& out = m_levels[level];
+        out.cellSize = cellSize;
+        out.origin = glm::vec2(static_cast<float>((2 * snapX - GRID_SIZE / 2) * static_cast<double>(cellSize)),
+                               static_cast<float>((2 * snapZ - GRID_SIZE / 2) * static_cast<double>(cellSize)));
+
+        // 相机离本层边界至少 GRID_SIZE/2 - 2 个格子，过渡带在此之内结束，边界上的顶点必然完全收拢
+        const float morphEnd = (GRID_SIZE / 2 - 2) * cellSize;
+        const float morphStart = morphEnd - MORPH_CELLS * cellSize;
+        out.morph = level + 1 < LEVEL_COUNT ? glm::vec2(morphStart, 1.0f / (morphEnd - morphStart))
+                                            : glm::vec2(1e30f, 0.0f);  // 最外层没有更粗的邻居
+
+        if (level == 0) {
+            out.indexOffset = 0;
+            out.indexCount = m_fullIndexCount;
+        } else {
+            // 上一层原点在本层中的格子坐标为 GRID_SIZE/4 + (上一层对齐下标 - 2 * 本层对齐下标)
+            const int offsetX = static_cast<int>(previousSnapX - 2 * snapX);
+            const int offsetZ = static_cast<int>(previousSnapZ - 2 * snapZ);
+            out.indexOffset = m_fullIndexCount + static_cast<size_t>(offsetZ * 2 + offsetX) * m_ringIndexCount;
+            out.indexCount = m_ringIndexCount;
+        }
+        previousSnapX = snapX;
+        previousSnapZ = snapZ;
+    }
+}
+
+size_t WaterClipmap::getTriangleCount() const {
+    return (m_fullIndexCount + static_cast<size_t>(LEVEL_COUNT - 1) * m_ringIndexCount) / 3;
+}
+
+} // namespace WaterTown
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 跟随相机的水面几何 clipmap（不依赖 OpenGL）
+ *
+ * LEVEL_COUNT 层同心的正方形网格，每层 GRID_SIZE x GRID_SIZE 个格子，格距逐层翻倍。
+ * 所有层共用同一份顶点（整数网格坐标），由顶点着色器按层的原点和格距放到世界坐标；
+ * 第 0 层是完整网格，其余各层挖掉中间被上一层覆盖的 GRID_SIZE/2 见方的洞。
+ *
+ * 每层的中心对齐到自身格距的两倍，因此上一层的边界总落在本层的格点上，
+ * 洞相对本层只有 4 种位置，对应的索引区间在构造时一次生成，之后不再修改。
+ * 每层外圈的顶点在顶点着色器里向偶数格点收拢（morph），到边界时与下一层的顶点完全重合，不会出现裂缝。
+ *
+ * 顶点数与河道长度无关，近处的格距为 BASE_CELL_SIZE。
+ */
+class WaterClipmap {
+public:
+    static constexpr int GRID_SIZE = 64;             // 每层每边格子数（4 的倍数）
+    static constexpr int LEVEL_COUNT = 8;            // 层数（最外层边长 GRID_SIZE * BASE_CELL_SIZE * 2^(LEVEL_COUNT-1)）
+    static constexpr float BASE_CELL_SIZE = 0.25f;   // 第 0 层格距（米）
+    static constexpr int MORPH_CELLS = 8;            // 外圈过渡带宽度（格子数）
+    static constexpr int VERTEX_FLOATS = 5;          // 顶点格式与 WaterMeshBuilder 相同：(x, y, z, u, v)
+
+    /**
+     * @brief 一层在当前帧的摆放
+     */
+    struct Level {
+        glm::vec2 origin;    // 网格坐标 (0, 0) 处的世界坐标 (x, z)
+        float cellSize;      // 格距（米）
+        glm::vec2 morph;     // (开始过渡的距离, 1 / 过渡带宽度)，距离按相机的切比雪夫距离计
+        size_t indexOffset;  // 在 getIndices() 中的起始位置
+        uint32_t indexCount;
+    };
+
+    /**
+     * @brief 生成共用的顶点和各种洞位置的索引
+     */
+    WaterClipmap();
+
+    /**
+     * @brief 按相机位置摆放各层（每帧渲染前调用）
+     */
+    void update(const glm::vec3& cameraPos);
+
+    const Level& getLevel(int level) const { return m_levels[level]; }
+
+    /**
+     * @brief 顶点数据：x / z 为整数网格坐标，y 为 0，uv 为归一化的网格坐标
+     */
+    const std::vector<float>& getVertices() const { return m_vertices; }
+    const std::vector<uint32_t>& getIndices() const { return m_indices; }
+
+    /**
+     * @brief 所有层合计的三角形数（与相机位置无关）
+     */
+    size_t getTriangleCount() const;
+
+private:
+    /**
+     * @brief 追加一块挖洞的网格，洞的左下角位于 (holeX, holeZ)，边长 GRID_SIZE/2
+     */
+    void appendRingIndices(int holeX, int holeZ);
+
+    std::vector<float> m_vertices;
+    std::vector<uint32_t> m_indices;
+    uint32_t m_fullIndexCount;  // 第 0 层完整网格的索引数（位于开头）
+    uint32_t m_ringIndexCount;  // 每种挖洞网格的索引数（4 种依次排在后面）
+    Level m_levels[LEVEL_COUNT];
+};
+
+} // namespace WaterTown
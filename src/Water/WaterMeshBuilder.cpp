@@ -0,0 +1,35 @@
+#include "WaterMeshBuilder.h"
+#include "../Render/GreedyMesher.h"
+
+namespace WaterTown {
+
+void WaterMeshBuilder::buildGrid(float centerX, float centerZ, float width, float height, int resolution,
+                                 std::vector<float>& outVertices, std::vector<uint32_t>& outIndices) {
+    outVertices.clear();
+    outIndices.clear();
+    outVertices.reserve(static_cast<size_t>(resolution + 1) * (resolution + 1) * VERTEX_FLOATS);
+    outIndices.reserve(static_cast<size_t>(resolution) * resolution * 6);
+
+    // 生成网格顶点（只需要位置，法线在着色器中计算）
+    float stepX = width / resolution;
+    float stepZ = height / resolution;
+    float startX = centerX - width / 2.0f;
+    float startZ = centerZ - height / 2.0f;
+
+    for (int z = 0; z <= resolution; ++z) {
+        for (int x = 0; x <= resolution; ++x) {
+            // 位置（始终以 0 为基准，在渲染阶段平移到基准高度）
+            outVertices.push_back(startX + x * stepX);
+            outVertices.push_back(0.0f);
+            outVertices.push_back(startZ + z * stepZ);
+
+            // UV 坐标（用于纹理或其他效果）
+            outVertices.push_back(static_cast<float>(x) / resolution);
+            outVertices.push_back(static_cast<float>(z) / resolution);
+        }
+    }
+
+    GreedyMesher::appendGridIndices(0, resolution, resolution, outIndices);
+}
+
+} // namespace WaterTown
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief 水面网格生成器（不依赖 OpenGL）
+ *
+ * 只生成 CPU 端的顶点/索引数据，顶点格式为 (x, y, z, u, v)，
+ * 上传由 WaterSurface 负责。哪些格子有水由片段着色器按地形类型图决定，这里不再按格子生成网格。
+ */
+class WaterMeshBuilder {
+public:
+    static constexpr int VERTEX_FLOATS = 5;  // 每个顶点的 float 数
+
+    /**
+     * @brief 生成以 (centerX, centerZ) 为中心的规则网格（默认水面）
+     * @param resolution 每边的格子数
+     */
+    static void buildGrid(float centerX, float centerZ, float width, float height, int resolution,
+                          std::vector<float>& outVertices, std::vector<uint32_t>& outIndices);
+};
+
+} // namespace WaterTown
@@ -1,9 +1,15 @@
 #include "WaterSurface.h"
 #include "BoatWake.h"
+#include "WaterClipmap.h"
+#include "WaterMeshBuilder.h"
+#include "../Core/TerrainMap.h"
 #include "../Render/Shader.h"
 #include "../Render/Camera.h"
+#include "../Render/GLState.h"
+#include "../Render/GLCounters.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -11,16 +17,10 @@ namespace WaterTown {
 
 WaterSurface::WaterSurface(float centerX, float centerZ, float width, float height, int resolution)
     : m_centerX(centerX), m_centerZ(centerZ), m_width(width), m_height(height),
-      m_baseHeight(0.0f), m_resolution(resolution), m_VAO(0), m_VBO(0), m_EBO(0),
-      m_vertexCount(0), m_indexCount(0), m_useCustomMesh(false),
+      m_resolution(resolution), m_VAO(0), m_VBO(0), m_EBO(0),
+      m_vertexCount(0), m_indexCount(0),
       m_wakeSystem(std::make_unique<BoatWake>()) {
     
-    // 初始化默认波浪参数（4 个不同方向的波浪）
-    m_waves.push_back({glm::vec2(1.0f, 0.0f), 0.15f, 2.0f, 1.0f, 0.3f});
-    m_waves.push_back({glm::vec2(0.7f, 0.7f), 0.1f, 1.5f, 1.2f, 0.2f});
-    m_waves.push_back({glm::vec2(0.0f, 1.0f), 0.08f, 1.0f, 0.8f, 0.25f});
-    m_waves.push_back({glm::vec2(-0.5f, 0.5f), 0.05f, 0.8f, 1.5f, 0.15f});
-    
     generateMesh();
     
     std::cout << "WaterSurface created: " << m_vertexCount << " vertices, " 
@@ -28,83 +28,99 @@ WaterSurface::WaterSurface(float centerX, float centerZ, float width, float heig
 }
 
 WaterSurface::~WaterSurface() {
-    if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
-    if (m_VBO) glDeleteBuffers(1, &m_VBO);
-    if (m_EBO) glDeleteBuffers(1, &m_EBO);
+    if (m_VAO) GLState::deleteVertexArrays(1, &m_VAO);
+    if (m_VBO) GLState::deleteBuffers(1, &m_VBO);
+    if (m_EBO) GLState::deleteBuffers(1, &m_EBO);
+    if (m_oceanDisplacementTexture) GLState::deleteTextures(1, &m_oceanDisplacementTexture);
+    if (m_oceanSlopeTexture) GLState::deleteTextures(1, &m_oceanSlopeTexture);
+    if (m_terrainMaskTexture) GLState::deleteTextures(1, &m_terrainMaskTexture);
+    if (m_clipmapVAO) GLState::deleteVertexArrays(1, &m_clipmapVAO);
+    if (m_clipmapVBO) GLState::deleteBuffers(1, &m_clipmapVBO);
+    if (m_clipmapEBO) GLState::deleteBuffers(1, &m_clipmapEBO);
 }
 
-void WaterSurface::updateMesh(const std::vector<float>& vertices) {
-    m_useCustomMesh = true;
-    
-    if (m_VAO == 0) {
-        glGenVertexArrays(1, &m_VAO);
-        glGenBuffers(1, &m_VBO);
+void WaterSurface::setTerrainMask(const TerrainMap& terrain, float cellSize) {
+    const int width = terrain.getChunksX() * TerrainMap::CHUNK_SIZE;
+    const int height = terrain.getChunksZ() * TerrainMap::CHUNK_SIZE;
+    if (m_terrainMaskTexture == 0) {
+        glGenTextures(1, &m_terrainMaskTexture);
     }
-    
-    glBindVertexArray(m_VAO);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-    
-    // 如果使用 updateMesh，通常不再使用 EBO (glDrawArrays)
-    m_vertexCount = vertices.size() / 5; // 5 floats per vertex
-    
-    // 位置属性
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    GLState::bindTexture(TERRAIN_MASK_UNIT, m_terrainMaskTexture);
+    if (width != m_terrainMaskWidth || height != m_terrainMaskHeight) {
+        // 整数纹理只能用最近邻过滤
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        GLCounters::texImage2D(0, GL_R8UI, width, height, GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
+        m_terrainMaskWidth = width;
+        m_terrainMaskHeight = height;
+    }
+    m_terrainSize = glm::vec2(static_cast<float>(terrain.getSizeX()), static_cast<float>(terrain.getSizeZ()));
+    m_terrainOrigin = -0.5f * m_terrainSize * cellSize;
+    m_terrainCellSize = cellSize;
+
+    for (int chunkZ = 0; chunkZ < terrain.getChunksZ(); ++chunkZ) {
+        for (int chunkX = 0; chunkX < terrain.getChunksX(); ++chunkX) {
+            uploadTerrainMaskChunk(terrain, chunkX, chunkZ);
+        }
+    }
+}
+
+void WaterSurface::uploadTerrainMaskChunk(const TerrainMap& terrain, int chunkX, int chunkZ) {
+    // 区块在 TerrainMap 中按行连续存储，正好是一块 CHUNK_SIZE 见方的子图像（每行 32 字节，满足默认的 4 字节对齐）
+    const int size = TerrainMap::CHUNK_SIZE;
+    GLCounters::texSubImage2D(0, chunkX * size, chunkZ * size, size, size, GL_RED_INTEGER, GL_UNSIGNED_BYTE,
+                              terrain.chunkTypes(chunkX, chunkZ));
+}
+
+void WaterSurface::updateTerrainMaskCell(const TerrainMap& terrain, int x, int z) {
+    if (m_terrainMaskTexture == 0 || !terrain.inBounds(x, z)) return;
+
+    // 单行的子图像不受 GL_UNPACK_ALIGNMENT 影响
+    const TerrainType type = terrain.get(x, z);
+    GLState::bindTexture(TERRAIN_MASK_UNIT, m_terrainMaskTexture);
+    GLCounters::texSubImage2D(0, x, z, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_BYTE, &type);
+}
+
+void WaterSurface::setClipmapEnabled(bool enabled) {
+    m_clipmapEnabled = enabled;
+    if (!enabled || m_clipmap) {
+        return;
+    }
+
+    // 所有层共用一份顶点和索引，只上传一次
+    m_clipmap.reset(new WaterClipmap());
+    const std::vector<float>& vertices = m_clipmap->getVertices();
+    const std::vector<uint32_t>& indices = m_clipmap->getIndices();
+
+    glGenVertexArrays(1, &m_clipmapVAO);
+    glGenBuffers(1, &m_clipmapVBO);
+    glGenBuffers(1, &m_clipmapEBO);
+
+    GLState::bindVertexArray(m_clipmapVAO);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, m_clipmapVBO);
+    GLCounters::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_clipmapEBO);
+    GLCounters::bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+
+    const GLsizei stride = WaterClipmap::VERTEX_FLOATS * sizeof(float);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
     glEnableVertexAttribArray(0);
-    
-    // UV 属性
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
-    
-    glBindVertexArray(0);
+
+    GLState::bindVertexArray(0);
+
+    std::cout << "WaterClipmap created: " << vertices.size() / WaterClipmap::VERTEX_FLOATS << " vertices, "
+              << m_clipmap->getTriangleCount() << " triangles per frame" << std::endl;
 }
 
 void WaterSurface::generateMesh() {
+    // 顶点/索引在 CPU 端生成，这里只负责上传
     std::vector<float> vertices;
-    std::vector<unsigned int> indices;
-    
-    // 生成网格顶点（只需要位置，法线在着色器中计算）
-    float stepX = m_width / m_resolution;
-    float stepZ = m_height / m_resolution;
-    float startX = m_centerX - m_width / 2.0f;
-    float startZ = m_centerZ - m_height / 2.0f;
-    
-    for (int z = 0; z <= m_resolution; ++z) {
-        for (int x = 0; x <= m_resolution; ++x) {
-            float posX = startX + x * stepX;
-            float posZ = startZ + z * stepZ;
-            
-            // 位置（始终以 0 为基准，在渲染阶段平移到 m_baseHeight）
-            vertices.push_back(posX);
-            vertices.push_back(0.0f);
-            vertices.push_back(posZ);
-            
-            // UV 坐标（用于纹理或其他效果）
-            vertices.push_back(static_cast<float>(x) / m_resolution);
-            vertices.push_back(static_cast<float>(z) / m_resolution);
-        }
-    }
-    
-    // 生成索引
-    for (int z = 0; z < m_resolution; ++z) {
-        for (int x = 0; x < m_resolution; ++x) {
-            int topLeft = z * (m_resolution + 1) + x;
-            int topRight = topLeft + 1;
-            int bottomLeft = (z + 1) * (m_resolution + 1) + x;
-            int bottomRight = bottomLeft + 1;
-            
-            // 第一个三角形
-            indices.push_back(topLeft);
-            indices.push_back(bottomLeft);
-            indices.push_back(topRight);
-            
-            // 第二个三角形
-            indices.push_back(topRight);
-            indices.push_back(bottomLeft);
-            indices.push_back(bottomRight);
-        }
-    }
+    std::vector<uint32_t> indices;
+    WaterMeshBuilder::buildGrid(m_centerX, m_centerZ, m_width, m_height, m_resolution, vertices, indices);
     
     m_vertexCount = (m_resolution + 1) * (m_resolution + 1);
     m_indexCount = static_cast<int>(indices.size());
@@ -114,13 +130,13 @@ void WaterSurface::generateMesh() {
     glGenBuffers(1, &m_VBO);
     glGenBuffers(1, &m_EBO);
     
-    glBindVertexArray(m_VAO);
+    GLState::bindVertexArray(m_VAO);
     
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    GLState::bindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    GLCounters::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    GLCounters::bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
     
     // 位置属性
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
@@ -130,129 +146,233 @@ void WaterSurface::generateMesh() {
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
+}
+
+void WaterSurface::fillWaveUniforms(WaveUniforms& out) const {
+    out = {};
+    const std::vector<WaveParams>& waves = m_waveModel.getActiveWaves();
+    int waveCount = std::min(static_cast<int>(waves.size()), MAX_WAVES);
+    out.waveCount = waveCount;
+    for (int i = 0; i < waveCount; ++i) {
+        out.waves[i].direction = waves[i].direction;
+        out.waves[i].amplitude = waves[i].amplitude;
+        out.waves[i].wavelength = waves[i].wavelength;
+        out.waves[i].speed = waves[i].speed;
+        out.waves[i].steepness = waves[i].steepness;
+    }
 }
 
-void WaterSurface::render(Shader* shader,
+void WaterSurface::resolveUniforms(const Shader* shader, WaterUniforms& u) {
+    u.model = shader->getUniform("uModel");
+    u.waterColor = shader->getUniform("uWaterColor");
+    u.lightDir = shader->getUniform("uLightDir");
+    u.useBoatCutout = shader->getUniform("uUseBoatCutout");
+    u.boatPos = shader->getUniform("uBoatPos");
+    u.boatCutoutInner = shader->getUniform("uBoatCutoutInner");
+    u.boatCutoutOuter = shader->getUniform("uBoatCutoutOuter");
+    u.boatCutoutShape = shader->getUniform("uBoatCutoutShape");
+    u.boatForwardXZ = shader->getUniform("uBoatForwardXZ");
+    u.boatHalfExtentsXZ = shader->getUniform("uBoatHalfExtentsXZ");
+    u.boatCutoutFeather = shader->getUniform("uBoatCutoutFeather");
+    u.wakeCount = shader->getUniform("uWakeCount");
+    u.boatSpeed = shader->getUniform("uBoatSpeed");
+    u.wakePos = shader->getUniform("uWakePos");
+    u.wakeAmplitude = shader->getUniform("uWakeAmplitude");
+    u.oceanDisplacement = shader->getUniform("uOceanDisplacement");
+    u.oceanSlope = shader->getUniform("uOceanSlope");
+    u.oceanTileSize = shader->getUniform("uOceanTileSize");
+    u.clipmapOrigin = shader->getUniform("uClipmapOrigin");
+    u.clipmapCellSize = shader->getUniform("uClipmapCellSize");
+    u.clipmapMorph = shader->getUniform("uClipmapMorph");
+    u.terrainMask = shader->getUniform("uTerrainMask");
+    u.terrainOrigin = shader->getUniform("uTerrainOrigin");
+    u.terrainCellSize = shader->getUniform("uTerrainCellSize");
+    u.terrainSize = shader->getUniform("uTerrainSize");
+}
+
+const WaterSurface::WaterVariant& WaterSurface::selectVariant(Shader* shader, CutoutVariant cutout, bool wake,
+                                                              bool ocean, bool terrainMask, bool clipmap) {
+    if (shader != m_variantSource) {
+        m_variantSource = shader;
+        for (WaterVariant& variant : m_variants) {
+            variant.shader = nullptr;
+        }
+    }
+    
+    int index = static_cast<int>(cutout);
+    index = index * 2 + (wake ? 1 : 0);
+    index = index * 2 + (ocean ? 1 : 0);
+    index = index * 2 + (terrainMask ? 1 : 0);
+    index = index * 2 + (clipmap ? 1 : 0);
+    WaterVariant& variant = m_variants[index];
+    if (!variant.shader) {
+        variant.shader = shader->getVariant({
+            "VARIANT_BOAT_CUTOUT " + std::to_string(static_cast<int>(cutout)),
+            std::string("VARIANT_WAKE ") + (wake ? "1" : "0"),
+            std::string("VARIANT_OCEAN_FFT ") + (ocean ? "1" : "0"),
+            std::string("VARIANT_TERRAIN_MASK ") + (terrainMask ? "1" : "0"),
+            std::string("VARIANT_WATER_CLIPMAP ") + (clipmap ? "1" : "0")
+        });
+        resolveUniforms(variant.shader, variant.uniforms);
+    }
+    return variant;
+}
+
+void WaterSurface::uploadOceanMaps() {
+    const OceanSpectrum* ocean = m_waveModel.getOcean();
+    if (!ocean || ocean->getUpdateCount() == m_oceanUploadedCount) {
+        return;
+    }
+    const int resolution = ocean->getResolution();
+    const float* displacement = ocean->getDisplacementMap().data();
+    const float* slope = ocean->getSlopeMap().data();
+
+    if (m_oceanDisplacementTexture == 0 || m_oceanTextureResolution != resolution) {
+        if (m_oceanDisplacementTexture == 0) {
+            glGenTextures(1, &m_oceanDisplacementTexture);
+            glGenTextures(1, &m_oceanSlopeTexture);
+        }
+        auto allocate = [resolution](GLuint unit, GLuint texture, GLint internalFormat, GLenum format,
+                                     const float* data) {
+            GLState::bindTexture(unit, texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            GLCounters::texImage2D(0, internalFormat, resolution, resolution, format, GL_FLOAT, data);
+        };
+        allocate(OCEAN_DISPLACEMENT_UNIT, m_oceanDisplacementTexture, GL_RGB32F, GL_RGB, displacement);
+        allocate(OCEAN_SLOPE_UNIT, m_oceanSlopeTexture, GL_RG32F, GL_RG, slope);
+        m_oceanTextureResolution = resolution;
+    } else {
+        // 存储已分配好，每帧只覆盖内容，驱动不需要重新分配
+        GLState::bindTexture(OCEAN_DISPLACEMENT_UNIT, m_oceanDisplacementTexture);
+        GLCounters::texSubImage2D(0, 0, 0, resolution, resolution, GL_RGB, GL_FLOAT, displacement);
+        GLState::bindTexture(OCEAN_SLOPE_UNIT, m_oceanSlopeTexture);
+        GLCounters::texSubImage2D(0, 0, 0, resolution, resolution, GL_RG, GL_FLOAT, slope);
+    }
+    m_oceanUploadedCount = ocean->getUpdateCount();
+}
+
+void WaterSurface::render(Shader* baseShader,
                           Camera* camera,
-                          float time,
                           const glm::vec3& boatPos,
                           float boatCutoutInner,
                           float boatCutoutOuter,
                           glm::vec2 boatForwardXZ,
                           glm::vec2 boatHalfExtentsXZ,
                           float boatCutoutFeather) {
-    if (!shader || !camera) return;
+    if (!baseShader || !camera) return;
     
-    shader->use();
+    // 船只裁剪（避免水出现在船板上）
+    bool useObb = (boatHalfExtentsXZ.x > 0.0f && boatHalfExtentsXZ.y > 0.0f && boatCutoutFeather > 0.0f);
+    bool useCircle = (boatCutoutInner > 0.0f && boatCutoutOuter >= boatCutoutInner);
+    bool useCutout = useObb || useCircle;
+    CutoutVariant cutout = useObb ? CUTOUT_OBB : (useCircle ? CUTOUT_CIRCLE : CUTOUT_NONE);
     
-    // 设置 MVP 矩阵
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, m_baseHeight, 0.0f));
-    shader->setMat4("uModel", model);
-    shader->setMat4("uView", camera->getViewMatrix());
-    shader->setMat4("uProjection", camera->getProjectionMatrix());
+    // 尾流只在船速超过阈值（与 water.frag 一致）且有粒子时生效
+    int wakeCount = 0;
+    float boatSpeed = 0.0f;
+    if (m_wakeSystem) {
+        wakeCount = std::min(static_cast<int>(m_wakeSystem->getParticles().size()), MAX_WAKE_POINTS);
+        boatSpeed = m_wakeSystem->getCurrentBoatSpeed();
+    }
+    bool useWake = wakeCount > 0 && boatSpeed > 4.0f;
+
+    // FFT 海面只有在当前帧已合成过时才使用，否则退回 Gerstner 波
+    const OceanSpectrum* ocean = m_waveModel.getOcean();
+    bool useOcean = ocean && ocean->getUpdateCount() > 0;
+    if (useOcean) {
+        uploadOceanMaps();
+    }
     
-    // 设置时间和相机位置
-    shader->setFloat("uTime", time);
-    shader->setVec3("uViewPos", camera->getPosition());
+    // 有地形类型图时按格子丢弃陆地上的片元；clipmap 会铺满相机周围，必须有地形类型图才能使用
+    bool useTerrainMask = m_terrainMaskTexture != 0;
+    bool useClipmap = m_clipmapEnabled && m_clipmap && useTerrainMask;
+    if (useClipmap) {
+        m_clipmap->update(camera->getPosition());
+    }
     
-    // 设置波浪参数（最多 4 个波浪）
-    int waveCount = std::min(static_cast<int>(m_waves.size()), 4);
-    shader->setInt("uWaveCount", waveCount);
+    const WaterVariant& variant = selectVariant(baseShader, cutout, useWake, useOcean, useTerrainMask, useClipmap);
+    Shader* shader = variant.shader;
+    const WaterUniforms& u = variant.uniforms;
+    shader->use();
     
-    for (int i = 0; i < waveCount; ++i) {
-        std::string prefix = "uWaves[" + std::to_string(i) + "].";
-        shader->setVec2(prefix + "direction", m_waves[i].direction);
-        shader->setFloat(prefix + "amplitude", m_waves[i].amplitude);
-        shader->setFloat(prefix + "wavelength", m_waves[i].wavelength);
-        shader->setFloat(prefix + "speed", m_waves[i].speed);
-        shader->setFloat(prefix + "steepness", m_waves[i].steepness);
-    }
+    // 模型矩阵（相机矩阵与时间来自 FrameBlock，波浪参数来自 WaveBlock）
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, m_waveModel.getBaseHeight(), 0.0f));
+    shader->setMat4(u.model, model);
     
     // 水面颜色参数
-    shader->setVec3("uWaterColor", glm::vec3(0.1f, 0.3f, 0.5f));  // 深蓝色
-    shader->setVec3("uLightDir", glm::normalize(glm::vec3(0.5f, 1.0f, 0.3f)));
-
-    // 船只裁剪（避免水出现在船板上）
-    bool useObb = (boatHalfExtentsXZ.x > 0.0f && boatHalfExtentsXZ.y > 0.0f && boatCutoutFeather > 0.0f);
-    bool useCircle = (boatCutoutInner > 0.0f && boatCutoutOuter >= boatCutoutInner);
-    bool useCutout = useObb || useCircle;
+    shader->setVec3(u.waterColor, glm::vec3(0.1f, 0.3f, 0.5f));  // 深蓝色
+    shader->setVec3(u.lightDir, glm::normalize(glm::vec3(0.5f, 1.0f, 0.3f)));
 
-    shader->setInt("uUseBoatCutout", useCutout ? 1 : 0);
-    shader->setVec3("uBoatPos", boatPos);
-    shader->setFloat("uBoatCutoutInner", boatCutoutInner);
-    shader->setFloat("uBoatCutoutOuter", boatCutoutOuter);
-    shader->setInt("uBoatCutoutShape", useObb ? 1 : 0);
-    shader->setVec2("uBoatForwardXZ", boatForwardXZ);
-    shader->setVec2("uBoatHalfExtentsXZ", boatHalfExtentsXZ);
-    shader->setFloat("uBoatCutoutFeather", boatCutoutFeather);
+    // 裁剪开关与形状已编译进变体，这里只设置参数（被裁掉的 uniform 句柄为 -1，设置会被忽略）
+    shader->setInt(u.useBoatCutout, useCutout ? 1 : 0);
+    shader->setInt(u.boatCutoutShape, useObb ? 1 : 0);
+    if (useCutout) {
+        shader->setVec3(u.boatPos, boatPos);
+        shader->setFloat(u.boatCutoutInner, boatCutoutInner);
+        shader->setFloat(u.boatCutoutOuter, boatCutoutOuter);
+        shader->setVec2(u.boatForwardXZ, boatForwardXZ);
+        shader->setVec2(u.boatHalfExtentsXZ, boatHalfExtentsXZ);
+        shader->setFloat(u.boatCutoutFeather, boatCutoutFeather);
+    }
     
-    // 船尾波浪粒子系统
-    if (m_wakeSystem) {
+    // 船尾波浪粒子系统（打包后整个数组一次上传）
+    shader->setFloat(u.boatSpeed, boatSpeed);
+    if (useWake) {
         const auto& particles = m_wakeSystem->getParticles();
-        int wakeCount = std::min(static_cast<int>(particles.size()), 20);
-        shader->setInt("uWakeCount", wakeCount);
-        shader->setFloat("uBoatSpeed", m_wakeSystem->getCurrentBoatSpeed());
-        
+        shader->setInt(u.wakeCount, wakeCount);
         for (int i = 0; i < wakeCount; ++i) {
-            shader->setVec3("uWakePos[" + std::to_string(i) + "]", particles[i].position);
-            shader->setFloat("uWakeAmplitude[" + std::to_string(i) + "]", particles[i].amplitude);
+            m_wakePositions[i] = particles[i].position;
+            m_wakeAmplitudes[i] = particles[i].amplitude;
         }
+        shader->setVec3Array(u.wakePos, m_wakePositions, wakeCount);
+        shader->setFloatArray(u.wakeAmplitude, m_wakeAmplitudes, wakeCount);
     } else {
-        shader->setInt("uWakeCount", 0);
-        shader->setFloat("uBoatSpeed", 0.0f);
+        shader->setInt(u.wakeCount, 0);
+    }
+
+    if (useOcean) {
+        GLState::bindTexture(OCEAN_DISPLACEMENT_UNIT, m_oceanDisplacementTexture);
+        GLState::bindTexture(OCEAN_SLOPE_UNIT, m_oceanSlopeTexture);
+        shader->setInt(u.oceanDisplacement, static_cast<int>(OCEAN_DISPLACEMENT_UNIT));
+        shader->setInt(u.oceanSlope, static_cast<int>(OCEAN_SLOPE_UNIT));
+        shader->setFloat(u.oceanTileSize, ocean->getTileSize());
+    }
+
+    if (useTerrainMask) {
+        GLState::bindTexture(TERRAIN_MASK_UNIT, m_terrainMaskTexture);
+        shader->setInt(u.terrainMask, static_cast<int>(TERRAIN_MASK_UNIT));
+        shader->setVec2(u.terrainOrigin, m_terrainOrigin);
+        shader->setFloat(u.terrainCellSize, m_terrainCellSize);
+        shader->setVec2(u.terrainSize, m_terrainSize);
     }
     
     // 启用混合（半透明效果）
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::setBlend(true);
+    GLState::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // 渲染水面
-    glBindVertexArray(m_VAO);
-    if (m_useCustomMesh) {
-         glDrawArrays(GL_TRIANGLES, 0, m_vertexCount);
+    if (useClipmap) {
+        // 每层一次绘制：同一份顶点，按层设置原点 / 格距 / 过渡带，索引区间对应本层洞的位置
+        GLState::bindVertexArray(m_clipmapVAO);
+        for (int level = 0; level < WaterClipmap::LEVEL_COUNT; ++level) {
+            const WaterClipmap::Level& placement = m_clipmap->getLevel(level);
+            shader->setVec2(u.clipmapOrigin, placement.origin);
+            shader->setFloat(u.clipmapCellSize, placement.cellSize);
+            shader->setVec2(u.clipmapMorph, placement.morph);
+            GLCounters::drawElements(GL_TRIANGLES, static_cast<GLsizei>(placement.indexCount), GL_UNSIGNED_INT,
+                                     reinterpret_cast<const void*>(placement.indexOffset * sizeof(uint32_t)));
+        }
     } else {
-         glDrawElements(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_INT, 0);
+        GLState::bindVertexArray(m_VAO);
+        GLCounters::drawElements(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_INT, 0);
     }
-    glBindVertexArray(0);
+    GLState::bindVertexArray(0);
     
-    glDisable(GL_BLEND);
-}
-
-float WaterSurface::getWaterHeight(float x, float z, float time) const {
-    return m_baseHeight + calculateGerstnerHeight(x, z, time);
-}
-
-float WaterSurface::calculateGerstnerHeight(float x, float z, float time) const {
-    float height = 0.0f;
-    
-    for (const auto& wave : m_waves) {
-        float k = 2.0f * glm::pi<float>() / wave.wavelength;
-        float c = wave.speed;
-        float d_dot_p = wave.direction.x * x + wave.direction.y * z;
-        float phase = k * d_dot_p - c * time;
-        
-        // Gerstner Wave 高度公式
-        height += wave.amplitude * std::sin(phase);
-    }
-    
-    return height;
-}
-
-void WaterSurface::setWaveParameters(int waveCount, float amplitude, float wavelength, float speed) {
-    m_waves.clear();
-    
-    // 生成多个不同方向的波浪
-    for (int i = 0; i < waveCount; ++i) {
-        float angle = (2.0f * glm::pi<float>() * i) / waveCount;
-        WaveParams wave;
-        wave.direction = glm::normalize(glm::vec2(std::cos(angle), std::sin(angle)));
-        wave.amplitude = amplitude * (1.0f - i * 0.2f);  // 逐渐减小
-        wave.wavelength = wavelength * (1.0f + i * 0.3f);
-        wave.speed = speed * (1.0f - i * 0.15f);
-        wave.steepness = 0.3f;
-        m_waves.push_back(wave);
-    }
+    GLState::setBlend(false);
 }
 
 } // namespace WaterTown
@@ -2,14 +2,19 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include "../Render/Shader.h"
+#include "../Render/UniformBuffers.h"
+#include "WaveModel.h"
 
 namespace WaterTown {
 
-class Shader;
 class Camera;
 class BoatWake;
+class TerrainMap;
+class WaterClipmap;
 
 /**
  * @brief 水面渲染类，实现 Gerstner Waves 波浪效果
@@ -55,14 +60,15 @@ public:
      * @brief 渲染水面
      * @param shader 水面着色器
      * @param camera 当前相机
-     * @param time 当前时间（秒）
+     *
+     * 相机矩阵、时间和波浪参数来自共享的 FrameBlock / WaveBlock（见 UniformBuffers）。
+     * 根据裁剪形状、尾流是否生效以及是否打开 FFT 海面选择 shader 的编译期变体，不用的分支不会进入着色器。
         * @param boatPos 船只世界坐标（用于水面裁剪，防止水出现在船板上）
         * @param boatCutoutInner 船只裁剪内半径（<=0 表示禁用）
         * @param boatCutoutOuter 船只裁剪外半径（用于羽化边缘，需 >= inner）
      */
         void render(Shader* shader,
                  Camera* camera,
-                 float time,
                  const glm::vec3& boatPos = glm::vec3(0.0f),
                  float boatCutoutInner = 0.0f,
                  float boatCutoutOuter = 0.0f,
@@ -71,10 +77,33 @@ public:
                  float boatCutoutFeather = 0.0f);
 
     /**
-     * @brief 更新水面网格（用于自定义形状的水面）
-     * @param vertices 顶点数据 (x, y, z, u, v) x N
+     * @brief 填写 WaveBlock 的内容（由应用每帧上传）
      */
-    void updateMesh(const std::vector<float>& vertices);
+    void fillWaveUniforms(WaveUniforms& out) const;
+
+    /**
+     * @brief 上传整张地形类型图（R8UI，每个格子一个 texel），尺寸变化时重新分配纹理
+     * @param terrain 地形数据（网格以地形中心为原点）
+     * @param cellSize 格子边长（世界单位）
+     *
+     * 上传后水面不再需要按格子生成的网格：规则网格或 clipmap 覆盖整片区域，
+     * 片段着色器丢弃非 WATER 格子上的片元，并按到岸边的距离叠加泡沫。
+     */
+    void setTerrainMask(const TerrainMap& terrain, float cellSize);
+
+    /**
+     * @brief 单格编辑后只重新上传一个 texel
+     */
+    void updateTerrainMaskCell(const TerrainMap& terrain, int x, int z);
+
+    /**
+     * @brief 打开 / 关闭 clipmap 水面（见 WaterClipmap）
+     *
+     * 打开且已有地形类型图时渲染跟随相机的 clipmap 网格，顶点数与河道长度无关；
+     * 关闭时退回构造时生成的规则网格。
+     */
+    void setClipmapEnabled(bool enabled);
+    bool isClipmapEnabled() const { return m_clipmapEnabled; }
     
     /**
      * @brief 获取指定位置的水面高度（用于船只浮力计算）
@@ -83,7 +112,7 @@ public:
      * @param time 当前时间
      * @return 该位置的水面高度（Y 坐标）
      */
-    float getWaterHeight(float x, float z, float time) const;
+    float getWaterHeight(float x, float z, float time) const { return m_waveModel.getWaterHeight(x, z, time); }
     
     /**
      * @brief 设置波浪参数
@@ -92,50 +121,131 @@ public:
      * @param wavelength 波长
      * @param speed 波速
      */
-    void setWaveParameters(int waveCount, float amplitude, float wavelength, float speed);
+    void setWaveParameters(int waveCount, float amplitude, float wavelength, float speed) {
+        m_waveModel.setWaveParameters(waveCount, amplitude, wavelength, speed);
+    }
     
     /**
      * @brief 获取水面基准高度
      */
-    float getBaseHeight() const { return m_baseHeight; }
+    float getBaseHeight() const { return m_waveModel.getBaseHeight(); }
     
     /**
      * @brief 设置水面基准高度
      */
-    void setBaseHeight(float height) { m_baseHeight = height; }
+    void setBaseHeight(float height) { m_waveModel.setBaseHeight(height); }
+    
+    /**
+     * @brief 打开 / 关闭烘焙高度场（见 WaveModel::setHeightfieldEnabled）
+     */
+    void setHeightfieldEnabled(bool enabled) { m_waveModel.setHeightfieldEnabled(enabled); }
+    bool isHeightfieldEnabled() const { return m_waveModel.isHeightfieldEnabled(); }
+
+    /**
+     * @brief 打开 / 关闭 FFT 海面（见 WaveModel::setOceanEnabled），打开后渲染改用 VARIANT_OCEAN_FFT 变体
+     */
+    void setOceanEnabled(bool enabled) { m_waveModel.setOceanEnabled(enabled); }
+    bool isOceanEnabled() const { return m_waveModel.isOceanEnabled(); }
+    OceanSpectrum* getOcean() { return m_waveModel.getOcean(); }
+
+    /**
+     * @brief 合成当前模拟时刻的 FFT 海面或烘焙高度场（都未打开时什么都不做），每个模拟步在物理更新之前调用
+     */
+    void updateWaves(float time) { m_waveModel.update(time); }
+
+    /**
+     * @brief 波浪模型（CPU 端的水面高度查询，供物理模拟使用）
+     */
+    const WaveModel& getWaveModel() const { return m_waveModel; }
 
 private:
     // 网格数据
     unsigned int m_VAO, m_VBO, m_EBO;
     int m_vertexCount;
     int m_indexCount;
-    bool m_useCustomMesh; // 是否使用自定义网格
     
     // 水面参数
     float m_centerX, m_centerZ;
     float m_width, m_height;
-    float m_baseHeight;  // 水面基准高度
     int m_resolution;
     
-    // Gerstner Waves 参数
-    struct WaveParams {
-        glm::vec2 direction;  // 波浪方向
-        float amplitude;      // 振幅
-        float wavelength;     // 波长
-        float speed;          // 速度
-        float steepness;      // 陡峭度
+    // Gerstner Waves 参数与基准高度
+    WaveModel m_waveModel;
+    
+    static constexpr int MAX_WAVES = WaveUniforms::MAX_WAVES;
+    static constexpr int MAX_WAKE_POINTS = 20;  // 与 water.frag 中 uWakePos 数组长度一致
+    
+    /**
+     * @brief 水面着色器自有 uniform 的句柄（着色器变化时重新解析）
+     */
+    struct WaterUniforms {
+        UniformHandle model;
+        UniformHandle waterColor, lightDir;
+        UniformHandle useBoatCutout, boatPos, boatCutoutInner, boatCutoutOuter, boatCutoutShape;
+        UniformHandle boatForwardXZ, boatHalfExtentsXZ, boatCutoutFeather;
+        UniformHandle wakeCount, boatSpeed, wakePos, wakeAmplitude;
+        UniformHandle oceanDisplacement, oceanSlope, oceanTileSize;
+        UniformHandle clipmapOrigin, clipmapCellSize, clipmapMorph;
+        UniformHandle terrainMask, terrainOrigin, terrainCellSize, terrainSize;
     };
-    std::vector<WaveParams> m_waves;
     
     /**
-     * @brief 生成水面网格
+     * @brief 着色器变体及其 uniform 句柄（按裁剪形状、是否有尾流、是否为 FFT 海面、是否有地形遮罩、是否为 clipmap 组合索引）
      */
-    void generateMesh();
+    enum CutoutVariant { CUTOUT_NONE = 0, CUTOUT_CIRCLE = 1, CUTOUT_OBB = 2, CUTOUT_VARIANT_COUNT = 3 };
+    struct WaterVariant {
+        Shader* shader = nullptr;
+        WaterUniforms uniforms;
+    };
+    Shader* m_variantSource = nullptr;  // 变体所属的基础着色器（变化时清空缓存）
+    static constexpr int VARIANT_COUNT = CUTOUT_VARIANT_COUNT * 2 * 2 * 2 * 2;
+    WaterVariant m_variants[VARIANT_COUNT];
+    glm::vec3 m_wakePositions[MAX_WAKE_POINTS];   // 上传前打包的尾流数据
+    float m_wakeAmplitudes[MAX_WAKE_POINTS];
     
     /**
-     * @brief 计算 Gerstner Wave 在指定点的高度
+     * @brief 取得（必要时编译）对应状态的变体，并解析其 uniform 句柄
      */
-    float calculateGerstnerHeight(float x, float z, float time) const;
+    const WaterVariant& selectVariant(Shader* shader, CutoutVariant cutout, bool wake, bool ocean,
+                                     bool terrainMask, bool clipmap);
+    static void resolveUniforms(const Shader* shader, WaterUniforms& u);
+
+    /**
+     * @brief FFT 海面合成了新的一帧时，用 glTexSubImage2D 覆盖上传位移图和坡度图（首次时创建纹理）
+     */
+    void uploadOceanMaps();
+
+    /**
+     * @brief 上传一个地形区块（CHUNK_SIZE x CHUNK_SIZE 个 texel）
+     */
+    void uploadTerrainMaskChunk(const TerrainMap& terrain, int chunkX, int chunkZ);
+
+    // FFT 海面纹理（GL_REPEAT 平铺，线性过滤，无 mipmap）
+    static constexpr GLuint OCEAN_DISPLACEMENT_UNIT = 0;
+    static constexpr GLuint OCEAN_SLOPE_UNIT = 1;
+    GLuint m_oceanDisplacementTexture = 0;
+    GLuint m_oceanSlopeTexture = 0;
+    int m_oceanTextureResolution = 0;
+    uint64_t m_oceanUploadedCount = 0;  // 已上传的 OceanSpectrum::getUpdateCount()
+
+    // 地形类型图（GL_R8UI，最近邻，按区块补齐到 CHUNK_SIZE 的整数倍）
+    static constexpr GLuint TERRAIN_MASK_UNIT = 2;
+    GLuint m_terrainMaskTexture = 0;
+    int m_terrainMaskWidth = 0;
+    int m_terrainMaskHeight = 0;
+    glm::vec2 m_terrainOrigin = glm::vec2(0.0f);  // 格子 (0, 0) 左下角的世界坐标 (x, z)
+    glm::vec2 m_terrainSize = glm::vec2(0.0f);    // 实际格子数
+    float m_terrainCellSize = 1.0f;
+
+    // clipmap 水面（首次打开时创建）
+    bool m_clipmapEnabled = false;
+    std::unique_ptr<WaterClipmap> m_clipmap;
+    GLuint m_clipmapVAO = 0, m_clipmapVBO = 0, m_clipmapEBO = 0;
+    
+    /**
+     * @brief 生成水面网格
+     */
+    void generateMesh();
     
     // 船只尾流系统
     std::unique_ptr<BoatWake> m_wakeSystem;
@@ -0,0 +1,160 @@
+#include "WaveHeightfield.h"
+#include "WaveModel.h"
+#include "../Core/JobSystem.h"
+#include <glm/gtc/constants.hpp>
+#include <cmath>
+
+namespace WaterTown {
+
+constexpr float WaveHeightfield::TILE_SIZE;
+constexpr int WaveHeightfield::RESOLUTION;
+
+namespace {
+
+const int INVERSE_ITERATIONS = 2;  // 反解水平位移的不动点迭代次数（陡峭度之和 < 1 时收敛很快）
+
+} // namespace
+
+WaveHeightfield::WaveHeightfield()
+    : m_revision(0),
+      m_dispX(TEXEL_COUNT), m_dispZ(TEXEL_COUNT), m_lagSlopeX(TEXEL_COUNT), m_lagSlopeZ(TEXEL_COUNT),
+      m_height(TEXEL_COUNT), m_slopeX(TEXEL_COUNT), m_slopeZ(TEXEL_COUNT),
+      m_time(0.0f), m_baked(false) {
+}
+
+void WaveHeightfield::rebuildPhaseTables(const WaveModel& waves) {
+    const std::vector<WaveParams>& params = waves.getActiveWaves();
+    const int waveCount = static_cast<int>(params.size());
+    m_tables.resize(params.size());
+
+    for (int w = 0; w < waveCount; ++w) {
+        const WaveParams& wave = params[w];
+        WaveTables& table = m_tables[w];
+        const float k = 2.0f * glm::pi<float>() / wave.wavelength;
+        const glm::vec2 d = glm::normalize(wave.direction);
+        const float a = wave.amplitude;
+        // 与 water.vert 相同：q = steepness / (k * a * waveCount)
+        const float qa = wave.steepness / (k * static_cast<float>(waveCount));
+        const float qka = wave.steepness / static_cast<float>(waveCount);
+
+        table.omega = k * wave.speed;
+        table.displaceX = qa * d.x;
+        table.displaceZ = qa * d.y;
+        table.slopeX = k * a * d.x;
+        table.slopeZ = k * a * d.y;
+        table.shearXX = qka * d.x * d.x;
+        table.shearXZ = qka * d.x * d.y;
+        table.shearZZ = qka * d.y * d.y;
+
+        table.sinPhase.resize(TEXEL_COUNT);
+        table.cosPhase.resize(TEXEL_COUNT);
+        const float kx = k * d.x * TEXEL_SIZE;
+        const float kz = k * d.y * TEXEL_SIZE;
+        JobSystem::parallelFor(0, RESOLUTION, BAKE_JOB_GRAIN, [&](int begin, int end) {
+            for (int j = begin; j < end; ++j) {
+                for (int i = 0; i < RESOLUTION; ++i) {
+                    const float phase = kx * i + kz * j;
+                    const size_t index = static_cast<size_t>(j) * RESOLUTION + i;
+                    table.sinPhase[index] = std::sin(phase);
+                    table.cosPhase[index] = std::cos(phase);
+                }
+            }
+        });
+    }
+    m_revision = waves.getRevision();
+}
+
+void WaveHeightfield::bake(const WaveModel& waves, float time) {
+    if (m_revision != waves.getRevision()) {
+        rebuildPhaseTables(waves);
+    }
+
+    // sin(φ - ωt) = sinφ·cos(ωt) - cosφ·sin(ωt)，cos(φ - ωt) = cosφ·cos(ωt) + sinφ·sin(ωt)
+    std::vector<float> sinTime(m_tables.size()), cosTime(m_tables.size());
+    for (size_t w = 0; w < m_tables.size(); ++w) {
+        sinTime[w] = std::sin(m_tables[w].omega * time);
+        cosTime[w] = std::cos(m_tables[w].omega * time);
+    }
+
+    // 第一步：拉格朗日网格上的位移和法线（与 water.vert 逐顶点的计算相同）
+    JobSystem::parallelFor(0, RESOLUTION, BAKE_JOB_GRAIN, [&](int begin, int end) {
+        for (size_t index = static_cast<size_t>(begin) * RESOLUTION; index < static_cast<size_t>(end) * RESOLUTION;
+             ++index) {
+            float dispX = 0.0f, dispZ = 0.0f;
+            // 切线 (1 - tx, -ty, -tz) 与副法线 (-bx, -by, 1 - bz)，副法线的 x 分量与切线的 z 分量相同
+            float tx = 0.0f, ty = 0.0f, txz = 0.0f, by = 0.0f, bz = 0.0f;
+            for (size_t w = 0; w < m_tables.size(); ++w) {
+                const WaveTables& table = m_tables[w];
+                const float s = table.sinPhase[index] * cosTime[w] - table.cosPhase[index] * sinTime[w];
+                const float c = table.cosPhase[index] * cosTime[w] + table.sinPhase[index] * sinTime[w];
+                dispX += table.displaceX * c;
+                dispZ += table.displaceZ * c;
+                tx += table.shearXX * s;
+                txz += table.shearXZ * s;
+                bz += table.shearZZ * s;
+                ty += table.slopeX * c;
+                by += table.slopeZ * c;
+            }
+            // normal = cross(binormal, tangent)，坡度 = -normal.xz / normal.y
+            const glm::vec3 tangent(1.0f - tx, -ty, -txz);
+            const glm::vec3 binormal(-txz, -by, 1.0f - bz);
+            const float normalX = binormal.y * tangent.z - binormal.z * tangent.y;
+            const float normalY = binormal.z * tangent.x - binormal.x * tangent.z;
+            const float normalZ = binormal.x * tangent.y - binormal.y * tangent.x;
+            m_dispX[index] = dispX;
+            m_dispZ[index] = dispZ;
+            m_lagSlopeX[index] = -normalX / normalY;
+            m_lagSlopeZ[index] = -normalZ / normalY;
+        }
+    });
+
+    // 第二步：对每个世界坐标网格点反解原始位置 p0（p0 + D(p0) = p），
+    // 高度在 p0 处按解析公式整行批量求值（少一次插值误差），坡度从拉格朗日网格插值
+    JobSystem::parallelFor(0, RESOLUTION, BAKE_JOB_GRAIN, [&](int begin, int end) {
+        float originX[RESOLUTION];
+        float originZ[RESOLUTION];
+        for (int j = begin; j < end; ++j) {
+            const size_t row = static_cast<size_t>(j) * RESOLUTION;
+            for (int i = 0; i < RESOLUTION; ++i) {
+                const float x = i * TEXEL_SIZE;
+                const float z = j * TEXEL_SIZE;
+                // 第一次迭代从网格点本身出发，位移可以直接读取，不需要插值
+                float x0 = x - m_dispX[row + i];
+                float z0 = z - m_dispZ[row + i];
+                for (int iteration = 1; iteration < INVERSE_ITERATIONS; ++iteration) {
+                    const PeriodicSample b = locate(x0, z0);
+                    x0 = x - b.sample(m_dispX.data());
+                    z0 = z - b.sample(m_dispZ.data());
+                }
+                const PeriodicSample b = locate(x0, z0);
+                m_slopeX[row + i] = b.sample(m_lagSlopeX.data());
+                m_slopeZ[row + i] = b.sample(m_lagSlopeZ.data());
+                originX[i] = x0;
+                originZ[i] = z0;
+            }
+            waves.calculateGerstnerHeights(originX, originZ, &m_height[row], nullptr, nullptr, RESOLUTION, time);
+        }
+    });
+
+    m_time = time;
+    m_baked = true;
+}
+
+float WaveHeightfield::getWaveHeight(float x, float z) const {
+    return locate(x, z).sample(m_height.data());
+}
+
+void WaveHeightfield::getWaveHeights(const float* xs, const float* zs, float* outHeights, float* outGradX,
+                                     float* outGradZ, size_t count) const {
+    const bool gradients = outGradX && outGradZ;
+    for (size_t i = 0; i < count; ++i) {
+        const PeriodicSample b = locate(xs[i], zs[i]);
+        outHeights[i] = b.sample(m_height.data());
+        if (gradients) {
+            outGradX[i] = b.sample(m_slopeX.data());
+            outGradZ[i] = b.sample(m_slopeZ.data());
+        }
+    }
+}
+
+} // namespace WaterTown
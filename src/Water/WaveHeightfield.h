@@ -0,0 +1,97 @@
+#pragma once
+
+#include "PeriodicSample.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace WaterTown {
+
+class WaveModel;
+
+/**
+ * @brief 每个模拟步烘焙一次的可平铺水面高度场（不依赖 OpenGL）
+ *
+ * 按 water.vert 的完整 Gerstner 公式（含水平位移）计算一块 TILE_SIZE 见方的水面，
+ * 之后任意位置的高度和坡度查询都只是一次双线性采样，与浮体数量无关。
+ * 波浪矢量需要先对齐到瓦片的周期（WaveModel::setHeightfieldEnabled 负责），一块瓦片即可覆盖整个水面。
+ *
+ * 烘焙分两步，都按行分给 JobSystem：
+ * 1. 在规则网格上计算每个顶点的水平位移和法线（拉格朗日网格，即 GPU 顶点的原始位置）；
+ * 2. 对规则网格上的每个点反解出哪个原始位置的顶点被推到这里（不动点迭代），
+ *    在该位置按解析公式求高度，得到世界坐标下的高度场。
+ */
+class WaveHeightfield {
+public:
+    static constexpr float TILE_SIZE = 32.0f;  // 瓦片边长（米）
+    static constexpr int RESOLUTION = 512;     // 每边采样数（2 的幂，用掩码回绕）
+
+    WaveHeightfield();
+
+    /**
+     * @brief 烘焙指定时刻的水面
+     * @param waves 波浪模型（波浪矢量需已对齐到瓦片周期）
+     * @param time 模拟时间
+     */
+    void bake(const WaveModel& waves, float time);
+
+    /**
+     * @brief 标记为过期（波浪参数变化后调用，下次烘焙前查询会回退到解析公式）
+     */
+    void invalidate() { m_baked = false; }
+
+    /**
+     * @brief 是否已烘焙了该时刻的水面
+     */
+    bool isBakedAt(float time) const { return m_baked && m_time == time; }
+
+    /**
+     * @brief 查询波浪高度（不含基准高度）
+     */
+    float getWaveHeight(float x, float z) const;
+
+    /**
+     * @brief 批量查询波浪高度和坡度 (dh/dx, dh/dz)，outGradX / outGradZ 可为空
+     */
+    void getWaveHeights(const float* xs, const float* zs, float* outHeights, float* outGradX, float* outGradZ,
+                        size_t count) const;
+
+private:
+    static constexpr float TEXEL_SIZE = TILE_SIZE / RESOLUTION;
+    static constexpr size_t TEXEL_COUNT = static_cast<size_t>(RESOLUTION) * RESOLUTION;
+    static constexpr int BAKE_JOB_GRAIN = 16;  // 每个作业处理的行数
+
+    /**
+     * @brief 世界坐标处的双线性采样位置
+     */
+    static PeriodicSample locate(float x, float z) {
+        return PeriodicSample::locate(x * (1.0f / TEXEL_SIZE), z * (1.0f / TEXEL_SIZE), RESOLUTION);
+    }
+
+    /**
+     * @brief 波浪参数变化后重建每个波的空间相位表 sin/cos(k·p)
+     */
+    void rebuildPhaseTables(const WaveModel& waves);
+
+    // 每个波在每个网格点上的空间相位 sin/cos，逐时刻只需与 sin/cos(ωt) 线性组合
+    struct WaveTables {
+        std::vector<float> sinPhase, cosPhase;
+        float omega;                          // k * c
+        float displaceX, displaceZ;           // q * a * d
+        float slopeX, slopeZ;                 // k * a * d（切线 / 副法线的 y 分量）
+        float shearXX, shearXZ, shearZZ;      // q * k * a * d.x * d.x 等（切线 / 副法线的水平分量）
+    };
+    std::vector<WaveTables> m_tables;
+    uint64_t m_revision;  // 相位表对应的 WaveModel 版本
+
+    // 拉格朗日网格：原始位置为网格点的顶点被推到 p + (dispX, dispZ)，该处水面坡度为 lagSlope
+    std::vector<float> m_dispX, m_dispZ, m_lagSlopeX, m_lagSlopeZ;
+
+    // 世界坐标下的高度场（查询使用）
+    std::vector<float> m_height, m_slopeX, m_slopeZ;
+
+    float m_time;
+    bool m_baked;
+};
+
+} // namespace WaterTown
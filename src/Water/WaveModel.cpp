@@ -0,0 +1,367 @@
+#include "WaveModel.h"
+#include <glm/gtc/constants.hpp>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define WATERTOWN_WAVE_AVX 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WATERTOWN_WAVE_SSE2 1
+#endif
+
+namespace WaterTown {
+
+namespace {
+
+// 区间缩减：x = q * pi + y，y ∈ [-pi/2, pi/2]。pi 拆成高低两部分，相位到几千弧度时 y 仍然精确
+const float INV_PI = 0.318309886f;
+const float PI_HI = 3.140625f;
+const float PI_LO = 9.67653590e-4f;
+
+// sin(y) / cos(y) 在 [-pi/2, pi/2] 上的泰勒多项式（11 次 / 10 次，截断误差 < 1e-6）
+const float SIN_C1 = -1.66666667e-1f;
+const float SIN_C2 = 8.33333333e-3f;
+const float SIN_C3 = -1.98412698e-4f;
+const float SIN_C4 = 2.75573192e-6f;
+const float SIN_C5 = -2.50521084e-8f;
+const float COS_C1 = -0.5f;
+const float COS_C2 = 4.16666667e-2f;
+const float COS_C3 = -1.38888889e-3f;
+const float COS_C4 = 2.48015873e-5f;
+const float COS_C5 = -2.75573192e-7f;
+
+/**
+ * @brief 一组采样点的输入输出指针（各 lane 宽度的实现共用）
+ */
+struct WaveBatch {
+    const float* xs;
+    const float* zs;
+    float* heights;
+    float* gradX;  // 为空时不计算梯度
+    float* gradZ;
+};
+
+#if defined(WATERTOWN_WAVE_AVX)
+
+/**
+ * @brief 8 路 sin/cos（AVX 没有 256 位整数移位，奇偶性用 q/2 是否为整数判断）
+ */
+inline void sinCos8(__m256 x, __m256& outSin, __m256& outCos) {
+    const __m256 q = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(INV_PI)),
+                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 y = _mm256_sub_ps(x, _mm256_mul_ps(q, _mm256_set1_ps(PI_HI)));
+    y = _mm256_sub_ps(y, _mm256_mul_ps(q, _mm256_set1_ps(PI_LO)));
+    const __m256 y2 = _mm256_mul_ps(y, y);
+
+    __m256 s = _mm256_add_ps(_mm256_mul_ps(y2, _mm256_set1_ps(SIN_C5)), _mm256_set1_ps(SIN_C4));
+    s = _mm256_add_ps(_mm256_mul_ps(y2, s), _mm256_set1_ps(SIN_C3));
+    s = _mm256_add_ps(_mm256_mul_ps(y2, s), _mm256_set1_ps(SIN_C2));
+    s = _mm256_add_ps(_mm256_mul_ps(y2, s), _mm256_set1_ps(SIN_C1));
+    s = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(y2, s), y), y);
+
+    __m256 c = _mm256_add_ps(_mm256_mul_ps(y2, _mm256_set1_ps(COS_C5)), _mm256_set1_ps(COS_C4));
+    c = _mm256_add_ps(_mm256_mul_ps(y2, c), _mm256_set1_ps(COS_C3));
+    c = _mm256_add_ps(_mm256_mul_ps(y2, c), _mm256_set1_ps(COS_C2));
+    c = _mm256_add_ps(_mm256_mul_ps(y2, c), _mm256_set1_ps(COS_C1));
+    c = _mm256_add_ps(_mm256_mul_ps(y2, c), _mm256_set1_ps(1.0f));
+
+    // q 为奇数时 sin/cos 取反
+    const __m256 half = _mm256_mul_ps(q, _mm256_set1_ps(0.5f));
+    const __m256 odd = _mm256_cmp_ps(half, _mm256_floor_ps(half), _CMP_NEQ_OQ);
+    const __m256 sign = _mm256_and_ps(odd, _mm256_set1_ps(-0.0f));
+    outSin = _mm256_xor_ps(s, sign);
+    outCos = _mm256_xor_ps(c, sign);
+}
+
+void evaluate8(const std::vector<WaveModel::PackedWave>& waves, float baseHeight, float time,
+               const WaveBatch& batch, size_t i) {
+    const __m256 x = _mm256_loadu_ps(batch.xs + i);
+    const __m256 z = _mm256_loadu_ps(batch.zs + i);
+    __m256 height = _mm256_set1_ps(baseHeight);
+    __m256 gradX = _mm256_setzero_ps();
+    __m256 gradZ = _mm256_setzero_ps();
+    for (const WaveModel::PackedWave& wave : waves) {
+        __m256 phase = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(wave.kx)),
+                                     _mm256_mul_ps(z, _mm256_set1_ps(wave.kz)));
+        phase = _mm256_sub_ps(phase, _mm256_set1_ps(wave.omega * time));
+        __m256 s, c;
+        sinCos8(phase, s, c);
+        height = _mm256_add_ps(height, _mm256_mul_ps(s, _mm256_set1_ps(wave.amplitude)));
+        gradX = _mm256_add_ps(gradX, _mm256_mul_ps(c, _mm256_set1_ps(wave.amplitudeKx)));
+        gradZ = _mm256_add_ps(gradZ, _mm256_mul_ps(c, _mm256_set1_ps(wave.amplitudeKz)));
+    }
+    _mm256_storeu_ps(batch.heights + i, height);
+    if (batch.gradX) {
+        _mm256_storeu_ps(batch.gradX + i, gradX);
+        _mm256_storeu_ps(batch.gradZ + i, gradZ);
+    }
+}
+
+const size_t LANES = 8;
+#define WATERTOWN_WAVE_EVALUATE evaluate8
+
+#elif defined(WATERTOWN_WAVE_SSE2)
+
+/**
+ * @brief 4 路 sin/cos（_mm_cvtps_epi32 按默认舍入模式取最近整数）
+ */
+inline void sinCos4(__m128 x, __m128& outSin, __m128& outCos) {
+    const __m128i qi = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(INV_PI)));
+    const __m128 q = _mm_cvtepi32_ps(qi);
+    __m128 y = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(PI_HI)));
+    y = _mm_sub_ps(y, _mm_mul_ps(q, _mm_set1_ps(PI_LO)));
+    const __m128 y2 = _mm_mul_ps(y, y);
+
+    __m128 s = _mm_add_ps(_mm_mul_ps(y2, _mm_set1_ps(SIN_C5)), _mm_set1_ps(SIN_C4));
+    s = _mm_add_ps(_mm_mul_ps(y2, s), _mm_set1_ps(SIN_C3));
+    s = _mm_add_ps(_mm_mul_ps(y2, s), _mm_set1_ps(SIN_C2));
+    s = _mm_add_ps(_mm_mul_ps(y2, s), _mm_set1_ps(SIN_C1));
+    s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(y2, s), y), y);
+
+    __m128 c = _mm_add_ps(_mm_mul_ps(y2, _mm_set1_ps(COS_C5)), _mm_set1_ps(COS_C4));
+    c = _mm_add_ps(_mm_mul_ps(y2, c), _mm_set1_ps(COS_C3));
+    c = _mm_add_ps(_mm_mul_ps(y2, c), _mm_set1_ps(COS_C2));
+    c = _mm_add_ps(_mm_mul_ps(y2, c), _mm_set1_ps(COS_C1));
+    c = _mm_add_ps(_mm_mul_ps(y2, c), _mm_set1_ps(1.0f));
+
+    // q 为奇数时 sin/cos 取反：最低位移到符号位
+    const __m128 sign = _mm_castsi128_ps(_mm_slli_epi32(qi, 31));
+    outSin = _mm_xor_ps(s, sign);
+    outCos = _mm_xor_ps(c, sign);
+}
+
+void evaluate4(const std::vector<WaveModel::PackedWave>& waves, float baseHeight, float time,
+               const WaveBatch& batch, size_t i) {
+    const __m128 x = _mm_loadu_ps(batch.xs + i);
+    const __m128 z = _mm_loadu_ps(batch.zs + i);
+    __m128 height = _mm_set1_ps(baseHeight);
+    __m128 gradX = _mm_setzero_ps();
+    __m128 gradZ = _mm_setzero_ps();
+    for (const WaveModel::PackedWave& wave : waves) {
+        __m128 phase = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(wave.kx)), _mm_mul_ps(z, _mm_set1_ps(wave.kz)));
+        phase = _mm_sub_ps(phase, _mm_set1_ps(wave.omega * time));
+        __m128 s, c;
+        sinCos4(phase, s, c);
+        height = _mm_add_ps(height, _mm_mul_ps(s, _mm_set1_ps(wave.amplitude)));
+        gradX = _mm_add_ps(gradX, _mm_mul_ps(c, _mm_set1_ps(wave.amplitudeKx)));
+        gradZ = _mm_add_ps(gradZ, _mm_mul_ps(c, _mm_set1_ps(wave.amplitudeKz)));
+    }
+    _mm_storeu_ps(batch.heights + i, height);
+    if (batch.gradX) {
+        _mm_storeu_ps(batch.gradX + i, gradX);
+        _mm_storeu_ps(batch.gradZ + i, gradZ);
+    }
+}
+
+const size_t LANES = 4;
+#define WATERTOWN_WAVE_EVALUATE evaluate4
+
+#else
+
+/**
+ * @brief 标量 sin/cos（与向量版本相同的区间缩减和多项式）
+ */
+inline void sinCos1(float x, float& outSin, float& outCos) {
+    const float q = std::nearbyint(x * INV_PI);
+    const float y = (x - q * PI_HI) - q * PI_LO;
+    const float y2 = y * y;
+    float s = ((((SIN_C5 * y2 + SIN_C4) * y2 + SIN_C3) * y2 + SIN_C2) * y2 + SIN_C1) * y2 * y + y;
+    float c = ((((COS_C5 * y2 + COS_C4) * y2 + COS_C3) * y2 + COS_C2) * y2 + COS_C1) * y2 + 1.0f;
+    if (static_cast<long>(q) & 1) {
+        s = -s;
+        c = -c;
+    }
+    outSin = s;
+    outCos = c;
+}
+
+void evaluate1(const std::vector<WaveModel::PackedWave>& waves, float baseHeight, float time,
+               const WaveBatch& batch, size_t i) {
+    float height = baseHeight;
+    float gradX = 0.0f;
+    float gradZ = 0.0f;
+    for (const WaveModel::PackedWave& wave : waves) {
+        float s, c;
+        sinCos1(wave.kx * batch.xs[i] + wave.kz * batch.zs[i] - wave.omega * time, s, c);
+        height += wave.amplitude * s;
+        gradX += wave.amplitudeKx * c;
+        gradZ += wave.amplitudeKz * c;
+    }
+    batch.heights[i] = height;
+    if (batch.gradX) {
+        batch.gradX[i] = gradX;
+        batch.gradZ[i] = gradZ;
+    }
+}
+
+const size_t LANES = 1;
+#define WATERTOWN_WAVE_EVALUATE evaluate1
+
+#endif
+
+} // namespace
+
+WaveModel::WaveModel() : m_baseHeight(0.0f), m_revision(1) {
+    // 初始化默认波浪参数（4 个不同方向的波浪）
+    m_waves.push_back({glm::vec2(1.0f, 0.0f), 0.15f, 2.0f, 1.0f, 0.3f});
+    m_waves.push_back({glm::vec2(0.7f, 0.7f), 0.1f, 1.5f, 1.2f, 0.2f});
+    m_waves.push_back({glm::vec2(0.0f, 1.0f), 0.08f, 1.0f, 0.8f, 0.25f});
+    m_waves.push_back({glm::vec2(-0.5f, 0.5f), 0.05f, 0.8f, 1.5f, 0.15f});
+    onWavesChanged();
+}
+
+float WaveModel::calculateGerstnerHeight(float x, float z, float time) const {
+    float height = 0.0f;
+
+    // 与 water.vert 相同：方向归一化，相位 k * (d·p - c * t)（系数在 onWavesChanged 中预先算好）
+    for (const auto& wave : m_packedWaves) {
+        float phase = wave.kx * x + wave.kz * z - wave.omega * time;
+
+        // Gerstner Wave 高度公式
+        height += wave.amplitude * std::sin(phase);
+    }
+
+    return height;
+}
+
+void WaveModel::setWaveParameters(int waveCount, float amplitude, float wavelength, float speed) {
+    m_waves.clear();
+
+    // 生成多个不同方向的波浪
+    for (int i = 0; i < waveCount; ++i) {
+        float angle = (2.0f * glm::pi<float>() * i) / waveCount;
+        WaveParams wave;
+        wave.direction = glm::normalize(glm::vec2(std::cos(angle), std::sin(angle)));
+        wave.amplitude = amplitude * (1.0f - i * 0.2f);  // 逐渐减小
+        wave.wavelength = wavelength * (1.0f + i * 0.3f);
+        wave.speed = speed * (1.0f - i * 0.15f);
+        wave.steepness = 0.3f;
+        m_waves.push_back(wave);
+    }
+    onWavesChanged();
+}
+
+void WaveModel::setHeightfieldEnabled(bool enabled) {
+    if (enabled == isHeightfieldEnabled()) {
+        return;
+    }
+    if (enabled) {
+        m_heightfield.reset(new WaveHeightfield());
+    } else {
+        m_heightfield.reset();
+    }
+    onWavesChanged();
+}
+
+void WaveModel::setOceanEnabled(bool enabled) {
+    if (enabled == isOceanEnabled()) {
+        return;
+    }
+    if (enabled) {
+        m_ocean.reset(new OceanSpectrum());
+    } else {
+        m_ocean.reset();
+    }
+}
+
+void WaveModel::update(float time) {
+    if (m_ocean) {
+        m_ocean->update(time);
+    } else if (m_heightfield) {
+        m_heightfield->bake(*this, time);
+    }
+}
+
+void WaveModel::getWaterHeights(const float* xs, const float* zs, float* outHeights, float* outGradX,
+                                float* outGradZ, size_t count, float time) const {
+    if (m_ocean && m_ocean->isUpdatedAt(time)) {
+        m_ocean->getWaveHeights(xs, zs, outHeights, outGradX, outGradZ, count);
+        for (size_t i = 0; i < count; ++i) {
+            outHeights[i] += m_baseHeight;
+        }
+        return;
+    }
+    if (m_heightfield && m_heightfield->isBakedAt(time)) {
+        m_heightfield->getWaveHeights(xs, zs, outHeights, outGradX, outGradZ, count);
+        for (size_t i = 0; i < count; ++i) {
+            outHeights[i] += m_baseHeight;
+        }
+        return;
+    }
+    evaluateBatch(xs, zs, outHeights, outGradX, outGradZ, count, time, m_baseHeight);
+}
+
+void WaveModel::evaluateBatch(const float* xs, const float* zs, float* outHeights, float* outGradX,
+                              float* outGradZ, size_t count, float time, float baseHeight) const {
+    const bool gradients = outGradX && outGradZ;
+    WaveBatch batch{xs, zs, outHeights, gradients ? outGradX : nullptr, gradients ? outGradZ : nullptr};
+
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        WATERTOWN_WAVE_EVALUATE(m_packedWaves, baseHeight, time, batch, i);
+    }
+    if (i == count) {
+        return;
+    }
+
+    // 剩余不足一组的点复制到临时缓冲里补齐，保证所有点走同一条代码路径、结果一致
+    float tailX[LANES] = {};
+    float tailZ[LANES] = {};
+    float tailHeight[LANES];
+    float tailGradX[LANES];
+    float tailGradZ[LANES];
+    const size_t remaining = count - i;
+    for (size_t j = 0; j < remaining; ++j) {
+        tailX[j] = xs[i + j];
+        tailZ[j] = zs[i + j];
+    }
+    WaveBatch tail{tailX, tailZ, tailHeight, batch.gradX ? tailGradX : nullptr, batch.gradX ? tailGradZ : nullptr};
+    WATERTOWN_WAVE_EVALUATE(m_packedWaves, baseHeight, time, tail, 0);
+    for (size_t j = 0; j < remaining; ++j) {
+        outHeights[i + j] = tailHeight[j];
+        if (batch.gradX) {
+            outGradX[i + j] = tailGradX[j];
+            outGradZ[i + j] = tailGradZ[j];
+        }
+    }
+}
+
+void WaveModel::onWavesChanged() {
+    m_activeWaves = m_waves;
+    if (m_heightfield) {
+        // 波矢取最近的瓦片倒格点 2π/L * (nx, nz)，这样水面在 X/Z 上都以 L 为周期
+        const float tile = WaveHeightfield::TILE_SIZE;
+        for (auto& wave : m_activeWaves) {
+            glm::vec2 d = glm::normalize(wave.direction);
+            const float cycles = tile / wave.wavelength;
+            glm::vec2 n(std::floor(d.x * cycles + 0.5f), std::floor(d.y * cycles + 0.5f));
+            if (n.x == 0.0f && n.y == 0.0f) {
+                // 波长超过瓦片：退化为沿主方向、波长等于瓦片边长的波
+                n = std::abs(d.x) >= std::abs(d.y) ? glm::vec2(d.x < 0.0f ? -1.0f : 1.0f, 0.0f)
+                                                   : glm::vec2(0.0f, d.y < 0.0f ? -1.0f : 1.0f);
+            }
+            wave.direction = glm::normalize(n);
+            wave.wavelength = tile / glm::length(n);
+        }
+        m_heightfield->invalidate();
+    }
+
+    m_packedWaves.clear();
+    for (const auto& wave : m_activeWaves) {
+        float k = 2.0f * glm::pi<float>() / wave.wavelength;
+        glm::vec2 d = glm::normalize(wave.direction);
+        PackedWave packed;
+        packed.kx = k * d.x;
+        packed.kz = k * d.y;
+        packed.omega = k * wave.speed;
+        packed.amplitude = wave.amplitude;
+        packed.amplitudeKx = wave.amplitude * packed.kx;
+        packed.amplitudeKz = wave.amplitude * packed.kz;
+        m_packedWaves.push_back(packed);
+    }
+    ++m_revision;
+}
+
+} // namespace WaterTown
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "OceanSpectrum.h"
+#include "WaveHeightfield.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace WaterTown {
+
+/**
+ * @brief Gerstner 波参数
+ */
+struct WaveParams {
+    glm::vec2 direction;  // 波浪方向
+    float amplitude;      // 振幅
+    float wavelength;     // 波长
+    float speed;          // 速度
+    float steepness;      // 陡峭度
+};
+
+/**
+ * @brief 水面波浪模型（不依赖 OpenGL）
+ *
+ * 保存波浪参数和水面基准高度，在 CPU 上计算与 water.vert 一致的水面高度。
+ * WaterSurface 用它填写 WaveBlock，船只浮力直接查询它，因此物理模拟不需要 GL 上下文。
+ *
+ * 默认按解析公式逐点求和（只含竖直分量，忽略 GPU 上的水平位移）。
+ * 打开烘焙高度场后，每个模拟步调用一次 update，同一时刻的查询改为双线性采样，
+ * 结果与 GPU 渲染的水面（含水平位移）一致，且开销与波浪数量无关。
+ * 打开 FFT 海面后由 OceanSpectrum 取代 Gerstner 波：update 合成位移图，查询采样该图，GPU 采样同一张图。
+ */
+class WaveModel {
+public:
+    /**
+     * @brief 构造函数（4 个不同方向的默认波浪）
+     */
+    WaveModel();
+
+    // 禁止拷贝（持有烘焙高度场）
+    WaveModel(const WaveModel&) = delete;
+    WaveModel& operator=(const WaveModel&) = delete;
+
+    /**
+     * @brief 获取指定位置的水面高度（基准高度 + 波浪位移）
+     * @param x 世界坐标 X
+     * @param z 世界坐标 Z
+     * @param time 当前时间（与最近一次 update 时间相同时走 FFT 海面或高度场）
+     */
+    float getWaterHeight(float x, float z, float time) const {
+        if (m_ocean && m_ocean->isUpdatedAt(time)) {
+            return m_baseHeight + m_ocean->getWaveHeight(x, z);
+        }
+        if (m_heightfield && m_heightfield->isBakedAt(time)) {
+            return m_baseHeight + m_heightfield->getWaveHeight(x, z);
+        }
+        return m_baseHeight + calculateGerstnerHeight(x, z, time);
+    }
+
+    /**
+     * @brief 计算 Gerstner Wave 在指定点的高度（不含基准高度）
+     */
+    float calculateGerstnerHeight(float x, float z, float time) const;
+
+    /**
+     * @brief 批量查询水面高度（含基准高度）
+     *
+     * 一次处理 4 个（SSE2）或 8 个（AVX）采样点，sin 用多项式近似（自身误差 < 1e-6）；
+     * 远离原点时误差主要来自单精度相位，与逐点的 getWaterHeight 同一量级。
+     * 没有 SIMD 时退化为同样算法的标量循环。
+     * @param xs 采样点世界坐标 X
+     * @param zs 采样点世界坐标 Z
+     * @param outHeights 输出高度（可以与 xs / zs 相同）
+     * @param count 采样点数量
+     * @param time 当前时间
+     */
+    void getWaterHeights(const float* xs, const float* zs, float* outHeights, size_t count, float time) const {
+        getWaterHeights(xs, zs, outHeights, nullptr, nullptr, count, time);
+    }
+
+    /**
+     * @brief 批量查询水面高度和解析梯度 (dh/dx, dh/dz)
+     *
+     * 梯度与高度共用同一次相位计算，法线为 normalize(-dh/dx, 1, -dh/dz)。
+     * outGradX / outGradZ 为空时只计算高度。已合成该时刻的 FFT 海面或高度场时改为逐点双线性采样。
+     */
+    void getWaterHeights(const float* xs, const float* zs, float* outHeights, float* outGradX, float* outGradZ,
+                         size_t count, float time) const;
+
+    /**
+     * @brief 批量计算 Gerstner Wave 高度和梯度（不含基准高度，始终按解析公式，不走高度场）
+     */
+    void calculateGerstnerHeights(const float* xs, const float* zs, float* outHeights, float* outGradX,
+                                  float* outGradZ, size_t count, float time) const {
+        evaluateBatch(xs, zs, outHeights, outGradX, outGradZ, count, time, 0.0f);
+    }
+
+    /**
+     * @brief 设置波浪参数
+     * @param waveCount 波浪数量（1-4）
+     * @param amplitude 波浪振幅
+     * @param wavelength 波长
+     * @param speed 波速
+     */
+    void setWaveParameters(int waveCount, float amplitude, float wavelength, float speed);
+
+    /**
+     * @brief 打开 / 关闭烘焙高度场
+     *
+     * 打开时把每个波的波矢对齐到 WaveHeightfield::TILE_SIZE 的周期上（波长和方向的变化在几个百分点以内），
+     * 水面因此可以用一块瓦片平铺；GPU 通过 WaveBlock 拿到的是同一组对齐后的参数。
+     * 对齐只作用于 getActiveWaves，用户设置的参数（getWaves）保持不变，关闭后恢复原样。
+     */
+    void setHeightfieldEnabled(bool enabled);
+    bool isHeightfieldEnabled() const { return m_heightfield != nullptr; }
+
+    /**
+     * @brief 打开 / 关闭 FFT 海面（关闭时释放频谱和位移图）
+     */
+    void setOceanEnabled(bool enabled);
+    bool isOceanEnabled() const { return m_ocean != nullptr; }
+
+    /**
+     * @brief FFT 海面（未打开时为空）
+     */
+    OceanSpectrum* getOcean() { return m_ocean.get(); }
+    const OceanSpectrum* getOcean() const { return m_ocean.get(); }
+
+    /**
+     * @brief 每个模拟步调用一次：打开 FFT 海面时合成位移图，否则打开高度场时烘焙高度场，都未打开时什么都不做
+     */
+    void update(float time);
+
+    /**
+     * @brief 波浪参数的版本号，每次修改后递增（缓存派生数据的对象据此判断是否过期）
+     */
+    uint64_t getRevision() const { return m_revision; }
+
+    /**
+     * @brief 批量查询使用的每个波预计算系数
+     *
+     * phase = kx * x + kz * z - omega * time
+     * h += amplitude * sin(phase)，dh/dx += amplitudeKx * cos(phase)，dh/dz += amplitudeKz * cos(phase)
+     */
+    struct PackedWave {
+        float kx, kz;
+        float omega;
+        float amplitude;
+        float amplitudeKx, amplitudeKz;
+    };
+
+    /**
+     * @brief 用户设置的波浪参数
+     */
+    const std::vector<WaveParams>& getWaves() const { return m_waves; }
+
+    /**
+     * @brief 实际参与计算和渲染的波浪参数（打开高度场时是对齐到瓦片周期后的版本）
+     */
+    const std::vector<WaveParams>& getActiveWaves() const { return m_activeWaves; }
+
+    float getBaseHeight() const { return m_baseHeight; }
+    void setBaseHeight(float height) { m_baseHeight = height; }
+
+private:
+    /**
+     * @brief 波浪参数变化后调用：由 m_waves 重建 m_activeWaves（需要时对齐到瓦片周期）
+     *        和 m_packedWaves，并使高度场过期
+     */
+    void onWavesChanged();
+
+    /**
+     * @brief 解析公式的批量求值（SIMD），结果加上 baseHeight
+     */
+    void evaluateBatch(const float* xs, const float* zs, float* outHeights, float* outGradX, float* outGradZ,
+                       size_t count, float time, float baseHeight) const;
+
+    std::vector<WaveParams> m_waves;        // 用户设置的参数
+    std::vector<WaveParams> m_activeWaves;  // 实际使用的参数
+    std::vector<PackedWave> m_packedWaves;
+    float m_baseHeight;  // 水面基准高度
+    uint64_t m_revision;
+    std::unique_ptr<WaveHeightfield> m_heightfield;  // 为空表示未打开烘焙
+    std::unique_ptr<OceanSpectrum> m_ocean;          // 为空表示未打开 FFT 海面
+};
+
+} // namespace WaterTown